@@ -0,0 +1,101 @@
+// 커넥션 풀 경합 마이크로벤치마크
+// 단일 mutex+condition_variable 풀(기존 구현)과 스레드 샤딩 ConnectionPool의
+// acquire/release 처리량을 스레드 수별로 비교한다. 쿼리는 실행하지 않는다.
+//
+// 사용법: connection-pool-bench [max_threads] [iterations_per_thread]
+// 접속 정보: BENCH_DB_CONN (기본값은 로컬 docker-compose 설정)
+#include "server/connection_pool.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 기존 ConnectionPool과 같은 구조: 모든 acquire/release가 하나의 mutex를 거친다
+class MutexPool {
+public:
+    MutexPool(const std::string& conn_str, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            idle_.push_back(std::make_unique<pqxx::connection>(conn_str));
+        }
+    }
+
+    using ConnPtr = std::unique_ptr<pqxx::connection, std::function<void(pqxx::connection*)>>;
+    ConnPtr acquire() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this]() { return !idle_.empty(); });
+        auto conn = std::move(idle_.back());
+        idle_.pop_back();
+        return ConnPtr(conn.release(), [this](pqxx::connection* c) { release(c); });
+    }
+
+private:
+    void release(pqxx::connection* conn) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        idle_.emplace_back(conn);
+        lock.unlock();
+        cv_.notify_one();
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::unique_ptr<pqxx::connection>> idle_;
+};
+
+template <typename Pool>
+double run(Pool& pool, std::size_t threads, std::size_t iterations) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, iterations]() {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                auto conn = pool.acquire();
+                (void)conn;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads * iterations) / sec;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    std::size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    if (max_threads == 0) max_threads = 4;
+
+    const char* env = std::getenv("BENCH_DB_CONN");
+    std::string conn_str = env ? env : "host=localhost port=5432 user=pickaxe password=pickaxe dbname=pickaxe_auth";
+
+    spdlog::set_level(spdlog::level::warn);
+    try {
+        // 풀 크기는 스레드 수와 같게 잡아 대기가 아닌 락 경합만 측정한다
+        MutexPool mutex_pool(conn_str, max_threads);
+        ConnectionPool sharded_pool(conn_str, max_threads, max_threads);
+
+        std::cout << "threads\tmutex_ops/s\tsharded_ops/s\tspeedup\n";
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            double a = run(mutex_pool, threads, iterations);
+            double b = run(sharded_pool, threads, iterations);
+            std::cout << threads << '\t' << static_cast<uint64_t>(a) << '\t' << static_cast<uint64_t>(b)
+                      << '\t' << (b / a) << "x\n";
+        }
+
+        auto s = sharded_pool.stats();
+        std::cout << "sharded: acquires=" << s.acquires << " local_hits=" << s.local_hits
+                  << " steals=" << s.steals << " timeouts=" << s.acquire_timeouts << '\n';
+    } catch (const std::exception& ex) {
+        std::cerr << "bench failed: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
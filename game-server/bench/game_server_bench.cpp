@@ -0,0 +1,264 @@
+// 틱/직렬화/메타데이터 핫패스 마이크로벤치마크 (Google Benchmark)
+// 유저당 초당 25회 도는 채굴 틱 경로와 요청 처리 공통 경로를 측정한다.
+// - MiningTick: 슬롯 1~4개, 공격 속도별 advance_slot_attacks + MINING_UPDATE 구성/직렬화
+// - Envelope 직렬화(send_envelope)와 파싱(read_payload)
+// - estimate_offline_reward (12시간 오프라인 보상 닫힌 식)
+// - compute_expected_dps, 가챠 추첨(GemGachaSampler), MetadataLoader 조회
+//
+// 사용법: game-server-bench [--benchmark_filter=...] [--benchmark_out=bench.json --benchmark_out_format=json]
+// CI 비교: cmake --build . --target bench-json 후 benchmark의 tools/compare.py로 이전 JSON과 diff
+// 메타데이터 경로: BENCH_METADATA_DIR (기본값 ../metadata), 로드 실패 시 메타데이터 벤치만 건너뛴다
+#include "metadata/metadata_loader.h"
+#include "server/mining_tick.h"
+#include "server/offline_reward.h"
+#include "server/pickaxe_stats.h"
+#include "server/rng_service.h"
+#include "game.pb.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace pb = infinitepickaxe;
+
+constexpr float kTickMs = 40.0f;
+constexpr uint64_t kServerTimeMs = 1'760'000'000'000ULL;
+
+MiningState make_mining_state(int slot_count, uint32_t attack_speed_x100) {
+    MiningState state;
+    state.is_mining = true;
+    state.current_mineral_id = 3;
+    state.max_hp = 50'000'000;
+    state.current_hp = state.max_hp;
+    Xoshiro256ss rng(42);
+    for (int i = 0; i < slot_count; ++i) {
+        SlotMiningState slot{};
+        slot.slot_index = static_cast<uint32_t>(i);
+        slot.attack_power = 1200 + 300 * static_cast<uint64_t>(i);
+        slot.attack_speed = static_cast<float>(attack_speed_x100) / 100.0f;
+        slot.critical_hit_percent = 1500;
+        slot.critical_damage = 20000;
+        const float interval = 1000.0f / slot.attack_speed;
+        slot.next_attack_timer_ms = static_cast<float>(rng() % 1000) / 1000.0f * interval;
+        state.slots.push_back(slot);
+    }
+    return state;
+}
+
+// Session::update_mining_tick의 공격 계산 + 전송 메시지 구성 (소켓 쓰기 제외)
+void BM_MiningTick(benchmark::State& bench) {
+    const int slots = static_cast<int>(bench.range(0));
+    const auto speed_x100 = static_cast<uint32_t>(bench.range(1));
+    MiningState state = make_mining_state(slots, speed_x100);
+    Xoshiro256ss rng(7);
+    std::string body;
+    uint64_t attacks = 0;
+    for (auto _ : bench) {
+        pb::Envelope env;
+        env.set_type(pb::MINING_UPDATE);
+        auto* update = env.mutable_mining_update();
+        const uint64_t damage = advance_slot_attacks(state.slots, kTickMs, rng, *update);
+        state.current_hp = state.current_hp > damage ? state.current_hp - damage : state.max_hp;
+        fill_mining_update(state, kServerTimeMs, *update);
+        attacks += static_cast<uint64_t>(update->attacks_size());
+        env.SerializeToString(&body);
+        benchmark::DoNotOptimize(body.data());
+    }
+    bench.counters["attacks_per_tick"] =
+        benchmark::Counter(static_cast<double>(attacks), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MiningTick)
+    ->ArgNames({"slots", "aps_x100"})
+    ->ArgsProduct({{1, 2, 3, 4}, {100, 250, 1000, 4000}});
+
+// send_mining_update 직렬화만 (공격 수 고정)
+void BM_MiningUpdateSerialize(benchmark::State& bench) {
+    const int attack_count = static_cast<int>(bench.range(0));
+    MiningState state = make_mining_state(4, 100);
+    pb::Envelope env;
+    env.set_type(pb::MINING_UPDATE);
+    auto* update = env.mutable_mining_update();
+    fill_mining_update(state, kServerTimeMs, *update);
+    for (int i = 0; i < attack_count; ++i) {
+        auto* attack = update->add_attacks();
+        attack->set_slot_index(static_cast<uint32_t>(i % 4));
+        attack->set_damage(1500 + static_cast<uint64_t>(i));
+        attack->set_is_critical(i % 5 == 0);
+    }
+    std::string body;
+    for (auto _ : bench) {
+        env.SerializeToString(&body);
+        benchmark::DoNotOptimize(body.data());
+    }
+    bench.SetBytesProcessed(static_cast<int64_t>(bench.iterations()) * static_cast<int64_t>(body.size()));
+}
+BENCHMARK(BM_MiningUpdateSerialize)->ArgName("attacks")->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+std::string encoded_request(pb::MessageType type) {
+    pb::Envelope env;
+    env.set_type(type);
+    switch (type) {
+    case pb::HANDSHAKE: {
+        auto* req = env.mutable_handshake();
+        req->set_jwt(std::string(180, 'j'));
+        req->set_client_version("1.0.0");
+        req->set_device_id("device-0123456789abcdef");
+        break;
+    }
+    case pb::HEARTBEAT: env.mutable_heartbeat()->set_client_time_ms(kServerTimeMs); break;
+    case pb::CHANGE_MINERAL_REQUEST: env.mutable_change_mineral_request()->set_mineral_id(4); break;
+    case pb::UPGRADE_REQUEST: env.mutable_upgrade_request()->set_slot_index(1); break;
+    case pb::GEM_GACHA_REQUEST: env.mutable_gem_gacha_request()->set_pull_count(11); break;
+    default: break;
+    }
+    return env.SerializeAsString();
+}
+
+// read_payload의 Envelope 파싱 (요청 타입별)
+void BM_EnvelopeParse(benchmark::State& bench) {
+    const auto type = static_cast<pb::MessageType>(bench.range(0));
+    const std::string payload = encoded_request(type);
+    for (auto _ : bench) {
+        pb::Envelope env;
+        const bool ok = env.ParseFromArray(payload.data(), static_cast<int>(payload.size()));
+        benchmark::DoNotOptimize(ok);
+    }
+    bench.SetLabel(pb::MessageType_Name(type));
+    bench.SetBytesProcessed(static_cast<int64_t>(bench.iterations()) * static_cast<int64_t>(payload.size()));
+}
+BENCHMARK(BM_EnvelopeParse)
+    ->ArgName("type")
+    ->Arg(pb::HANDSHAKE)
+    ->Arg(pb::HEARTBEAT)
+    ->Arg(pb::CHANGE_MINERAL_REQUEST)
+    ->Arg(pb::UPGRADE_REQUEST)
+    ->Arg(pb::GEM_GACHA_REQUEST);
+
+void BM_ComputeExpectedDps(benchmark::State& bench) {
+    Xoshiro256ss rng(11);
+    std::vector<uint32_t> speeds(256);
+    for (auto& s : speeds) s = 50 + static_cast<uint32_t>(rng() % 4000);
+    std::size_t i = 0;
+    for (auto _ : bench) {
+        const uint64_t dps = compute_expected_dps(1'000'000 + i, speeds[i & 255], 1500, 25000, 10);
+        benchmark::DoNotOptimize(dps);
+        ++i;
+    }
+}
+BENCHMARK(BM_ComputeExpectedDps);
+
+// OfflineService::handle_request의 보상 계산 (12시간 = 틱 108만 회를 닫힌 식으로)
+void BM_OfflineReward(benchmark::State& bench) {
+    const int slots = static_cast<int>(bench.range(0));
+    MiningState state = make_mining_state(slots, 250);
+    MineralMeta mineral{};
+    mineral.id = 3;
+    mineral.hp = static_cast<uint64_t>(bench.range(1));
+    mineral.reward = 5;
+    mineral.respawn_time = 5;
+    for (auto _ : bench) {
+        const auto estimate = estimate_offline_reward(state.slots, mineral, 12 * 3600);
+        benchmark::DoNotOptimize(estimate.gold);
+    }
+}
+BENCHMARK(BM_OfflineReward)
+    ->ArgNames({"slots", "hp"})
+    ->ArgsProduct({{1, 4}, {5'000, 60'000, 50'000'000}});
+
+// 메타데이터는 한 번만 로드해 모든 벤치가 공유
+const MetadataLoader* metadata() {
+    static std::unique_ptr<MetadataLoader> loaded = [] {
+        const char* dir = std::getenv("BENCH_METADATA_DIR");
+        auto meta = std::make_unique<MetadataLoader>();
+        if (!meta->load(dir ? dir : "../metadata")) meta.reset();
+        return meta;
+    }();
+    return loaded.get();
+}
+
+// 가챠 추첨 (GemService::handle_gacha_pull의 gem_id 선택 부분)
+void BM_GachaSample(benchmark::State& bench) {
+    const auto* meta = metadata();
+    if (!meta || meta->gem_gacha_sampler().empty()) {
+        bench.SkipWithError("metadata not loaded (set BENCH_METADATA_DIR)");
+        return;
+    }
+    const auto pulls = static_cast<uint32_t>(bench.range(0));
+    const auto& sampler = meta->gem_gacha_sampler();
+    auto rng = RngService::stream("bench-user", RngDomain::Gacha);
+    std::vector<uint32_t> selected;
+    selected.reserve(pulls);
+    for (auto _ : bench) {
+        selected.clear();
+        for (uint32_t i = 0; i < pulls; ++i) selected.push_back(sampler.sample_gem(rng));
+        benchmark::DoNotOptimize(selected.data());
+    }
+    bench.SetItemsProcessed(static_cast<int64_t>(bench.iterations()) * pulls);
+}
+BENCHMARK(BM_GachaSample)->ArgName("pulls")->Arg(1)->Arg(11);
+
+void BM_MetadataMineral(benchmark::State& bench) {
+    const auto* meta = metadata();
+    if (!meta) {
+        bench.SkipWithError("metadata not loaded (set BENCH_METADATA_DIR)");
+        return;
+    }
+    uint32_t id = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(meta->mineral(1 + (id++ & 7)));
+    }
+}
+BENCHMARK(BM_MetadataMineral);
+
+void BM_MetadataPickaxeLevel(benchmark::State& bench) {
+    const auto* meta = metadata();
+    if (!meta) {
+        bench.SkipWithError("metadata not loaded (set BENCH_METADATA_DIR)");
+        return;
+    }
+    uint32_t level = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(meta->pickaxe_level(level++ & 63));
+    }
+}
+BENCHMARK(BM_MetadataPickaxeLevel);
+
+void BM_MetadataGemDefinitionFor(benchmark::State& bench) {
+    const auto* meta = metadata();
+    if (!meta || meta->gem_grades().empty() || meta->gem_types().empty()) {
+        bench.SkipWithError("metadata not loaded (set BENCH_METADATA_DIR)");
+        return;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> keys;
+    for (const auto& grade : meta->gem_grades()) {
+        for (const auto& type : meta->gem_types()) keys.emplace_back(grade.id, type.id);
+    }
+    std::size_t i = 0;
+    for (auto _ : bench) {
+        const auto& key = keys[i++ % keys.size()];
+        benchmark::DoNotOptimize(meta->gem_definition_for(key.first, key.second));
+    }
+}
+BENCHMARK(BM_MetadataGemDefinitionFor);
+
+void BM_MetadataAdMeta(benchmark::State& bench) {
+    const auto* meta = metadata();
+    if (!meta || meta->ad_types().empty()) {
+        bench.SkipWithError("metadata not loaded (set BENCH_METADATA_DIR)");
+        return;
+    }
+    std::vector<std::string> ids;
+    for (const auto& ad : meta->ad_types()) ids.push_back(ad.id);
+    std::size_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(meta->ad_meta(ids[i++ % ids.size()]));
+    }
+}
+BENCHMARK(BM_MetadataAdMeta);
+
+} // namespace
+
+BENCHMARK_MAIN();
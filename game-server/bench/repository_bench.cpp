@@ -0,0 +1,546 @@
+// 리포지토리 쿼리 벤치마크 (임시 로컬 Postgres)
+// initdb로 일회용 클러스터를 띄워 database/game_schema/schema.sql을 적용하고
+// 가상 유저 N명을 GameRepository::ensure_user_initialized로 시드한 뒤,
+// 리포지토리 메서드별로 동시 부하를 걸어 지연(p50/p99/p999/max)과 처리량을 잰다.
+// FOR UPDATE 경로의 잠금 대기는 pg_stat_activity(wait_event_type = 'Lock')를 주기적으로 샘플링해
+// 대기 중인 백엔드 수 평균과 추정 대기 시간(샘플 수 * 샘플 간격)으로 보고한다.
+//
+// 사용법:
+//   repository-bench [--users=1000] [--threads=8] [--duration=10] [--ops=all|name,name,...]
+//                    [--hot-users=0] [--pg-bin=<initdb/pg_ctl 경로>] [--pg-port=55432]
+//                    [--pg-opts="-c fsync=off"] [--keep=0] [--conn=<기존 DB 접속 문자열>]
+//                    [--schema=../database/game_schema/schema.sql] [--metadata=../metadata]
+// --conn을 주면 임시 클러스터 대신 해당 DB를 쓴다 (스키마를 다시 만들므로 전용 DB만 지정할 것)
+// --hot-users=K: 모든 스레드가 앞쪽 K명만 사용 (행 잠금 경합 재현)
+#include "metadata/metadata_store.h"
+#include "server/ad_repository.h"
+#include "server/connection_pool.h"
+#include "server/game_repository.h"
+#include "server/gem_repository.h"
+#include "server/hdr_histogram.h"
+#include "server/mining_repository.h"
+#include "server/mission_repository.h"
+#include "server/offline_repository.h"
+#include "server/rng_service.h"
+#include "server/slot_repository.h"
+#include "server/upgrade_repository.h"
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    uint32_t users = 1000;
+    uint32_t threads = 8;
+    uint32_t duration_sec = 10;   // 연산별 측정 시간
+    std::string ops = "all";
+    uint32_t hot_users = 0;
+    std::string pg_bin;           // 비어 있으면 PATH
+    unsigned short pg_port = 55432;
+    std::string pg_opts;
+    bool keep = false;
+    std::string conn;
+    std::string schema = "../database/game_schema/schema.sql";
+    std::string metadata = "../metadata";
+};
+
+// ---- 일회용 Postgres 클러스터 ----
+
+class EphemeralPostgres {
+public:
+    EphemeralPostgres(const Options& opt) : opt_(opt) {}
+    ~EphemeralPostgres() { stop(); }
+
+    void start() {
+        char tmpl[] = "/tmp/repository-bench-XXXXXX";
+        if (!mkdtemp(tmpl)) throw std::runtime_error("mkdtemp failed");
+        dir_ = tmpl;
+        const std::string data = dir_ + "/data";
+        const std::string log = dir_ + "/postgres.log";
+
+        run(tool("initdb") + " -D " + quote(data) + " -U bench --auth=trust -E UTF8 > " + quote(dir_ + "/initdb.log") + " 2>&1",
+            "initdb");
+        // 유닉스 소켓만 사용 (TCP 포트 충돌 방지), 잠금 대기 로그도 남긴다
+        std::string server_opts = "-p " + std::to_string(opt_.pg_port) + " -k " + dir_ +
+                                  " -c listen_addresses='' -c log_lock_waits=on -c max_connections=" +
+                                  std::to_string(std::max<uint32_t>(100, opt_.threads * 2 + 20));
+        if (!opt_.pg_opts.empty()) server_opts += " " + opt_.pg_opts;
+        run(tool("pg_ctl") + " -D " + quote(data) + " -l " + quote(log) + " -w -o " + quote(server_opts) + " start > /dev/null",
+            "pg_ctl start");
+        started_ = true;
+
+        const std::string admin = base_conn() + " dbname=postgres";
+        pqxx::connection conn(admin);
+        pqxx::nontransaction tx(conn);
+        tx.exec("CREATE DATABASE pickaxe_bench");
+        std::printf("ephemeral postgres: %s (port %u)\n", dir_.c_str(), opt_.pg_port);
+    }
+
+    std::string conn_str() const { return base_conn() + " dbname=pickaxe_bench"; }
+
+    void stop() {
+        if (!started_) return;
+        started_ = false;
+        std::system((tool("pg_ctl") + " -D " + quote(dir_ + "/data") + " -m fast -w stop > /dev/null 2>&1").c_str());
+        if (opt_.keep) {
+            std::printf("kept cluster at %s\n", dir_.c_str());
+        } else {
+            std::error_code ec;
+            std::filesystem::remove_all(dir_, ec);
+        }
+    }
+
+private:
+    std::string base_conn() const {
+        return "host=" + dir_ + " port=" + std::to_string(opt_.pg_port) + " user=bench";
+    }
+    std::string tool(const char* name) const {
+        return opt_.pg_bin.empty() ? std::string(name) : quote(opt_.pg_bin + "/" + name);
+    }
+    static std::string quote(const std::string& s) {
+        std::string out = "'";
+        for (char c : s) {
+            if (c == '\'') out += "'\\''";
+            else out += c;
+        }
+        return out + "'";
+    }
+    void run(const std::string& cmd, const char* what) const {
+        if (std::system(cmd.c_str()) != 0) {
+            throw std::runtime_error(std::string(what) + " failed (logs in " + dir_ + ")");
+        }
+    }
+
+    const Options& opt_;
+    std::string dir_;
+    bool started_{false};
+};
+
+void apply_schema(const std::string& conn_str, const std::string& schema_path) {
+    std::ifstream in(schema_path);
+    if (!in) throw std::runtime_error("cannot open schema " + schema_path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    pqxx::connection conn(conn_str);
+    pqxx::nontransaction tx(conn);
+    tx.exec(ss.str());
+}
+
+// ---- 리포지토리 묶음 ----
+
+struct Repos {
+    ConnectionPool& pool;
+    const MetadataStore& meta;
+    GameRepository game;
+    SlotRepository slot;
+    UpgradeRepository upgrade;
+    GemRepository gem;
+    MissionRepository mission;
+    MiningRepository mining;
+    OfflineRepository offline;
+    AdRepository ad;
+
+    Repos(ConnectionPool& p, const MetadataStore& m)
+        : pool(p), meta(m), game(p, m), slot(p), upgrade(p), gem(p), mission(p), mining(p), offline(p), ad(p) {}
+};
+
+std::string user_uuid(uint32_t index) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "00000000-0000-4000-8000-%012x", index);
+    return buf;
+}
+
+// 유저 초기화 + 벤치가 실패 경로로 빠지지 않도록 재화/용량/미션을 넉넉히 채운다
+void seed_users(Repos& repos, const std::string& conn_str, const Options& opt) {
+    const auto start = Clock::now();
+    std::atomic<uint32_t> next{0};
+    std::atomic<uint32_t> failed{0};
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < opt.threads; ++t) {
+        workers.emplace_back([&] {
+            for (uint32_t i = next++; i < opt.users; i = next++) {
+                const std::string uid = user_uuid(i);
+                if (!repos.game.ensure_user_initialized(uid)) {
+                    ++failed;
+                    continue;
+                }
+                for (uint32_t slot_no = 1; slot_no <= 3; ++slot_no) {
+                    repos.mission.assign_mission_to_slot(uid, slot_no, slot_no, "mine_count", 1'000'000, 10);
+                }
+                repos.offline.get_or_create_state(uid, 0);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    pqxx::connection conn(conn_str);
+    pqxx::work tx(conn);
+    tx.exec("UPDATE game_schema.user_game_data SET gold = 1000000000000000, crystal = 2000000000");
+    tx.exec("UPDATE game_schema.user_gem_inventory SET current_capacity = 128");
+    tx.exec("ANALYZE");
+    tx.commit();
+    std::printf("seeded %u users in %.1fs (%u failed)\n", opt.users,
+                std::chrono::duration<double>(Clock::now() - start).count(), failed.load());
+}
+
+// ---- 연산 정의 ----
+
+// 스레드별 작업 상태 (준비 단계에서 계산한 인자 보관)
+struct Worker {
+    Xoshiro256ss rng;
+    MetadataStore::Snapshot meta;
+    uint32_t upgrade_level{0};
+    std::vector<uint32_t> gem_ids;
+    std::unique_ptr<pqxx::connection> admin; // 측정 외 정리 작업용
+};
+
+// prepare/cleanup은 측정에서 제외, run의 반환값 false는 비즈니스 거절(잔액 부족 등)
+struct Op {
+    const char* name;
+    std::function<void(Repos&, Worker&, const std::string&)> prepare;
+    std::function<bool(Repos&, Worker&, const std::string&)> run;
+    std::function<void(Repos&, Worker&, const std::string&)> cleanup;
+};
+
+std::vector<Op> build_ops() {
+    std::vector<Op> ops;
+    ops.push_back({"slot.get_user_slots", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return !r.slot.get_user_slots(u).empty(); }, nullptr});
+    ops.push_back({"slot.get_slot", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return r.slot.get_slot(u, 0).has_value(); }, nullptr});
+    ops.push_back({"game.get_user_game_data", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) {
+                       r.game.get_user_game_data(u);
+                       return true;
+                   }, nullptr});
+    ops.push_back({"game.add_crystal", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return r.game.add_crystal(u, 1).has_value(); }, nullptr});
+
+    // 슬롯 0 강화 시도 (FOR UPDATE: pickaxe_slots, user_game_data)
+    ops.push_back({"upgrade.try_upgrade_with_probability",
+                   [](Repos& r, Worker& w, const std::string& u) {
+                       auto slot = r.slot.get_slot(u, 0);
+                       uint32_t level = slot ? slot->level : 0;
+                       if (!w.meta->pickaxe_level(level + 1)) {
+                           pqxx::work tx(*w.admin);
+                           tx.exec_params("UPDATE game_schema.pickaxe_slots SET level = 0, tier = 1, pity_bonus = 0 "
+                                          "WHERE user_id = $1 AND slot_index = 0", u);
+                           tx.commit();
+                           level = 0;
+                       }
+                       w.upgrade_level = level + 1;
+                   },
+                   [](Repos& r, Worker& w, const std::string& u) {
+                       const auto* next = w.meta->pickaxe_level(w.upgrade_level);
+                       if (!next) return false;
+                       const auto speed_x100 = static_cast<uint32_t>(next->attack_speed * 100.0);
+                       auto res = r.upgrade.try_upgrade_with_probability(
+                           u, 0, next->level, next->tier, next->attack_power, speed_x100,
+                           next->dps, next->cost, w.meta->upgrade_rules());
+                       return !res.invalid_target && !res.invalid_slot && !res.insufficient_gold;
+                   },
+                   nullptr});
+
+    // 11연 가챠 (크리스탈 차감 + 보석 11개 생성), 인벤토리가 차면 측정 밖에서 비운다
+    ops.push_back({"gem.gacha_pull",
+                   [](Repos&, Worker& w, const std::string& u) {
+                       const auto& sampler = w.meta->gem_gacha_sampler();
+                       const uint32_t count = w.meta->gem_gacha().multi_pull_count;
+                       w.gem_ids.clear();
+                       auto rng = RngService::stream(u, RngDomain::Gacha);
+                       for (uint32_t i = 0; i < count && !sampler.empty(); ++i) w.gem_ids.push_back(sampler.sample_gem(rng));
+                   },
+                   [](Repos& r, Worker& w, const std::string& u) {
+                       return r.gem.gacha_pull(u, w.meta->gem_gacha().multi_pull_cost, w.gem_ids).success;
+                   },
+                   [](Repos&, Worker& w, const std::string& u) {
+                       pqxx::work tx(*w.admin);
+                       auto row = tx.exec_params1("SELECT count(*) FROM game_schema.user_gems WHERE user_id = $1", u);
+                       if (row[0].as<int64_t>() + 11 > 128) {
+                           tx.exec_params("DELETE FROM game_schema.user_gems WHERE user_id = $1", u);
+                       }
+                       tx.commit();
+                   }});
+    ops.push_back({"gem.get_user_gems", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) {
+                       r.gem.get_user_gems(u);
+                       return true;
+                   }, nullptr});
+
+    ops.push_back({"mission.get_all_mission_slots", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return !r.mission.get_all_mission_slots(u).empty(); },
+                   nullptr});
+    ops.push_back({"mission.update_mission_progress", nullptr,
+                   [](Repos& r, Worker& w, const std::string& u) {
+                       const uint32_t slot_no = 1 + static_cast<uint32_t>(w.rng() % 3);
+                       const uint32_t value = static_cast<uint32_t>(w.rng() % 999'999);
+                       return r.mission.update_mission_progress(u, slot_no, value, "active");
+                   }, nullptr});
+    ops.push_back({"mission.increment_completed_count", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return r.mission.increment_completed_count(u, 1); },
+                   nullptr});
+    ops.push_back({"mining.record_completion", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) {
+                       return r.mining.record_completion(u, 1, 10).mining_count > 0;
+                   }, nullptr});
+    ops.push_back({"offline.add_offline_seconds", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) {
+                       return r.offline.add_offline_seconds(u, 1, 0).has_value();
+                   }, nullptr});
+    ops.push_back({"ad.increment_ad_counter", nullptr,
+                   [](Repos& r, Worker&, const std::string& u) { return r.ad.increment_ad_counter(u, "crystal_reward"); },
+                   nullptr});
+    return ops;
+}
+
+// ---- 잠금 대기 샘플러 ----
+
+class LockSampler {
+public:
+    static constexpr auto kInterval = std::chrono::milliseconds(5);
+
+    explicit LockSampler(const std::string& conn_str) : conn_(conn_str) {}
+
+    void start() {
+        samples_ = 0;
+        waiting_sum_ = 0;
+        max_waiting_ = 0;
+        running_ = true;
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    uint64_t samples() const { return samples_; }
+    double avg_waiting() const { return samples_ ? static_cast<double>(waiting_sum_) / samples_ : 0.0; }
+    uint64_t max_waiting() const { return max_waiting_; }
+    // 대기 백엔드 수 * 샘플 간격의 합 (전체 스레드 합산 잠금 대기 시간 추정치)
+    double est_wait_ms() const { return static_cast<double>(waiting_sum_) * kInterval.count(); }
+
+    uint64_t deadlocks() {
+        pqxx::nontransaction tx(conn_);
+        return tx.exec1("SELECT deadlocks FROM pg_stat_database WHERE datname = current_database()")[0].as<int64_t>();
+    }
+
+private:
+    void loop() {
+        while (running_) {
+            const auto next = Clock::now() + kInterval;
+            try {
+                pqxx::nontransaction tx(conn_);
+                auto row = tx.exec1(
+                    "SELECT count(*) FROM pg_stat_activity "
+                    "WHERE datname = current_database() AND wait_event_type = 'Lock'");
+                const uint64_t waiting = row[0].as<int64_t>();
+                ++samples_;
+                waiting_sum_ += waiting;
+                max_waiting_ = std::max(max_waiting_, waiting);
+            } catch (const std::exception& ex) {
+                spdlog::warn("lock sampler: {}", ex.what());
+            }
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    pqxx::connection conn_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    uint64_t samples_{0};
+    uint64_t waiting_sum_{0};
+    uint64_t max_waiting_{0};
+};
+
+// ---- 실행 ----
+
+struct OpResult {
+    std::string name;
+    uint64_t ok{0};
+    uint64_t rejected{0};
+    uint64_t errors{0};
+    double elapsed_sec{0};
+    uint64_t p50{0}, p99{0}, p999{0}, max{0};
+    double lock_avg{0};
+    uint64_t lock_max{0};
+    double lock_wait_ms{0};
+    uint64_t deadlocks{0};
+};
+
+OpResult run_op(const Op& op, Repos& repos, const std::string& conn_str, const Options& opt, LockSampler& sampler) {
+    HdrHistogram latency;
+    std::atomic<uint64_t> ok{0}, rejected{0}, errors{0};
+    const uint32_t user_space = opt.hot_users > 0 ? std::min(opt.hot_users, opt.users) : opt.users;
+    const uint64_t deadlocks_before = sampler.deadlocks();
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+    sampler.start();
+    const auto start = Clock::now();
+    for (uint32_t t = 0; t < opt.threads; ++t) {
+        workers.emplace_back([&, t] {
+            Worker w;
+            w.rng.reseed(0x9e3779b97f4a7c15ULL * (t + 1));
+            w.meta = repos.meta.current();
+            if (op.prepare || op.cleanup) w.admin = std::make_unique<pqxx::connection>(conn_str);
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string user = user_uuid(static_cast<uint32_t>(w.rng() % user_space));
+                try {
+                    if (op.prepare) op.prepare(repos, w, user);
+                    const auto begin = Clock::now();
+                    const bool success = op.run(repos, w, user);
+                    latency.record(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin).count()));
+                    (success ? ok : rejected).fetch_add(1, std::memory_order_relaxed);
+                    if (op.cleanup) op.cleanup(repos, w, user);
+                } catch (const std::exception& ex) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                    spdlog::debug("{}: {}", op.name, ex.what());
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(opt.duration_sec));
+    stop = true;
+    for (auto& w : workers) w.join();
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    sampler.stop();
+
+    OpResult res;
+    res.name = op.name;
+    res.ok = ok;
+    res.rejected = rejected;
+    res.errors = errors;
+    res.elapsed_sec = elapsed;
+    res.p50 = latency.percentile(0.50);
+    res.p99 = latency.percentile(0.99);
+    res.p999 = latency.percentile(0.999);
+    res.max = latency.max();
+    res.lock_avg = sampler.avg_waiting();
+    res.lock_max = sampler.max_waiting();
+    res.lock_wait_ms = sampler.est_wait_ms();
+    res.deadlocks = sampler.deadlocks() - deadlocks_before;
+    return res;
+}
+
+void print_results(const std::vector<OpResult>& results) {
+    std::printf("\n%-36s %9s %9s %8s %9s %9s %9s %9s %9s %8s %10s %5s\n", "op", "ops/s", "ok", "rejected",
+                "p50_ms", "p99_ms", "p999_ms", "max_ms", "lock_avg", "lock_max", "lock_ms", "dlk");
+    for (const auto& r : results) {
+        const double total = static_cast<double>(r.ok + r.rejected);
+        std::printf("%-36s %9.1f %9llu %8llu %9.3f %9.3f %9.3f %9.3f %9.2f %8llu %10.0f %5llu\n", r.name.c_str(),
+                    total / r.elapsed_sec, static_cast<unsigned long long>(r.ok),
+                    static_cast<unsigned long long>(r.rejected), r.p50 / 1000.0, r.p99 / 1000.0, r.p999 / 1000.0,
+                    r.max / 1000.0, r.lock_avg, static_cast<unsigned long long>(r.lock_max), r.lock_wait_ms,
+                    static_cast<unsigned long long>(r.deadlocks));
+        if (r.errors > 0) {
+            std::printf("  errors=%llu\n", static_cast<unsigned long long>(r.errors));
+        }
+    }
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "invalid argument: %s\n", arg.c_str());
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        auto as_u32 = [&value] { return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)); };
+        if (key == "users") opt.users = std::max(1u, as_u32());
+        else if (key == "threads") opt.threads = std::max(1u, as_u32());
+        else if (key == "duration") opt.duration_sec = std::max(1u, as_u32());
+        else if (key == "ops") opt.ops = value;
+        else if (key == "hot-users") opt.hot_users = as_u32();
+        else if (key == "pg-bin") opt.pg_bin = value;
+        else if (key == "pg-port") opt.pg_port = static_cast<unsigned short>(as_u32());
+        else if (key == "pg-opts") opt.pg_opts = value;
+        else if (key == "keep") opt.keep = value != "0";
+        else if (key == "conn") opt.conn = value;
+        else if (key == "schema") opt.schema = value;
+        else if (key == "metadata") opt.metadata = value;
+        else {
+            std::fprintf(stderr, "unknown option: --%s\n", key.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool selected(const std::string& spec, const char* name) {
+    if (spec == "all") return true;
+    std::stringstream ss(spec);
+    for (std::string item; std::getline(ss, item, ',');) {
+        if (item == name) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+    if (const char* bin = std::getenv("PG_BIN"); bin && opt.pg_bin.empty()) opt.pg_bin = bin;
+
+    spdlog::set_level(spdlog::level::warn);
+    EphemeralPostgres cluster(opt);
+    try {
+        std::string conn_str = opt.conn;
+        if (conn_str.empty()) {
+            cluster.start();
+            conn_str = cluster.conn_str();
+        }
+        apply_schema(conn_str, opt.schema);
+
+        MetadataStore metadata(opt.metadata);
+        if (!metadata.reload()) throw std::runtime_error("failed to load metadata from " + opt.metadata);
+
+        // 풀 크기는 스레드 수와 같게 잡아 풀 대기가 아닌 DB 지연/잠금만 측정한다
+        ConnectionPool pool(conn_str, opt.threads, opt.threads);
+        Repos repos(pool, metadata);
+        seed_users(repos, conn_str, opt);
+
+        LockSampler sampler(conn_str);
+        std::printf("threads=%u users=%u hot_users=%u duration=%us per op\n", opt.threads, opt.users, opt.hot_users,
+                    opt.duration_sec);
+        std::vector<OpResult> results;
+        for (const auto& op : build_ops()) {
+            if (!selected(opt.ops, op.name)) continue;
+            std::printf("running %s ...\n", op.name);
+            std::fflush(stdout);
+            results.push_back(run_op(op, repos, conn_str, opt, sampler));
+        }
+        print_results(results);
+
+        auto s = pool.stats();
+        std::printf("\npool: acquires=%llu timeouts=%llu wait_sum_ms=%.1f\n",
+                    static_cast<unsigned long long>(s.acquires), static_cast<unsigned long long>(s.acquire_timeouts),
+                    s.wait_sum_us / 1000.0);
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "bench failed: %s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
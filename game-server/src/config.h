@@ -16,6 +16,15 @@ inline unsigned int parse_uint_or(const char* key, const char* def) {
     }
 }
 
+inline unsigned long long parse_u64_or(const char* key, const char* def) {
+    std::string raw = env_or(key, def);
+    try {
+        return std::stoull(raw, nullptr, 0);
+    } catch (...) {
+        return std::stoull(def, nullptr, 0);
+    }
+}
+
 inline unsigned short parse_ushort_or(const char* key, const char* def) {
     std::string raw = env_or(key, def);
     try {
@@ -39,11 +48,61 @@ struct ServerConfig {
     // DB 커넥션 풀
     unsigned int db_pool_size = 4;
     unsigned int db_pool_max = 16;
+    unsigned int db_acquire_timeout_ms = 5000; // 커넥션 대기 한도
+    unsigned int db_idle_timeout_sec = 300;    // 초기 크기 초과분 유휴 커넥션 정리 기준
+    // 읽기 복제본 (호스트가 비어 있으면 비활성화)
+    std::string db_replica_host;
+    unsigned short db_replica_port = 5432;
+    unsigned int db_replica_pool_size = 4;
+    unsigned int db_replica_pool_max = 16;
+    unsigned int db_replica_acquire_timeout_ms = 200; // 초과 시 primary에서 읽음
+    unsigned int db_read_your_writes_ms = 2000;       // 최근 쓰기 후 이 시간 동안은 primary에서 읽음 (0이면 끔)
+    // libpq 파이프라인 모드 비동기 백엔드 (0이면 비활성화)
+    bool db_async_pipeline = false;
+    unsigned int db_async_connections = 2;
     // Redis 접속 설정
     std::string redis_host = "redis";
     unsigned short redis_port = 6379;
+    // 확률 판정 감사 시드 (0이면 비활성화, 설정 시 사용자별 결정적 스트림 + nonce 로그)
+    unsigned long long rng_audit_seed = 0;
+    // 메타데이터 변경 감시 주기 (0이면 파일 감시 끔, SIGHUP 리로드는 항상 가능)
+    unsigned int metadata_watch_interval_sec = 5;
+    // 컴파일된 메타데이터 번들 경로 (비어 있으면 METADATA_PATH/meta_bundle.bin)
+    std::string metadata_bundle_path;
     // 워커 스레드 수 (0이면 하드웨어 동시성)
     unsigned int worker_threads = 0;
+    // 연결 레이트 리미트 (토큰 버킷, burst 0이면 해당 단위 제한 끔)
+    unsigned int conn_rate_host_burst = 10;
+    unsigned int conn_rate_host_window_sec = 10;
+    unsigned int conn_rate_subnet_burst = 64;     // IPv4 /24, IPv6 /64
+    unsigned int conn_rate_subnet_window_sec = 10;
+    unsigned int conn_rate_table_size = 65536;    // 추적 항목 상한 (고정 메모리)
+    unsigned int conn_rate_sweep_interval_sec = 30;
+    // 세션별 인바운드 메시지 토큰 버킷 (비용은 MessageRatePolicy::defaults, MSG_RATE_COSTS로 재정의)
+    unsigned int msg_rate_capacity = 60;
+    unsigned int msg_rate_refill_per_sec = 20;
+    unsigned int msg_rate_max_violations = 20; // 0이면 초과해도 연결 유지
+    unsigned int msg_rate_violation_window_sec = 60; // 이 시간 안의 초과만 센다
+    std::string msg_rate_costs;                // 예: "GEM_LIST_REQUEST=10,HEARTBEAT=1"
+    // 이 시간 이상 걸린 요청은 구간별 분해와 함께 경고 로그 (0이면 끔)
+    unsigned int slow_request_ms = 200;
+    // 트래픽 캡처 (traffic-replay 도구 입력). 디렉터리가 비어 있으면 끔
+    std::string capture_dir;
+    unsigned int capture_sample_percent = 100;
+    unsigned int capture_max_mb = 1024;
+    // 시간 압축 시뮬레이션 (부하/밸런스 테스트 전용). 1보다 크면 가상 시계로 scale배 빠르게 진행
+    unsigned int sim_time_scale = 1;
+    // 종료 드레인 (SIGTERM/SIGINT): 배치당 세션 수와 배치 간격
+    unsigned int drain_batch_size = 200;
+    unsigned int drain_batch_interval_ms = 50;
+    // 무중단 재시작: 리슨 소켓을 주고받을 유닉스 소켓 경로 (비어 있으면 끔, 이전/새 프로세스가 같은 경로를 봐야 함)
+    std::string handoff_socket_path;
+    // 재접속 복원: 끊긴 세션의 메모리 상태를 이 시간 동안 보관 (0이면 끔, 프로세스 재시작 시 사라짐)
+    unsigned int resume_ttl_sec = 300;
+    unsigned int resume_max_entries = 100000;
+    // 여러 노드 운영: Redis 소유 키 + pub/sub으로 노드 간 중복 로그인 감지 (0이면 노드 안에서만)
+    bool cluster_sessions = false;
+    std::string node_id; // 비어 있으면 hostname-pid
 };
 
 inline ServerConfig load_config() {
@@ -59,8 +118,44 @@ inline ServerConfig load_config() {
     cfg.db_name = env_or("DB_NAME", "pickaxe_auth");
     cfg.db_pool_size = parse_uint_or("DB_POOL_SIZE", "4");
     cfg.db_pool_max = parse_uint_or("DB_POOL_MAX", "16");
+    cfg.db_acquire_timeout_ms = parse_uint_or("DB_ACQUIRE_TIMEOUT_MS", "5000");
+    cfg.db_idle_timeout_sec = parse_uint_or("DB_IDLE_TIMEOUT_SEC", "300");
+    cfg.db_replica_host = env_or("DB_REPLICA_HOST", "");
+    cfg.db_replica_port = parse_ushort_or("DB_REPLICA_PORT", "5432");
+    cfg.db_replica_pool_size = parse_uint_or("DB_REPLICA_POOL_SIZE", "4");
+    cfg.db_replica_pool_max = parse_uint_or("DB_REPLICA_POOL_MAX", "16");
+    cfg.db_replica_acquire_timeout_ms = parse_uint_or("DB_REPLICA_ACQUIRE_TIMEOUT_MS", "200");
+    cfg.db_read_your_writes_ms = parse_uint_or("DB_READ_YOUR_WRITES_MS", "2000");
+    cfg.db_async_pipeline = parse_uint_or("DB_ASYNC_PIPELINE", "0") != 0;
+    cfg.db_async_connections = parse_uint_or("DB_ASYNC_CONNECTIONS", "2");
     cfg.redis_host = env_or("REDIS_HOST", "redis");
     cfg.redis_port = parse_ushort_or("REDIS_PORT", "6379");
+    cfg.metadata_watch_interval_sec = parse_uint_or("METADATA_WATCH_INTERVAL_SEC", "5");
+    cfg.metadata_bundle_path = env_or("METADATA_BUNDLE_PATH", "");
     cfg.worker_threads = parse_uint_or("WORKER_THREADS", "0");
+    cfg.rng_audit_seed = parse_u64_or("RNG_AUDIT_SEED", "0");
+    cfg.conn_rate_host_burst = parse_uint_or("CONN_RATE_HOST_BURST", "10");
+    cfg.conn_rate_host_window_sec = parse_uint_or("CONN_RATE_HOST_WINDOW_SEC", "10");
+    cfg.conn_rate_subnet_burst = parse_uint_or("CONN_RATE_SUBNET_BURST", "64");
+    cfg.conn_rate_subnet_window_sec = parse_uint_or("CONN_RATE_SUBNET_WINDOW_SEC", "10");
+    cfg.conn_rate_table_size = parse_uint_or("CONN_RATE_TABLE_SIZE", "65536");
+    cfg.conn_rate_sweep_interval_sec = parse_uint_or("CONN_RATE_SWEEP_INTERVAL_SEC", "30");
+    cfg.msg_rate_capacity = parse_uint_or("MSG_RATE_CAPACITY", "60");
+    cfg.msg_rate_refill_per_sec = parse_uint_or("MSG_RATE_REFILL_PER_SEC", "20");
+    cfg.msg_rate_max_violations = parse_uint_or("MSG_RATE_MAX_VIOLATIONS", "20");
+    cfg.msg_rate_violation_window_sec = parse_uint_or("MSG_RATE_VIOLATION_WINDOW_SEC", "60");
+    cfg.msg_rate_costs = env_or("MSG_RATE_COSTS", "");
+    cfg.slow_request_ms = parse_uint_or("SLOW_REQUEST_MS", "200");
+    cfg.capture_dir = env_or("CAPTURE_DIR", "");
+    cfg.capture_sample_percent = parse_uint_or("CAPTURE_SAMPLE_PERCENT", "100");
+    cfg.capture_max_mb = parse_uint_or("CAPTURE_MAX_MB", "1024");
+    cfg.sim_time_scale = parse_uint_or("SIM_TIME_SCALE", "1");
+    cfg.drain_batch_size = parse_uint_or("DRAIN_BATCH_SIZE", "200");
+    cfg.drain_batch_interval_ms = parse_uint_or("DRAIN_BATCH_INTERVAL_MS", "50");
+    cfg.handoff_socket_path = env_or("HANDOFF_SOCKET_PATH", "");
+    cfg.resume_ttl_sec = parse_uint_or("RESUME_TTL_SEC", "300");
+    cfg.resume_max_entries = parse_uint_or("RESUME_MAX_ENTRIES", "100000");
+    cfg.cluster_sessions = parse_uint_or("CLUSTER_SESSIONS", "0") != 0;
+    cfg.node_id = env_or("NODE_ID", "");
     return cfg;
 }
@@ -4,17 +4,58 @@
 #include "server/ad_repository.h"
 #include "server/ad_service.h"
 #include "server/redis_client.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include "server/connection_pool.h"
+#include "server/async_pg_pool.h"
+#include "server/rng_service.h"
+#include "server/message_router.h"
+#include "server/metrics_server.h"
+#include "server/traffic_capture.h"
+#include "server/session_snapshot_store.h"
+#include "server/session_ownership.h"
+#include "server/game_clock.h"
+#include "server/listener_handoff.h"
 #include "config.h"
 #include <boost/asio.hpp>
 #include <spdlog/spdlog.h>
+#include <csignal>
+#include <functional>
 #include <thread>
 #include <sstream>
 
+namespace {
+// DB 커넥션 풀 지표 (primary / replica를 pool 라벨로 구분)
+void write_pool_metrics(metrics::Writer& w, const ConnectionPool& primary) {
+    std::vector<std::pair<const char*, ConnectionPool::Stats>> pools{{"primary", primary.stats()}};
+    if (primary.replica()) pools.emplace_back("replica", primary.replica()->stats());
+
+    auto label = [](const char* pool) { return std::string("pool=\"") + pool + "\""; };
+    w.header("game_db_pool_connections", "gauge", "DB pool connections by state");
+    for (const auto& [pool, s] : pools) {
+        w.sample("game_db_pool_connections", label(pool) + ",state=\"idle\"", static_cast<double>(s.idle));
+        w.sample("game_db_pool_connections", label(pool) + ",state=\"in_use\"", static_cast<double>(s.in_use));
+    }
+    w.header("game_db_pool_acquire_timeouts_total", "counter", "DB pool acquires that hit the deadline");
+    for (const auto& [pool, s] : pools) {
+        w.sample("game_db_pool_acquire_timeouts_total", label(pool), static_cast<double>(s.acquire_timeouts));
+    }
+    w.header("game_db_pool_wait_seconds", "histogram", "Time spent waiting for a DB connection");
+    std::array<double, ConnectionPool::kWaitBucketsMs.size()> bounds{};
+    for (std::size_t i = 0; i < bounds.size(); ++i) bounds[i] = ConnectionPool::kWaitBucketsMs[i] / 1000.0;
+    for (const auto& [pool, s] : pools) {
+        w.histogram("game_db_pool_wait_seconds", label(pool), bounds, s.wait_buckets, s.wait_sum_us / 1e6);
+    }
+    w.header("game_db_replica_fallbacks_total", "counter", "Reads sent to the primary instead of the replica");
+    w.sample("game_db_replica_fallbacks_total", "reason=\"read_your_writes\"", static_cast<double>(pools[0].second.ryw_fallbacks));
+    w.sample("game_db_replica_fallbacks_total", "reason=\"replica_busy\"", static_cast<double>(pools[0].second.replica_fallbacks));
+}
+} // namespace
+
 int main() {
     try {
         ServerConfig cfg = load_config();
+        RngService::configure(cfg.rng_audit_seed);
+        MessageRouter::configure(std::chrono::milliseconds(cfg.slow_request_ms));
         DbConfig dbcfg{cfg.db_host, cfg.db_port, cfg.db_user, cfg.db_password, cfg.db_name};
         std::ostringstream conn_str;
         conn_str << "host=" << dbcfg.host
@@ -22,18 +63,55 @@ int main() {
                  << " user=" << dbcfg.user
                  << " password=" << dbcfg.password
                  << " dbname=" << dbcfg.dbname;
-        ConnectionPool db_pool(conn_str.str(), cfg.db_pool_size, cfg.db_pool_max);
-        MetadataLoader metadata;
-        std::string meta_path = env_or("METADATA_PATH", "./metadata");
-        if (!metadata.load(meta_path)) {
-            spdlog::error("Failed to load metadata from {}", meta_path);
+        ConnectionPool db_pool(conn_str.str(), cfg.db_pool_size, cfg.db_pool_max,
+                               std::chrono::milliseconds(cfg.db_acquire_timeout_ms),
+                               std::chrono::seconds(cfg.db_idle_timeout_sec));
+        if (!cfg.db_replica_host.empty()) {
+            std::ostringstream replica_conn_str;
+            replica_conn_str << "host=" << cfg.db_replica_host
+                             << " port=" << cfg.db_replica_port
+                             << " user=" << dbcfg.user
+                             << " password=" << dbcfg.password
+                             << " dbname=" << dbcfg.dbname;
+            db_pool.attach_replica(
+                std::make_unique<ConnectionPool>(replica_conn_str.str(), cfg.db_replica_pool_size,
+                                                 cfg.db_replica_pool_max,
+                                                 std::chrono::milliseconds(cfg.db_replica_acquire_timeout_ms),
+                                                 std::chrono::seconds(cfg.db_idle_timeout_sec)),
+                std::chrono::milliseconds(cfg.db_read_your_writes_ms));
+            spdlog::info("DB read replica enabled: {}:{}", cfg.db_replica_host, cfg.db_replica_port);
+        }
+        boost::asio::io_context io;
+
+        // 파이프라인 모드 비동기 풀 (옵션): 단일 문장 조회/갱신을 io 스레드에서 논블로킹으로 처리
+        std::unique_ptr<AsyncPgPool> async_pool;
+        if (cfg.db_async_pipeline) {
+            async_pool = std::make_unique<AsyncPgPool>(io, conn_str.str(), cfg.db_async_connections);
+            if (!async_pool->start()) {
+                spdlog::warn("Async DB pipeline unavailable, falling back to blocking pool");
+                async_pool.reset();
+            }
+        }
+        MetadataStore metadata(env_or("METADATA_PATH", "./metadata"), cfg.metadata_bundle_path);
+        if (!metadata.reload()) {
+            spdlog::error("Failed to load metadata from {}", metadata.base_path());
             return 1;
         }
-        spdlog::info("Metadata loaded from {}", meta_path);
+        metadata.start_watch(std::chrono::seconds(cfg.metadata_watch_interval_sec));
+
+        // SIGHUP: 메타데이터 핫 리로드 (무중단 밸런스 패치)
+        boost::asio::signal_set reload_signals(io, SIGHUP);
+        std::function<void(const boost::system::error_code&, int)> on_reload_signal =
+            [&](const boost::system::error_code& ec, int) {
+                if (ec) return;
+                metadata.request_reload();
+                reload_signals.async_wait(on_reload_signal);
+            };
+        reload_signals.async_wait(on_reload_signal);
         RedisClient redis_client(cfg.redis_host, cfg.redis_port);
         AuthService auth_service(cfg.auth_host, cfg.auth_port, redis_client);
         GameRepository game_repo(db_pool, metadata);
-        MiningRepository mining_repo(db_pool);
+        MiningRepository mining_repo(db_pool, async_pool.get());
         UpgradeRepository upgrade_repo(db_pool);
         AdRepository ad_repo(db_pool);
         MissionRepository mission_repo(db_pool);
@@ -46,14 +124,135 @@ int main() {
         MissionService mission_service(mission_repo, game_repo, offline_repo, ad_service, metadata, redis_client);
         SlotService slot_service(slot_repo, game_repo, gem_repo, metadata);
         GemService gem_service(gem_repo, slot_repo, metadata);
-        OfflineService offline_service(offline_repo, metadata);
-        boost::asio::io_context io;
+        OfflineService offline_service(offline_repo, slot_service, game_repo, metadata);
+
+        ConnectionRateLimiter::Options rate_limit;
+        rate_limit.host_burst = cfg.conn_rate_host_burst;
+        rate_limit.host_window = std::chrono::seconds(cfg.conn_rate_host_window_sec);
+        rate_limit.subnet_burst = cfg.conn_rate_subnet_burst;
+        rate_limit.subnet_window = std::chrono::seconds(cfg.conn_rate_subnet_window_sec);
+        rate_limit.table_capacity = cfg.conn_rate_table_size;
+        rate_limit.sweep_interval = std::chrono::seconds(cfg.conn_rate_sweep_interval_sec);
+
+        MessageRatePolicy message_rate = MessageRatePolicy::defaults();
+        message_rate.capacity = cfg.msg_rate_capacity;
+        message_rate.refill_per_sec = cfg.msg_rate_refill_per_sec;
+        message_rate.max_violations = cfg.msg_rate_max_violations;
+        message_rate.violation_window = std::chrono::seconds(cfg.msg_rate_violation_window_sec);
+        message_rate.apply_overrides(cfg.msg_rate_costs);
+        message_rate.clamp_to_capacity();
+
+        if (cfg.sim_time_scale > 1) {
+            game_clock::set_virtual(std::chrono::system_clock::now(), cfg.sim_time_scale);
+            spdlog::warn("Simulation mode: game clock runs {}x faster than real time", cfg.sim_time_scale);
+        }
+
+        // 세션보다 오래 살아야 하므로 서버보다 먼저 생성
+        std::unique_ptr<TrafficCapture> capture;
+        if (!cfg.capture_dir.empty()) {
+            TrafficCapture::Options capture_options;
+            capture_options.dir = cfg.capture_dir;
+            capture_options.sample_percent = std::min(cfg.capture_sample_percent, 100u);
+            capture_options.max_bytes = static_cast<uint64_t>(cfg.capture_max_mb) * 1024 * 1024;
+            capture = TrafficCapture::open(capture_options);
+        }
+        std::unique_ptr<SessionSnapshotStore> resume_store;
+        if (cfg.resume_ttl_sec > 0) {
+            SessionSnapshotStore::Options resume_options;
+            resume_options.ttl = std::chrono::seconds(cfg.resume_ttl_sec);
+            resume_options.max_entries = cfg.resume_max_entries;
+            resume_store = std::make_unique<SessionSnapshotStore>(resume_options);
+        }
+        std::unique_ptr<SessionOwnership> ownership;
+        if (cfg.cluster_sessions) {
+            SessionOwnership::Options ownership_options;
+            ownership_options.host = cfg.redis_host;
+            ownership_options.port = cfg.redis_port;
+            ownership_options.node_id = cfg.node_id;
+            ownership = std::make_unique<SessionOwnership>(ownership_options);
+        }
+
+        // 무중단 재시작: 이전 프로세스가 있으면 리슨 소켓을 넘겨받아 같은 큐에서 바로 accept
+        int inherited_listen_fd = -1;
+        if (!cfg.handoff_socket_path.empty()) {
+            if (auto fd = receive_listener(cfg.handoff_socket_path)) {
+                inherited_listen_fd = *fd;
+                spdlog::info("Adopted listening socket from previous process via {}", cfg.handoff_socket_path);
+            }
+        }
 
         TcpServer server(io, cfg.listen_port, auth_service, game_repo,
                          mining_service, upgrade_service, mission_service,
                          slot_service, offline_service, ad_service, gem_service,
-                         redis_client, metadata);
+                         redis_client, metadata, rate_limit, message_rate, capture.get(),
+                         inherited_listen_fd, resume_store.get(), ownership.get());
         server.start();
+        if (ownership) {
+            // 구독 스레드에서 받은 킥은 io 스레드로 넘겨 세션 상태와 같은 경로에서 처리
+            ownership->start([&io, &server](const std::string& user_id, uint64_t owner_token) {
+                boost::asio::post(io, [&server, user_id, owner_token]() { server.kick_session(user_id, owner_token); });
+            });
+        }
+
+        // health_port: /healthz, /readyz, /metrics
+        MetricsServer metrics_server;
+        metrics_server.add_collector([&server](metrics::Writer& w) { server.collect_metrics(w); });
+        metrics_server.add_collector(&MessageRouter::render_metrics);
+        metrics_server.add_collector([&db_pool](metrics::Writer& w) { write_pool_metrics(w, db_pool); });
+        metrics_server.add_collector([&metadata](metrics::Writer& w) {
+            w.header("game_metadata_version", "gauge", "Number of metadata snapshots published since start");
+            w.sample("game_metadata_version", "", static_cast<double>(metadata.version()));
+        });
+        if (ownership) {
+            metrics_server.add_collector([&ownership](metrics::Writer& w) {
+                const auto s = ownership->stats();
+                w.header("game_session_ownership_claims_total", "counter", "Cluster session ownership claims on login");
+                w.sample("game_session_ownership_claims_total", "", static_cast<double>(s.claims));
+                w.header("game_session_ownership_takeovers_total", "counter", "Claims that replaced another live owner");
+                w.sample("game_session_ownership_takeovers_total", "", static_cast<double>(s.takeovers));
+                w.header("game_session_kicks_total", "counter", "Cross-node duplicate session kicks");
+                w.sample("game_session_kicks_total", "direction=\"sent\"", static_cast<double>(s.kicks_sent));
+                w.sample("game_session_kicks_total", "direction=\"received\"", static_cast<double>(s.kicks_received));
+                w.header("game_session_ownership_errors_total", "counter", "Redis errors in the session ownership layer");
+                w.sample("game_session_ownership_errors_total", "", static_cast<double>(s.errors));
+            });
+        }
+        metrics_server.add_readiness_check("metadata", [&metadata](std::string& reason) {
+            if (metadata.current()) return true;
+            reason = "not loaded";
+            return false;
+        });
+        metrics_server.add_readiness_check("db", [&db_pool](std::string& reason) {
+            if (db_pool.stats().total > 0) return true;
+            reason = "no connections";
+            return false;
+        });
+        metrics_server.start("0.0.0.0", cfg.health_port);
+
+        // SIGTERM/SIGINT 또는 리슨 소켓 인계: 준비 상태 해제 후 세션을 저장/알림/종료하고 io 정지
+        // 드레인 중 같은 신호를 한 번 더 받으면 즉시 종료
+        TcpServer::DrainOptions drain_options;
+        drain_options.batch_size = cfg.drain_batch_size;
+        drain_options.batch_interval = std::chrono::milliseconds(cfg.drain_batch_interval_ms);
+        auto begin_drain = [&](const char* reason) {
+            spdlog::info("Shutting down ({}), draining sessions", reason);
+            metrics_server.set_ready(false);
+            server.drain(drain_options, [&io]() { io.stop(); });
+        };
+        boost::asio::signal_set stop_signals(io, SIGTERM, SIGINT);
+        stop_signals.async_wait([&](const boost::system::error_code& ec, int signo) {
+            if (ec) return;
+            begin_drain(signo == SIGTERM ? "SIGTERM" : "SIGINT");
+            stop_signals.async_wait([&io](const boost::system::error_code& again, int) {
+                if (!again) io.stop();
+            });
+        });
+        std::unique_ptr<ListenerHandoff> handoff;
+        if (!cfg.handoff_socket_path.empty()) {
+            handoff = std::make_unique<ListenerHandoff>(io, cfg.handoff_socket_path, server.listen_fd(),
+                                                        [&begin_drain]() { begin_drain("handoff"); });
+            handoff->start();
+        }
 
         spdlog::info("Game server listening on port {}", cfg.listen_port);
         spdlog::info("Auth endpoint {}:{}", cfg.auth_host, cfg.auth_port);
@@ -71,6 +270,8 @@ int main() {
             pool.emplace_back([&io]() { io.run(); });
         }
         for (auto& t : pool) t.join();
+        if (ownership) ownership->stop();
+        spdlog::info("Game server stopped");
     } catch (const std::exception& ex) {
         spdlog::error("Server crashed: {}", ex.what());
         return 1;
@@ -0,0 +1,503 @@
+// meta_bundle.bin 인코딩/디코딩
+//
+// 레이아웃 (리틀 엔디언, 패딩 없음)
+//   header: magic "IPMB" | u32 format_version | u64 payload_size | u64 payload_fnv1a | u64 source_fnv1a
+//   payload: 섹션 순서 고정, 문자열 = u32 길이 + 바이트, 배열 = u32 개수 + 원소
+// 파생 데이터(enum 변환, ID 인덱스, 가챠 alias 테이블)는 저장하지 않고 build_indexes()에서 다시 만든다.
+// 필드를 추가/변경하면 kFormatVersion을 올린다 (버전이 다르면 JSON으로 폴백).
+#include "metadata_loader.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "meta_bundle.bin layout assumes a little-endian host"
+#endif
+
+namespace {
+
+constexpr char kMagic[4] = {'I', 'P', 'M', 'B'};
+constexpr uint32_t kFormatVersion = 1;
+
+struct Header {
+    char magic[4];
+    uint32_t format_version;
+    uint64_t payload_size;
+    uint64_t payload_checksum;
+    uint64_t source_checksum;
+};
+static_assert(sizeof(Header) == 32, "meta_bundle.bin header must stay 32 bytes");
+
+uint64_t fnv1a(const char* data, std::size_t size) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// 읽기 전용 mmap (RAII)
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) return;
+        struct stat st{};
+        if (::fstat(fd_, &st) != 0 || st.st_size <= 0) return;
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) return;
+        data_ = static_cast<const char*>(p);
+        size_ = static_cast<std::size_t>(st.st_size);
+    }
+    ~MappedFile() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool exists() const { return fd_ >= 0; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    int fd_{-1};
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// 원본 JSON이 없으면 0 (stale 검사 생략)
+uint64_t source_checksum(const std::string& json_path) {
+    MappedFile src(json_path);
+    if (!src.exists()) return 0;
+    return fnv1a(src.data(), src.size());
+}
+
+class Writer {
+public:
+    template <typename T>
+    void pod(T v) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod only");
+        buf_.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    void u8(bool v) { pod<uint8_t>(v ? 1 : 0); }
+    void u32(uint32_t v) { pod(v); }
+    void u64(uint64_t v) { pod(v); }
+    void f64(double v) { pod(v); }
+    void str(const std::string& s) {
+        u32(static_cast<uint32_t>(s.size()));
+        buf_.append(s);
+    }
+    void count(std::size_t n) { u32(static_cast<uint32_t>(n)); }
+    const std::string& buffer() const { return buf_; }
+
+private:
+    std::string buf_;
+};
+
+// mmap 영역을 직접 읽는 커서. 범위를 벗어나면 예외
+class Reader {
+public:
+    Reader(const char* p, std::size_t size) : p_(p), end_(p + size) {}
+
+    template <typename T>
+    T pod() {
+        need(sizeof(T));
+        T v;
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+        return v;
+    }
+    bool u8() { return pod<uint8_t>() != 0; }
+    uint32_t u32() { return pod<uint32_t>(); }
+    uint64_t u64() { return pod<uint64_t>(); }
+    double f64() { return pod<double>(); }
+    std::string str() {
+        uint32_t n = u32();
+        need(n);
+        std::string s(p_, n);
+        p_ += n;
+        return s;
+    }
+    // 원소 최소 크기로 개수 상한 검사 (손상된 개수로 거대한 reserve 방지)
+    uint32_t count(std::size_t min_element_size) {
+        uint32_t n = u32();
+        if (min_element_size > 0 && n > remaining() / min_element_size) {
+            throw std::runtime_error("corrupt element count");
+        }
+        return n;
+    }
+    std::size_t remaining() const { return static_cast<std::size_t>(end_ - p_); }
+
+private:
+    void need(std::size_t n) const {
+        if (remaining() < n) throw std::runtime_error("truncated payload");
+    }
+    const char* p_;
+    const char* end_;
+};
+
+} // namespace
+
+bool MetadataLoader::save_binary(const std::string& bin_path, const std::string& source_json_path,
+                                 std::string& error) const {
+    Writer w;
+
+    w.count(pickaxe_levels_.items().size());
+    for (const auto& pl : pickaxe_levels_.items()) {
+        w.u32(pl.level);
+        w.u32(pl.tier);
+        w.u64(pl.attack_power);
+        w.f64(pl.attack_speed);
+        w.u64(pl.dps);
+        w.u64(pl.cost);
+    }
+
+    w.count(minerals_.items().size());
+    for (const auto& mm : minerals_.items()) {
+        w.u32(mm.id);
+        w.str(mm.name);
+        w.u64(mm.hp);
+        w.u64(mm.reward);
+        w.u32(mm.respawn_time);
+        w.u64(mm.recommended_min_dps);
+        w.u64(mm.recommended_max_dps);
+    }
+
+    w.u32(daily_missions_config_.total_slots);
+    w.u32(daily_missions_config_.max_daily_assign);
+    w.count(missions_.size());
+    for (const auto& m : missions_) {
+        w.u32(m.index);
+        w.u32(m.id);
+        w.str(m.type);
+        w.u32(m.target);
+        w.u32(m.reward_crystal);
+        w.str(m.description);
+        w.str(m.difficulty);
+        w.u8(m.mineral_id.has_value());
+        w.u32(m.mineral_id.value_or(0));
+    }
+    w.count(milestone_bonuses_.size());
+    for (const auto& b : milestone_bonuses_) {
+        w.u32(b.completed);
+        w.u32(b.bonus_hours);
+    }
+
+    w.f64(upgrade_rules_.min_rate);
+    w.f64(upgrade_rules_.bonus_rate);
+    // unordered_map 순회 순서에 따라 파일이 달라지지 않도록 tier 순으로 기록
+    std::map<uint32_t, double> rates(upgrade_rules_.base_rate_by_tier.begin(), upgrade_rules_.base_rate_by_tier.end());
+    w.count(rates.size());
+    for (const auto& [tier, rate] : rates) {
+        w.u32(tier);
+        w.f64(rate);
+    }
+
+    w.count(ad_types_.size());
+    for (const auto& ad : ad_types_) {
+        w.str(ad.id);
+        w.str(ad.effect);
+        w.u32(ad.daily_limit);
+        w.count(ad.rewards_by_view.size());
+        for (uint32_t r : ad.rewards_by_view) w.u32(r);
+        w.u32(ad.cost_multiplier);
+        w.u8(ad.apply_to_all_slots);
+        w.u8(ad.progress_reset_on_reroll);
+    }
+
+    w.u32(offline_defaults_.initial_offline_seconds);
+    w.u32(mission_reroll_.free_rerolls_per_day);
+    w.u32(mission_reroll_.ad_rerolls_per_day);
+    w.u8(mission_reroll_.apply_to_all_slots);
+    w.u8(mission_reroll_.progress_reset_on_reroll);
+
+    w.count(gem_types_.size());
+    for (const auto& gt : gem_types_) {
+        w.u32(gt.id);
+        w.str(gt.type);
+        w.str(gt.display_name);
+        w.str(gt.description);
+        w.str(gt.stat_key);
+    }
+    w.count(gem_grades_.size());
+    for (const auto& gg : gem_grades_) {
+        w.u32(gg.id);
+        w.str(gg.grade);
+        w.str(gg.display_name);
+    }
+    w.count(gem_definitions_.size());
+    for (const auto& gd : gem_definitions_) {
+        w.u32(gd.gem_id);
+        w.u32(gd.grade_id);
+        w.u32(gd.type_id);
+        w.str(gd.name);
+        w.str(gd.icon);
+        w.u32(gd.stat_multiplier);
+    }
+
+    w.u32(gem_gacha_.single_pull_cost);
+    w.u32(gem_gacha_.multi_pull_cost);
+    w.u32(gem_gacha_.multi_pull_count);
+    w.count(gem_gacha_.grade_rates.size());
+    for (const auto& rate : gem_gacha_.grade_rates) {
+        w.u32(rate.grade_id);
+        w.u32(rate.rate_percent);
+    }
+
+    w.count(gem_synthesis_rules_.size());
+    for (const auto& rule : gem_synthesis_rules_) {
+        w.str(rule.from_grade);
+        w.str(rule.to_grade);
+        w.u32(rule.success_rate_percent);
+    }
+    w.count(gem_conversion_costs_.size());
+    for (const auto& c : gem_conversion_costs_) {
+        w.u32(c.grade_id);
+        w.u32(c.random_cost);
+        w.u32(c.fixed_cost);
+    }
+    w.count(gem_discard_rewards_.size());
+    for (const auto& r : gem_discard_rewards_) {
+        w.u32(r.grade_id);
+        w.u32(r.crystal_reward);
+    }
+    w.u32(gem_inventory_config_.base_capacity);
+    w.u32(gem_inventory_config_.max_capacity);
+    w.u32(gem_inventory_config_.expand_step);
+    w.u32(gem_inventory_config_.expand_cost);
+    w.count(gem_slot_unlock_costs_.size());
+    for (const auto& c : gem_slot_unlock_costs_) {
+        w.u32(c.slot_index);
+        w.u32(c.unlock_cost_crystal);
+    }
+
+    const std::string& payload = w.buffer();
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format_version = kFormatVersion;
+    header.payload_size = payload.size();
+    header.payload_checksum = fnv1a(payload.data(), payload.size());
+    header.source_checksum = source_checksum(source_json_path);
+
+    // 임시 파일에 쓴 뒤 rename (서버가 읽는 도중 덮어쓰지 않도록)
+    const std::string tmp_path = bin_path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            error = "cannot open " + tmp_path;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            error = "write failed: " + tmp_path;
+            return false;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), bin_path.c_str()) != 0) {
+        error = "rename failed: " + bin_path;
+        return false;
+    }
+    return true;
+}
+
+bool MetadataLoader::load_binary(const std::string& bin_path, const std::string& source_json_path,
+                                 std::string& error) {
+    error.clear();
+    MappedFile file(bin_path);
+    if (!file.exists()) return false;
+
+    if (file.size() < sizeof(Header)) {
+        error = "file too small";
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "bad magic";
+        return false;
+    }
+    if (header.format_version != kFormatVersion) {
+        error = "format version " + std::to_string(header.format_version) + " != " + std::to_string(kFormatVersion);
+        return false;
+    }
+    if (header.payload_size != file.size() - sizeof(Header)) {
+        error = "payload size mismatch";
+        return false;
+    }
+    const char* payload = file.data() + sizeof(Header);
+    if (fnv1a(payload, header.payload_size) != header.payload_checksum) {
+        error = "checksum mismatch";
+        return false;
+    }
+    uint64_t source = source_checksum(source_json_path);
+    if (source != 0 && header.source_checksum != source) {
+        error = "stale (meta_bundle.json changed since compile)";
+        return false;
+    }
+
+    reset();
+    try {
+        Reader r(payload, header.payload_size);
+
+        for (uint32_t n = r.count(40); n > 0; --n) {
+            PickaxeLevel pl;
+            pl.level = r.u32();
+            pl.tier = r.u32();
+            pl.attack_power = r.u64();
+            pl.attack_speed = r.f64();
+            pl.dps = r.u64();
+            pl.cost = r.u64();
+            pickaxe_levels_.insert(pl.level, pl);
+        }
+
+        for (uint32_t n = r.count(44); n > 0; --n) {
+            MineralMeta mm;
+            mm.id = r.u32();
+            mm.name = r.str();
+            mm.hp = r.u64();
+            mm.reward = r.u64();
+            mm.respawn_time = r.u32();
+            mm.recommended_min_dps = r.u64();
+            mm.recommended_max_dps = r.u64();
+            minerals_.insert(mm.id, mm);
+        }
+
+        daily_missions_config_.total_slots = r.u32();
+        daily_missions_config_.max_daily_assign = r.u32();
+        uint32_t mission_count = r.count(33);
+        missions_.reserve(mission_count);
+        for (uint32_t n = mission_count; n > 0; --n) {
+            MissionMeta m;
+            m.index = r.u32();
+            m.id = r.u32();
+            m.type = r.str();
+            m.target = r.u32();
+            m.reward_crystal = r.u32();
+            m.description = r.str();
+            m.difficulty = r.str();
+            bool has_mineral = r.u8();
+            uint32_t mineral_id = r.u32();
+            if (has_mineral) m.mineral_id = mineral_id;
+            missions_.push_back(std::move(m));
+        }
+        for (uint32_t n = r.count(8); n > 0; --n) {
+            MilestoneBonus b;
+            b.completed = r.u32();
+            b.bonus_hours = r.u32();
+            milestone_bonuses_.push_back(b);
+        }
+
+        upgrade_rules_.min_rate = r.f64();
+        upgrade_rules_.bonus_rate = r.f64();
+        for (uint32_t n = r.count(12); n > 0; --n) {
+            uint32_t tier = r.u32();
+            upgrade_rules_.base_rate_by_tier[tier] = r.f64();
+        }
+
+        for (uint32_t n = r.count(22); n > 0; --n) {
+            AdTypeMeta ad;
+            ad.id = r.str();
+            ad.effect = r.str();
+            ad.daily_limit = r.u32();
+            for (uint32_t k = r.count(4); k > 0; --k) ad.rewards_by_view.push_back(r.u32());
+            ad.cost_multiplier = r.u32();
+            ad.apply_to_all_slots = r.u8();
+            ad.progress_reset_on_reroll = r.u8();
+            ad_types_by_id_[ad.id] = ad;
+            ad_types_.push_back(std::move(ad));
+        }
+
+        offline_defaults_.initial_offline_seconds = r.u32();
+        mission_reroll_.free_rerolls_per_day = r.u32();
+        mission_reroll_.ad_rerolls_per_day = r.u32();
+        mission_reroll_.apply_to_all_slots = r.u8();
+        mission_reroll_.progress_reset_on_reroll = r.u8();
+
+        for (uint32_t n = r.count(20); n > 0; --n) {
+            GemTypeMeta gt;
+            gt.id = r.u32();
+            gt.type = r.str();
+            gt.display_name = r.str();
+            gt.description = r.str();
+            gt.stat_key = r.str();
+            gem_types_.push_back(std::move(gt));
+        }
+        for (uint32_t n = r.count(12); n > 0; --n) {
+            GemGradeMeta gg;
+            gg.id = r.u32();
+            gg.grade = r.str();
+            gg.display_name = r.str();
+            gem_grades_.push_back(std::move(gg));
+        }
+        for (uint32_t n = r.count(24); n > 0; --n) {
+            GemDefinition gd;
+            gd.gem_id = r.u32();
+            gd.grade_id = r.u32();
+            gd.type_id = r.u32();
+            gd.name = r.str();
+            gd.icon = r.str();
+            gd.stat_multiplier = r.u32();
+            gem_definitions_.push_back(std::move(gd));
+        }
+
+        gem_gacha_.single_pull_cost = r.u32();
+        gem_gacha_.multi_pull_cost = r.u32();
+        gem_gacha_.multi_pull_count = r.u32();
+        for (uint32_t n = r.count(8); n > 0; --n) {
+            GemGradeRate rate;
+            rate.grade_id = r.u32();
+            rate.rate_percent = r.u32();
+            gem_gacha_.grade_rates.push_back(rate);
+        }
+
+        for (uint32_t n = r.count(12); n > 0; --n) {
+            GemSynthesisRule rule;
+            rule.from_grade = r.str();
+            rule.to_grade = r.str();
+            rule.success_rate_percent = r.u32();
+            gem_synthesis_rules_.push_back(std::move(rule));
+        }
+        for (uint32_t n = r.count(12); n > 0; --n) {
+            GemConversionCost c;
+            c.grade_id = r.u32();
+            c.random_cost = r.u32();
+            c.fixed_cost = r.u32();
+            gem_conversion_costs_.push_back(c);
+        }
+        for (uint32_t n = r.count(8); n > 0; --n) {
+            GemDiscardReward d;
+            d.grade_id = r.u32();
+            d.crystal_reward = r.u32();
+            gem_discard_rewards_.push_back(d);
+        }
+        gem_inventory_config_.base_capacity = r.u32();
+        gem_inventory_config_.max_capacity = r.u32();
+        gem_inventory_config_.expand_step = r.u32();
+        gem_inventory_config_.expand_cost = r.u32();
+        for (uint32_t n = r.count(8); n > 0; --n) {
+            GemSlotUnlockCost c;
+            c.slot_index = r.u32();
+            c.unlock_cost_crystal = r.u32();
+            gem_slot_unlock_costs_.push_back(c);
+        }
+
+        if (r.remaining() != 0) {
+            throw std::runtime_error("trailing bytes");
+        }
+    } catch (const std::exception& ex) {
+        error = ex.what();
+        reset();
+        return false;
+    }
+    return true;
+}
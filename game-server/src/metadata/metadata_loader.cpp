@@ -1,35 +1,82 @@
 #include "metadata_loader.h"
+#include <algorithm>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
 #include <sstream>
 
-bool MetadataLoader::load(const std::string& base_path) {
+namespace {
+infinitepickaxe::GemType parse_gem_type(const std::string& type) {
+    infinitepickaxe::GemType value;
+    if (infinitepickaxe::GemType_Parse(type, &value)) return value;
+    return infinitepickaxe::GEM_TYPE_UNKNOWN;
+}
+
+infinitepickaxe::GemGrade parse_gem_grade(const std::string& grade) {
+    infinitepickaxe::GemGrade value;
+    if (infinitepickaxe::GemGrade_Parse(grade, &value)) return value;
+    return infinitepickaxe::GEM_GRADE_UNKNOWN;
+}
+}
+
+bool MetadataLoader::load(const std::string& base_path, const std::string& bin_path_override) {
+    const std::string json_path = base_path + "/meta_bundle.json";
+    const std::string bin_path = bin_path_override.empty() ? base_path + "/meta_bundle.bin" : bin_path_override;
+
+    // 컴파일된 바이너리 번들 우선 (원본 JSON과 해시가 맞을 때만), 실패 시 JSON 파싱
     try {
-        // 기존 데이터 클리어
-        pickaxe_levels_.clear();
-        minerals_.clear();
-        missions_.clear();
-        milestone_bonuses_.clear();
-        ad_types_.clear();
-        ad_types_by_id_.clear();
-        daily_missions_config_ = DailyMissionConfig{};
-        mission_reroll_ = MissionRerollMeta{};
-        offline_defaults_ = OfflineDefaults{};
-        gem_types_.clear();
-        gem_grades_.clear();
-        gem_definitions_.clear();
-        gem_synthesis_rules_.clear();
-        gem_conversion_costs_.clear();
-        gem_discard_rewards_.clear();
-        gem_slot_unlock_costs_.clear();
-        gem_types_by_id_.clear();
-        gem_grades_by_id_.clear();
-        gem_definitions_by_id_.clear();
-        gem_gacha_ = GemGachaMeta{};
-        gem_inventory_config_ = GemInventoryConfig{};
-
-        // meta_bundle.json 읽기 (번들 기반 파싱)
-        std::ifstream f(base_path + "/meta_bundle.json");
+        std::string error;
+        if (load_binary(bin_path, json_path, error)) {
+            build_indexes();
+            return true;
+        }
+        if (!error.empty()) {
+            spdlog::warn("meta_bundle.bin not used ({}), falling back to JSON", error);
+        }
+        if (!load_json(json_path)) {
+            return false;
+        }
+        build_indexes();
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void MetadataLoader::reset() {
+    pickaxe_levels_.clear();
+    minerals_.clear();
+    missions_.clear();
+    milestone_bonuses_.clear();
+    ad_types_.clear();
+    ad_types_by_id_.clear();
+    daily_missions_config_ = DailyMissionConfig{};
+    mission_reroll_ = MissionRerollMeta{};
+    offline_defaults_ = OfflineDefaults{};
+    gem_types_.clear();
+    gem_grades_.clear();
+    gem_definitions_.clear();
+    gem_synthesis_rules_.clear();
+    gem_conversion_costs_.clear();
+    gem_discard_rewards_.clear();
+    gem_slot_unlock_costs_.clear();
+    gem_types_by_id_.clear();
+    gem_grades_by_id_.clear();
+    gem_definitions_by_id_.clear();
+    gem_synthesis_rules_by_from_.clear();
+    gem_type_id_by_enum_.clear();
+    gem_definition_by_grade_type_.clear();
+    gem_type_stride_ = 0;
+    gem_gacha_sampler_ = GemGachaSampler{};
+    gem_gacha_ = GemGachaMeta{};
+    gem_inventory_config_ = GemInventoryConfig{};
+    upgrade_rules_ = UpgradeRules{};
+}
+
+bool MetadataLoader::load_json(const std::string& json_path) {
+    reset();
+    try {
+        std::ifstream f(json_path);
         if (!f.good()) {
             return false;
         }
@@ -38,7 +85,7 @@ bool MetadataLoader::load(const std::string& base_path) {
 
         // pickaxe_levels
         {
-            nlohmann::json j = bundle["pickaxe_levels"];
+            const nlohmann::json& j = bundle["pickaxe_levels"];
             for (auto& e : j) {
                 PickaxeLevel pl;
                 pl.level = e["level"].get<uint32_t>();
@@ -56,13 +103,13 @@ bool MetadataLoader::load(const std::string& base_path) {
                 pl.attack_speed = e["attack_speed"].get<double>();
                 pl.dps = e["dps"].get<uint64_t>();
                 pl.cost = e["cost"].get<uint64_t>();
-                pickaxe_levels_[pl.level] = pl;
+                pickaxe_levels_.insert(pl.level, pl);
             }
         }
 
         // minerals
         {
-            nlohmann::json j = bundle["minerals"];
+            const nlohmann::json& j = bundle["minerals"];
             if (j.is_array()) {
                 for (auto& e : j) {
                     MineralMeta mm;
@@ -73,14 +120,14 @@ bool MetadataLoader::load(const std::string& base_path) {
                     mm.respawn_time = e.value<uint32_t>("respawn_time", 5);
                     mm.recommended_min_dps = e.value<uint64_t>("recommended_min_DPS", 0);
                     mm.recommended_max_dps = e.value<uint64_t>("recommended_max_DPS", 0);
-                    minerals_[mm.id] = mm;
+                    minerals_.insert(mm.id, mm);
                 }
             }
         }
 
         // daily_missions
         {
-            nlohmann::json j = bundle["daily_missions"];
+            const nlohmann::json& j = bundle["daily_missions"];
             if (j.is_object()) {
                 daily_missions_config_.total_slots = j.value("total_slots", daily_missions_config_.total_slots);
                 daily_missions_config_.max_daily_assign = j.value("max_daily_assign", daily_missions_config_.max_daily_assign);
@@ -142,7 +189,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // upgrade_rules
         {
             if (bundle.contains("upgrade_rules")) {
-                nlohmann::json j = bundle["upgrade_rules"];
+                const nlohmann::json& j = bundle["upgrade_rules"];
                 upgrade_rules_.min_rate = to_rate(j["min_rate"], 0.3);
                 upgrade_rules_.bonus_rate = to_rate(j["bonus_rate"], 0.1);
                 if (j.contains("base_rate_by_tier")) {
@@ -163,7 +210,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // ads
         {
             if (bundle.contains("ads")) {
-                nlohmann::json j = bundle["ads"];
+                const nlohmann::json& j = bundle["ads"];
                 if (j.contains("ad_types") && j["ad_types"].is_array()) {
                     for (auto& e : j["ad_types"]) {
                         AdTypeMeta ad;
@@ -204,7 +251,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // offline_defaults
         {
             if (bundle.contains("offline_defaults")) {
-                nlohmann::json j = bundle["offline_defaults"];
+                const nlohmann::json& j = bundle["offline_defaults"];
                 uint32_t hours = j.value("initial_offline_hours", 0);
                 offline_defaults_.initial_offline_seconds = hours * 3600;
             } else {
@@ -215,7 +262,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // mission_reroll
         {
             if (bundle.contains("mission_reroll")) {
-                nlohmann::json j = bundle["mission_reroll"];
+                const nlohmann::json& j = bundle["mission_reroll"];
                 mission_reroll_.free_rerolls_per_day = j.value("free_rerolls_per_day", 0);
                 mission_reroll_.ad_rerolls_per_day = j.value("ad_rerolls_per_day", 0);
                 mission_reroll_.apply_to_all_slots = j.value("apply_to_slots", true);
@@ -233,7 +280,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_types
         {
             if (bundle.contains("gem_types")) {
-                nlohmann::json j = bundle["gem_types"];
+                const nlohmann::json& j = bundle["gem_types"];
                 for (auto& e : j) {
                     GemTypeMeta gt;
                     gt.id = e.value("id", 0);
@@ -242,7 +289,6 @@ bool MetadataLoader::load(const std::string& base_path) {
                     gt.description = e.value("description", "");
                     gt.stat_key = e.value("stat_key", "");
                     gem_types_.push_back(gt);
-                    gem_types_by_id_[gt.id] = gt;
                 }
             }
         }
@@ -250,14 +296,13 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_grades
         {
             if (bundle.contains("gem_grades")) {
-                nlohmann::json j = bundle["gem_grades"];
+                const nlohmann::json& j = bundle["gem_grades"];
                 for (auto& e : j) {
                     GemGradeMeta gg;
                     gg.id = e.value("id", 0);
                     gg.grade = e.value("grade", "");
                     gg.display_name = e.value("display_name", "");
                     gem_grades_.push_back(gg);
-                    gem_grades_by_id_[gg.id] = gg;
                 }
             }
         }
@@ -265,7 +310,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_definitions
         {
             if (bundle.contains("gem_definitions")) {
-                nlohmann::json j = bundle["gem_definitions"];
+                const nlohmann::json& j = bundle["gem_definitions"];
                 for (auto& e : j) {
                     GemDefinition gd;
                     gd.gem_id = e.value("gem_id", 0);
@@ -275,7 +320,6 @@ bool MetadataLoader::load(const std::string& base_path) {
                     gd.icon = e.value("icon", "");
                     gd.stat_multiplier = e.value("stat_multiplier", 0);
                     gem_definitions_.push_back(gd);
-                    gem_definitions_by_id_[gd.gem_id] = gd;
                 }
             }
         }
@@ -283,7 +327,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_gacha
         {
             if (bundle.contains("gem_gacha")) {
-                nlohmann::json j = bundle["gem_gacha"];
+                const nlohmann::json& j = bundle["gem_gacha"];
                 gem_gacha_.single_pull_cost = j.value("single_pull_cost", 0);
                 gem_gacha_.multi_pull_cost = j.value("multi_pull_cost", 0);
                 gem_gacha_.multi_pull_count = j.value("multi_pull_count", 0);
@@ -301,7 +345,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_synthesis_rules
         {
             if (bundle.contains("gem_synthesis_rules")) {
-                nlohmann::json j = bundle["gem_synthesis_rules"];
+                const nlohmann::json& j = bundle["gem_synthesis_rules"];
                 for (auto& e : j) {
                     GemSynthesisRule rule;
                     rule.from_grade = e.value("from_grade", "");
@@ -315,7 +359,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_conversion
         {
             if (bundle.contains("gem_conversion")) {
-                nlohmann::json j = bundle["gem_conversion"];
+                const nlohmann::json& j = bundle["gem_conversion"];
                 for (auto& e : j) {
                     GemConversionCost cost;
                     cost.grade_id = e.value("grade_id", 0);
@@ -329,7 +373,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_discard
         {
             if (bundle.contains("gem_discard")) {
-                nlohmann::json j = bundle["gem_discard"];
+                const nlohmann::json& j = bundle["gem_discard"];
                 for (auto& e : j) {
                     GemDiscardReward reward;
                     reward.grade_id = e.value("grade_id", 0);
@@ -342,7 +386,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_inventory
         {
             if (bundle.contains("gem_inventory")) {
-                nlohmann::json j = bundle["gem_inventory"];
+                const nlohmann::json& j = bundle["gem_inventory"];
                 gem_inventory_config_.base_capacity = j.value("base_capacity", 48);
                 gem_inventory_config_.max_capacity = j.value("max_capacity", 128);
                 gem_inventory_config_.expand_step = j.value("expand_step", 8);
@@ -353,7 +397,7 @@ bool MetadataLoader::load(const std::string& base_path) {
         // gem_slot_unlock_costs
         {
             if (bundle.contains("gem_slot_unlock_costs")) {
-                nlohmann::json j = bundle["gem_slot_unlock_costs"];
+                const nlohmann::json& j = bundle["gem_slot_unlock_costs"];
                 for (auto& e : j) {
                     GemSlotUnlockCost cost;
                     cost.slot_index = e.value("slot_index", 0);
@@ -369,16 +413,113 @@ bool MetadataLoader::load(const std::string& base_path) {
     }
 }
 
+// 원본 데이터(JSON/바이너리 공통)에서 파생 데이터 구성: enum 변환, ID 인덱스, 가챠 alias 테이블
+void MetadataLoader::build_indexes() {
+    gem_types_by_id_.clear();
+    gem_grades_by_id_.clear();
+    gem_definitions_by_id_.clear();
+    gem_synthesis_rules_by_from_.clear();
+    gem_type_id_by_enum_.clear();
+    gem_definition_by_grade_type_.clear();
+    gem_type_stride_ = 0;
+
+    for (auto& gt : gem_types_) {
+        gt.type_enum = parse_gem_type(gt.type);
+        gem_types_by_id_.insert(gt.id, gt);
+    }
+    for (auto& gg : gem_grades_) {
+        gg.grade_enum = parse_gem_grade(gg.grade);
+        gem_grades_by_id_.insert(gg.id, gg);
+    }
+    for (auto& gd : gem_definitions_) {
+        if (const auto* grade = gem_grades_by_id_.find(gd.grade_id)) gd.grade_enum = grade->grade_enum;
+        if (const auto* type = gem_types_by_id_.find(gd.type_id)) gd.type_enum = type->type_enum;
+        gem_definitions_by_id_.insert(gd.gem_id, gd);
+    }
+    for (auto& rule : gem_synthesis_rules_) {
+        for (const auto& gg : gem_grades_) {
+            if (gg.grade == rule.from_grade) rule.from_grade_id = gg.id;
+            if (gg.grade == rule.to_grade) rule.to_grade_id = gg.id;
+        }
+        // 기존 선형 탐색과 같이 먼저 나온 규칙 우선
+        if (rule.from_grade_id && !gem_synthesis_rules_by_from_.find(*rule.from_grade_id)) {
+            gem_synthesis_rules_by_from_.insert(*rule.from_grade_id, rule);
+        }
+    }
+
+    // (grade, type) → gem_id 표, 가챠 alias 테이블
+    uint32_t max_grade_id = 0;
+    for (const auto& def : gem_definitions_) {
+        max_grade_id = std::max(max_grade_id, def.grade_id);
+        gem_type_stride_ = std::max(gem_type_stride_, def.type_id + 1);
+    }
+    if (!gem_definitions_.empty()) {
+        if (max_grade_id >= IdTable<GemDefinition>::kMaxId || gem_type_stride_ > IdTable<GemDefinition>::kMaxId) {
+            throw std::out_of_range("gem grade/type id too large");
+        }
+        gem_definition_by_grade_type_.assign(static_cast<std::size_t>(max_grade_id + 1) * gem_type_stride_, -1);
+    }
+    for (const auto& def : gem_definitions_) {
+        auto& slot = gem_definition_by_grade_type_[static_cast<std::size_t>(def.grade_id) * gem_type_stride_ + def.type_id];
+        if (slot < 0) slot = static_cast<int32_t>(def.gem_id);
+    }
+    for (const auto& gt : gem_types_) {
+        if (gt.type_enum == infinitepickaxe::GEM_TYPE_UNKNOWN) continue;
+        std::size_t e = static_cast<std::size_t>(gt.type_enum);
+        if (e >= gem_type_id_by_enum_.size()) gem_type_id_by_enum_.resize(e + 1, -1);
+        gem_type_id_by_enum_[e] = static_cast<int32_t>(gt.id);
+    }
+    gem_gacha_sampler_ = GemGachaSampler::build(gem_gacha_.grade_rates, gem_definitions_);
+}
+
+std::vector<std::string> MetadataLoader::validate() const {
+    std::vector<std::string> errors;
+    if (!pickaxe_level(0)) errors.push_back("pickaxe_levels: level 0 missing");
+    if (!mineral(1)) errors.push_back("minerals: mineral 1 missing");
+    if (missions_.empty()) errors.push_back("daily_missions: no missions");
+    for (const auto& m : missions_) {
+        if (m.mineral_id && !mineral(*m.mineral_id)) {
+            errors.push_back("daily_missions: mission " + std::to_string(m.id) + " references unknown mineral " +
+                             std::to_string(*m.mineral_id));
+        }
+    }
+    for (const auto& gt : gem_types_) {
+        if (gt.type_enum == infinitepickaxe::GEM_TYPE_UNKNOWN) {
+            errors.push_back("gem_types: unknown type '" + gt.type + "'");
+        }
+    }
+    for (const auto& gg : gem_grades_) {
+        if (gg.grade_enum == infinitepickaxe::GEM_GRADE_UNKNOWN) {
+            errors.push_back("gem_grades: unknown grade '" + gg.grade + "'");
+        }
+    }
+    for (const auto& def : gem_definitions_) {
+        if (!gem_grade(def.grade_id) || !gem_type(def.type_id)) {
+            errors.push_back("gem_definitions: gem " + std::to_string(def.gem_id) + " has unknown grade/type");
+        }
+    }
+    for (const auto& rule : gem_synthesis_rules_) {
+        if (!rule.from_grade_id || !rule.to_grade_id) {
+            errors.push_back("gem_synthesis_rules: unknown grade in " + rule.from_grade + " -> " + rule.to_grade);
+        }
+    }
+    uint64_t rate_total = 0;
+    for (const auto& rate : gem_gacha_.grade_rates) rate_total += rate.rate_percent;
+    if (!gem_gacha_.grade_rates.empty() && rate_total != 10000) {
+        errors.push_back("gem_gacha: grade_rates sum to " + std::to_string(rate_total) + " (expected 10000)");
+    }
+    if (!gem_definitions_.empty() && gem_gacha_sampler_.empty()) {
+        errors.push_back("gem_gacha: no drawable grade");
+    }
+    return errors;
+}
+
 const PickaxeLevel* MetadataLoader::pickaxe_level(uint32_t level) const {
-    auto it = pickaxe_levels_.find(level);
-    if (it == pickaxe_levels_.end()) return nullptr;
-    return &it->second;
+    return pickaxe_levels_.find(level);
 }
 
 const MineralMeta* MetadataLoader::mineral(uint32_t id) const {
-    auto it = minerals_.find(id);
-    if (it == minerals_.end()) return nullptr;
-    return &it->second;
+    return minerals_.find(id);
 }
 
 const AdTypeMeta* MetadataLoader::ad_meta(const std::string& id) const {
@@ -388,19 +529,79 @@ const AdTypeMeta* MetadataLoader::ad_meta(const std::string& id) const {
 }
 
 const GemTypeMeta* MetadataLoader::gem_type(uint32_t id) const {
-    auto it = gem_types_by_id_.find(id);
-    if (it == gem_types_by_id_.end()) return nullptr;
-    return &it->second;
+    return gem_types_by_id_.find(id);
 }
 
 const GemGradeMeta* MetadataLoader::gem_grade(uint32_t id) const {
-    auto it = gem_grades_by_id_.find(id);
-    if (it == gem_grades_by_id_.end()) return nullptr;
-    return &it->second;
+    return gem_grades_by_id_.find(id);
 }
 
 const GemDefinition* MetadataLoader::gem_definition(uint32_t gem_id) const {
-    auto it = gem_definitions_by_id_.find(gem_id);
-    if (it == gem_definitions_by_id_.end()) return nullptr;
-    return &it->second;
+    return gem_definitions_by_id_.find(gem_id);
+}
+
+const GemTypeMeta* MetadataLoader::gem_type_by_enum(infinitepickaxe::GemType type) const {
+    std::size_t e = static_cast<std::size_t>(type);
+    if (e >= gem_type_id_by_enum_.size() || gem_type_id_by_enum_[e] < 0) return nullptr;
+    return gem_types_by_id_.find(static_cast<uint32_t>(gem_type_id_by_enum_[e]));
+}
+
+const GemDefinition* MetadataLoader::gem_definition_for(uint32_t grade_id, uint32_t type_id) const {
+    if (type_id >= gem_type_stride_) return nullptr;
+    std::size_t idx = static_cast<std::size_t>(grade_id) * gem_type_stride_ + type_id;
+    if (idx >= gem_definition_by_grade_type_.size() || gem_definition_by_grade_type_[idx] < 0) return nullptr;
+    return gem_definitions_by_id_.find(static_cast<uint32_t>(gem_definition_by_grade_type_[idx]));
+}
+
+const GemSynthesisRule* MetadataLoader::gem_synthesis_rule(uint32_t from_grade_id) const {
+    return gem_synthesis_rules_by_from_.find(from_grade_id);
+}
+
+GemGachaSampler GemGachaSampler::build(const std::vector<GemGradeRate>& grade_rates,
+                                       const std::vector<GemDefinition>& definitions) {
+    GemGachaSampler sampler;
+    std::vector<uint64_t> weights;
+    for (const auto& rate : grade_rates) {
+        if (rate.rate_percent == 0) continue;
+        std::vector<uint32_t> ids;
+        for (const auto& def : definitions) {
+            if (def.grade_id == rate.grade_id) ids.push_back(def.gem_id);
+        }
+        if (ids.empty()) continue;
+        sampler.grade_ids.push_back(rate.grade_id);
+        sampler.gem_ids.push_back(std::move(ids));
+        weights.push_back(rate.rate_percent);
+        sampler.total_weight += rate.rate_percent;
+    }
+
+    const std::size_t n = weights.size();
+    if (n == 0) return sampler;
+
+    // 가중치 * n 을 total_weight 기준으로 small/large 분할 (정수 연산이라 분포가 정확히 보존됨)
+    const uint64_t total = sampler.total_weight;
+    std::vector<uint64_t> scaled(n);
+    std::vector<uint32_t> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * n;
+        (scaled[i] < total ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    sampler.accept.assign(n, sampler.total_weight);
+    sampler.alias.resize(n);
+    for (std::size_t i = 0; i < n; ++i) sampler.alias[i] = static_cast<uint32_t>(i);
+
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+        sampler.accept[s] = static_cast<uint32_t>(scaled[s]);
+        sampler.alias[s] = l;
+        scaled[l] -= (total - scaled[s]);
+        if (scaled[l] < total) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // 남은 슬롯은 항상 수락 (accept = total_weight)
+    return sampler;
 }
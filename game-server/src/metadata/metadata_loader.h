@@ -1,9 +1,50 @@
 #pragma once
+#include "game.pb.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <optional>
 
+// ID → 항목 직접 인덱싱 테이블 (메타데이터 ID가 작은 정수라는 전제)
+// 항목은 연속 배열에 두고 ID별 위치만 별도 배열로 관리한다. 빈 칸은 -1.
+template <typename T>
+class IdTable {
+public:
+    static constexpr uint32_t kMaxId = 1u << 20;
+
+    void clear() {
+        items_.clear();
+        index_.clear();
+    }
+
+    // 같은 ID가 다시 들어오면 덮어쓴다 (기존 map 동작과 동일)
+    void insert(uint32_t id, T value) {
+        if (id >= kMaxId) throw std::out_of_range("metadata id too large: " + std::to_string(id));
+        if (id >= index_.size()) index_.resize(id + 1, -1);
+        if (index_[id] >= 0) {
+            items_[index_[id]] = std::move(value);
+            return;
+        }
+        index_[id] = static_cast<int32_t>(items_.size());
+        items_.push_back(std::move(value));
+    }
+
+    const T* find(uint32_t id) const {
+        if (id >= index_.size() || index_[id] < 0) return nullptr;
+        return &items_[index_[id]];
+    }
+
+    // 삽입 순서대로의 항목 (직렬화용)
+    const std::vector<T>& items() const { return items_; }
+
+private:
+    std::vector<T> items_;
+    std::vector<int32_t> index_;
+};
+
 struct PickaxeLevel {
     uint32_t level;
     uint32_t tier;
@@ -84,12 +125,14 @@ struct GemTypeMeta {
     std::string display_name;
     std::string description;
     std::string stat_key;
+    infinitepickaxe::GemType type_enum{infinitepickaxe::GEM_TYPE_UNKNOWN}; // 로드 시 type 문자열에서 변환
 };
 
 struct GemGradeMeta {
     uint32_t id;
     std::string grade;       // COMMON, RARE, EPIC, HERO, LEGENDARY
     std::string display_name;
+    infinitepickaxe::GemGrade grade_enum{infinitepickaxe::GEM_GRADE_UNKNOWN}; // 로드 시 grade 문자열에서 변환
 };
 
 struct GemDefinition {
@@ -99,6 +142,9 @@ struct GemDefinition {
     std::string name;
     std::string icon;
     uint32_t stat_multiplier; // x100 basis
+    // grade_id/type_id를 로드 시 미리 변환 (응답 작성 시 문자열 비교 제거)
+    infinitepickaxe::GemGrade grade_enum{infinitepickaxe::GEM_GRADE_UNKNOWN};
+    infinitepickaxe::GemType type_enum{infinitepickaxe::GEM_TYPE_UNKNOWN};
 };
 
 struct GemGradeRate {
@@ -113,10 +159,46 @@ struct GemGachaMeta {
     std::vector<GemGradeRate> grade_rates;
 };
 
+// 가챠 추첨기 (Walker alias method, 정수 가중치 그대로 사용)
+// 메타데이터 로드 시 1회 구성하며, 추첨은 난수 3개로 O(1)이고 힙 할당이 없다.
+struct GemGachaSampler {
+    std::vector<uint32_t> grade_ids;                 // 슬롯 → grade_id
+    std::vector<uint32_t> accept;                    // 슬롯별 수락 임계값 (0..total_weight)
+    std::vector<uint32_t> alias;                     // 거절 시 대체 슬롯
+    std::vector<std::vector<uint32_t>> gem_ids;      // 슬롯 → 해당 등급 gem_id 목록
+    uint32_t total_weight{0};
+
+    bool empty() const { return grade_ids.empty(); }
+
+    // grade_rates 중 가중치 0이거나 보석 정의가 없는 등급은 제외하고 구성
+    static GemGachaSampler build(const std::vector<GemGradeRate>& grade_rates,
+                                 const std::vector<GemDefinition>& definitions);
+
+    template <typename Rng>
+    uint32_t sample_slot(Rng& rng) const {
+        std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(grade_ids.size()) - 1);
+        std::uniform_int_distribution<uint32_t> coin(0, total_weight - 1);
+        uint32_t slot = pick(rng);
+        return coin(rng) < accept[slot] ? slot : alias[slot];
+    }
+
+    template <typename Rng>
+    uint32_t sample_grade(Rng& rng) const { return grade_ids[sample_slot(rng)]; }
+
+    template <typename Rng>
+    uint32_t sample_gem(Rng& rng) const {
+        const auto& ids = gem_ids[sample_slot(rng)];
+        std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+        return ids[pick(rng)];
+    }
+};
+
 struct GemSynthesisRule {
     std::string from_grade;
     std::string to_grade;
     uint32_t success_rate_percent; // basis 10000
+    std::optional<uint32_t> from_grade_id; // 로드 시 grade 문자열에서 변환
+    std::optional<uint32_t> to_grade_id;
 };
 
 struct GemConversionCost {
@@ -144,7 +226,13 @@ struct GemSlotUnlockCost {
 
 class MetadataLoader {
 public:
-    bool load(const std::string& base_path);
+    // meta_bundle.bin(컴파일된 바이너리)이 유효하면 mmap으로 읽고, 아니면 meta_bundle.json 파싱
+    // bin_path가 비어 있으면 base_path/meta_bundle.bin
+    bool load(const std::string& base_path, const std::string& bin_path = "");
+    // 바이너리 번들 저장 (meta-bundle-compile 도구용). source_json_path는 stale 검출용 해시 대상
+    bool save_binary(const std::string& bin_path, const std::string& source_json_path, std::string& error) const;
+    // 로드된 데이터의 참조 무결성 검사 (핫 리로드 시 교체 전에 사용). 비어 있으면 정상
+    std::vector<std::string> validate() const;
 
     const PickaxeLevel* pickaxe_level(uint32_t level) const;
     const MineralMeta* mineral(uint32_t id) const;
@@ -171,10 +259,23 @@ public:
     const GemTypeMeta* gem_type(uint32_t id) const;
     const GemGradeMeta* gem_grade(uint32_t id) const;
     const GemDefinition* gem_definition(uint32_t gem_id) const;
+    const GemTypeMeta* gem_type_by_enum(infinitepickaxe::GemType type) const;
+    // (grade_id, type_id) 조합의 보석 정의 (합성/변환 결과 조회용)
+    const GemDefinition* gem_definition_for(uint32_t grade_id, uint32_t type_id) const;
+    const GemSynthesisRule* gem_synthesis_rule(uint32_t from_grade_id) const;
+
+    // 가챠 추첨기 (로드 시 미리 계산, 등급별 gem_id 목록 포함)
+    const GemGachaSampler& gem_gacha_sampler() const { return gem_gacha_sampler_; }
 
 private:
-    std::unordered_map<uint32_t, PickaxeLevel> pickaxe_levels_;
-    std::unordered_map<uint32_t, MineralMeta> minerals_;
+    void reset();
+    bool load_json(const std::string& json_path);
+    // metadata_binary.cpp. 사용하지 않은 경우(파일 없음 포함) false, 사유는 error (파일 없음이면 빈 문자열)
+    bool load_binary(const std::string& bin_path, const std::string& source_json_path, std::string& error);
+    void build_indexes();
+
+    IdTable<PickaxeLevel> pickaxe_levels_;
+    IdTable<MineralMeta> minerals_;
     std::vector<MissionMeta> missions_;
     DailyMissionConfig daily_missions_config_;
     std::vector<MilestoneBonus> milestone_bonuses_;
@@ -195,7 +296,12 @@ private:
     GemInventoryConfig gem_inventory_config_;
     std::vector<GemSlotUnlockCost> gem_slot_unlock_costs_;
 
-    std::unordered_map<uint32_t, GemTypeMeta> gem_types_by_id_;
-    std::unordered_map<uint32_t, GemGradeMeta> gem_grades_by_id_;
-    std::unordered_map<uint32_t, GemDefinition> gem_definitions_by_id_;
+    IdTable<GemTypeMeta> gem_types_by_id_;
+    IdTable<GemGradeMeta> gem_grades_by_id_;
+    IdTable<GemDefinition> gem_definitions_by_id_;
+    IdTable<GemSynthesisRule> gem_synthesis_rules_by_from_;
+    std::vector<int32_t> gem_type_id_by_enum_;          // GemType 값 → type_id (-1 = 없음)
+    std::vector<int32_t> gem_definition_by_grade_type_; // grade_id * type_stride + type_id → gem_id
+    uint32_t gem_type_stride_{0};
+    GemGachaSampler gem_gacha_sampler_;
 };
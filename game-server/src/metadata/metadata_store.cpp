@@ -0,0 +1,109 @@
+#include "metadata_store.h"
+#include <spdlog/spdlog.h>
+#include <system_error>
+
+MetadataStore::MetadataStore(std::string base_path, std::string bin_path)
+    : base_path_(std::move(base_path)),
+      bin_path_(bin_path.empty() ? base_path_ + "/meta_bundle.bin" : std::move(bin_path)) {}
+
+MetadataStore::~MetadataStore() {
+    stop_watch();
+}
+
+// meta_bundle.json / meta_bundle.bin 중 최근 수정 시각
+std::filesystem::file_time_type MetadataStore::bundle_mtime() const {
+    std::filesystem::file_time_type latest{};
+    for (const std::string& path : {base_path_ + "/meta_bundle.json", bin_path_}) {
+        std::error_code ec;
+        auto t = std::filesystem::last_write_time(path, ec);
+        if (!ec && t > latest) latest = t;
+    }
+    return latest;
+}
+
+bool MetadataStore::reload() {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    auto mtime = bundle_mtime();
+
+    auto next = std::make_shared<MetadataLoader>();
+    if (!next->load(base_path_, bin_path_)) {
+        spdlog::error("Metadata reload failed: cannot load bundle from {} (keeping v{})",
+                      base_path_, version());
+        loaded_mtime_ = mtime; // 같은 파일로 반복 시도하지 않음
+        return false;
+    }
+    auto errors = next->validate();
+    if (!errors.empty()) {
+        for (const auto& e : errors) {
+            spdlog::error("Metadata validation: {}", e);
+        }
+        spdlog::error("Metadata reload rejected ({} errors, keeping v{})", errors.size(), version());
+        loaded_mtime_ = mtime;
+        return false;
+    }
+
+    std::atomic_store_explicit(&current_, Snapshot(std::move(next)), std::memory_order_release);
+    loaded_mtime_ = mtime;
+    uint64_t v = version_.fetch_add(1, std::memory_order_relaxed) + 1;
+    spdlog::info("Metadata v{} loaded from {}", v, base_path_);
+    return true;
+}
+
+void MetadataStore::start_watch(std::chrono::seconds interval) {
+    if (watch_thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watch_stop_ = false;
+    }
+    watch_thread_ = std::thread([this, interval]() { watch_loop(interval); });
+}
+
+void MetadataStore::stop_watch() {
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watch_stop_ = true;
+    }
+    watch_cv_.notify_all();
+    if (watch_thread_.joinable()) watch_thread_.join();
+}
+
+void MetadataStore::request_reload() {
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        reload_requested_ = true;
+    }
+    watch_cv_.notify_all();
+}
+
+void MetadataStore::watch_loop(std::chrono::seconds interval) {
+    auto wake = [this]() { return watch_stop_ || reload_requested_; };
+    std::unique_lock<std::mutex> lock(watch_mutex_);
+    while (true) {
+        if (interval.count() > 0) {
+            watch_cv_.wait_for(lock, interval, wake);
+        } else {
+            watch_cv_.wait(lock, wake);
+        }
+        if (watch_stop_) break;
+        bool requested = reload_requested_;
+        reload_requested_ = false;
+        lock.unlock();
+
+        if (requested) {
+            spdlog::info("Metadata reload requested");
+            reload();
+        } else {
+            auto mtime = bundle_mtime();
+            bool changed;
+            {
+                std::lock_guard<std::mutex> reload_lock(reload_mutex_);
+                changed = mtime != std::filesystem::file_time_type{} && mtime != loaded_mtime_;
+            }
+            if (changed) {
+                spdlog::info("Metadata bundle changed, reloading metadata");
+                reload();
+            }
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "metadata_loader.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 핫 리로드 가능한 메타데이터 저장소
+// - 현재 스냅샷은 불변 MetadataLoader이며 shared_ptr 원자적 교체로 갱신한다.
+// - 핸들러는 시작 시 current()로 스냅샷을 고정하고 끝날 때까지 같은 버전을 쓴다.
+//   교체 후 이전 스냅샷은 마지막 참조가 사라질 때 해제된다.
+// - reload()는 새 번들을 별도 객체에 로드 + 검증한 뒤에만 교체하므로
+//   잘못된 번들은 현재 버전에 영향을 주지 않는다.
+class MetadataStore {
+public:
+    using Snapshot = std::shared_ptr<const MetadataLoader>;
+
+    // bin_path가 비어 있으면 base_path/meta_bundle.bin (읽기 전용 마운트면 밖에 둘 것)
+    explicit MetadataStore(std::string base_path, std::string bin_path = "");
+    ~MetadataStore();
+
+    MetadataStore(const MetadataStore&) = delete;
+    MetadataStore& operator=(const MetadataStore&) = delete;
+
+    Snapshot current() const { return std::atomic_load_explicit(&current_, std::memory_order_acquire); }
+    uint64_t version() const { return version_.load(std::memory_order_relaxed); }
+    const std::string& base_path() const { return base_path_; }
+
+    // 번들 로드 + 검증 후 교체. 실패 시 기존 스냅샷 유지 (동시 호출은 직렬화)
+    bool reload();
+
+    // 백그라운드 리로드 스레드 시작. interval > 0이면 번들(json/bin) 수정 시각을
+    // 주기적으로 확인해 변경 시 reload, 0이면 request_reload() 요청만 처리
+    void start_watch(std::chrono::seconds interval);
+    void stop_watch();
+    // 관리자 트리거 (SIGHUP 등): 호출 스레드를 막지 않고 리로드 스레드에 위임
+    void request_reload();
+
+private:
+    void watch_loop(std::chrono::seconds interval);
+    std::filesystem::file_time_type bundle_mtime() const;
+
+    std::string base_path_;
+    std::string bin_path_;
+    Snapshot current_;
+    std::atomic<uint64_t> version_{0};
+    std::mutex reload_mutex_;
+    std::filesystem::file_time_type loaded_mtime_{};
+
+    std::thread watch_thread_;
+    std::mutex watch_mutex_;
+    std::condition_variable watch_cv_;
+    bool watch_stop_{false};
+    bool reload_requested_{false};
+};
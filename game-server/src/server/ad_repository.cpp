@@ -1,4 +1,5 @@
 #include "ad_repository.h"
+#include "game_clock.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <ctime>
@@ -11,10 +12,13 @@ AdCounter AdRepository::get_or_create_ad_counter(const std::string& user_id, con
     counter.ad_type = ad_type;
 
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
-        auto kst_row = tx.exec1("SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d");
+        // 시뮬레이션 모드에서는 가상 시계의 KST 날짜 기준으로 리셋
+        auto kst_row = tx.exec_params1(
+            "SELECT COALESCE($1::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date)::text AS d",
+            game_clock::kst_date_override());
         auto kst_date_str = kst_row["d"].as<std::string>();
         std::tm tm_kst = {};
         std::istringstream ss_kst(kst_date_str);
@@ -62,7 +66,7 @@ AdCounter AdRepository::get_or_create_ad_counter(const std::string& user_id, con
         spdlog::error("get_or_create_ad_counter failed: user={} ad_type={} error={}",
                       user_id, ad_type, ex.what());
         counter.ad_count = 0;
-        counter.reset_date = std::chrono::system_clock::now();
+        counter.reset_date = game_clock::now();
     }
 
     return counter;
@@ -70,18 +74,18 @@ AdCounter AdRepository::get_or_create_ad_counter(const std::string& user_id, con
 
 bool AdRepository::increment_ad_counter(const std::string& user_id, const std::string& ad_type) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
-            "WITH kst_today AS (SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d) "
+            "WITH kst_today AS (SELECT COALESCE($3::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) AS d) "
             "INSERT INTO game_schema.user_ad_counters (user_id, ad_type, ad_count, reset_date) "
             "SELECT $1, $2, 1, d FROM kst_today "
             "ON CONFLICT (user_id, ad_type) DO UPDATE "
             "SET ad_count = CASE WHEN user_ad_counters.reset_date < (SELECT d FROM kst_today) THEN 1 "
             "                    ELSE user_ad_counters.ad_count + 1 END, "
             "    reset_date = (SELECT d FROM kst_today)",
-            user_id, ad_type
+            user_id, ad_type, game_clock::kst_date_override()
         );
 
         tx.commit();
@@ -98,15 +102,15 @@ std::vector<AdCounter> AdRepository::get_all_ad_counters(const std::string& user
     std::vector<AdCounter> counters;
 
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
-            "WITH kst_today AS (SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d) "
+            "WITH kst_today AS (SELECT COALESCE($2::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) AS d) "
             "UPDATE game_schema.user_ad_counters "
             "SET ad_count = 0, reset_date = (SELECT d FROM kst_today) "
             "WHERE user_id = $1 AND reset_date < (SELECT d FROM kst_today)",
-            user_id
+            user_id, game_clock::kst_date_override()
         );
 
         auto res = tx.exec_params(
@@ -14,21 +14,22 @@ uint32_t reward_for_ad_view(const std::vector<uint32_t>& rewards_by_view, uint32
 
 std::vector<AdCounter> AdService::get_ad_counters(const std::string& user_id) {
     std::vector<AdCounter> counters;
-    const auto& metas = meta_.ad_types();
+    auto meta = meta_.current();
+    const auto& metas = meta->ad_types();
     if (metas.empty()) {
         return repo_.get_all_ad_counters(user_id);
     }
     counters.reserve(metas.size());
 
     std::unordered_set<std::string> seen;
-    for (const auto& meta : metas) {
-        if (meta.id.empty()) {
+    for (const auto& ad : metas) {
+        if (ad.id.empty()) {
             continue;
         }
-        if (!seen.insert(meta.id).second) {
+        if (!seen.insert(ad.id).second) {
             continue;
         }
-        counters.push_back(repo_.get_or_create_ad_counter(user_id, meta.id));
+        counters.push_back(repo_.get_or_create_ad_counter(user_id, ad.id));
     }
     return counters;
 }
@@ -58,7 +59,8 @@ infinitepickaxe::AdWatchResult AdService::handle_ad_watch(const std::string& use
     result.set_ad_type(ad_type);
     result.set_error_code("");
 
-    const auto* ad_meta = meta_.ad_meta(ad_type);
+    auto meta = meta_.current();
+    const auto* ad_meta = meta->ad_meta(ad_type);
     if (!ad_meta) {
         result.set_error_code("INVALID_AD_TYPE");
     } else {
@@ -1,14 +1,14 @@
 #pragma once
 #include "ad_repository.h"
 #include "game_repository.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include "game.pb.h"
 #include <string>
 #include <vector>
 
 class AdService {
 public:
-    AdService(AdRepository& repo, GameRepository& game_repo, const MetadataLoader& meta)
+    AdService(AdRepository& repo, GameRepository& game_repo, const MetadataStore& meta)
         : repo_(repo), game_repo_(game_repo), meta_(meta) {}
 
     std::vector<AdCounter> get_ad_counters(const std::string& user_id);
@@ -19,5 +19,5 @@ public:
 private:
     AdRepository& repo_;
     GameRepository& game_repo_;
-    const MetadataLoader& meta_;
+    const MetadataStore& meta_;
 };
@@ -0,0 +1,373 @@
+#include "async_pg_pool.h"
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+#include <cstdlib>
+
+namespace {
+constexpr auto kReconnectInterval = std::chrono::seconds(1);
+}
+
+// ========== AsyncPgResult ==========
+
+AsyncPgResult::AsyncPgResult(PGresult* res)
+    : res_(res, [](PGresult* r) { if (r) PQclear(r); }) {
+    if (!res) {
+        error_ = "null result";
+        return;
+    }
+    auto status = PQresultStatus(res);
+    ok_ = (status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK);
+    if (!ok_) {
+        const char* msg = PQresultErrorMessage(res);
+        error_ = (msg && *msg) ? msg : PQresStatus(status);
+    }
+}
+
+AsyncPgResult AsyncPgResult::failure(std::string message) {
+    AsyncPgResult r;
+    r.error_ = std::move(message);
+    return r;
+}
+
+int AsyncPgResult::rows() const {
+    return res_ ? PQntuples(res_.get()) : 0;
+}
+
+uint64_t AsyncPgResult::affected_rows() const {
+    if (!res_) return 0;
+    const char* n = PQcmdTuples(res_.get());
+    return (n && *n) ? std::strtoull(n, nullptr, 10) : 0;
+}
+
+bool AsyncPgResult::is_null(int row, int col) const {
+    return !res_ || PQgetisnull(res_.get(), row, col);
+}
+
+std::string AsyncPgResult::text(int row, int col) const {
+    if (is_null(row, col)) return {};
+    return std::string(PQgetvalue(res_.get(), row, col),
+                       static_cast<std::size_t>(PQgetlength(res_.get(), row, col)));
+}
+
+uint64_t AsyncPgResult::as_u64(int row, int col) const {
+    if (is_null(row, col)) return 0;
+    return std::strtoull(PQgetvalue(res_.get(), row, col), nullptr, 10);
+}
+
+uint32_t AsyncPgResult::as_u32(int row, int col) const {
+    return static_cast<uint32_t>(as_u64(row, col));
+}
+
+bool AsyncPgResult::as_bool(int row, int col) const {
+    if (is_null(row, col)) return false;
+    const char* v = PQgetvalue(res_.get(), row, col);
+    return v[0] == 't' || v[0] == 'T' || v[0] == '1';
+}
+
+// ========== AsyncPgConnection ==========
+
+AsyncPgConnection::AsyncPgConnection(boost::asio::io_context& io, std::string conn_str)
+    : strand_(boost::asio::make_strand(io)),
+      socket_(io),
+      conn_str_(std::move(conn_str)) {}
+
+AsyncPgConnection::~AsyncPgConnection() {
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+    if (conn_) {
+        PQfinish(conn_);
+    }
+}
+
+void AsyncPgConnection::reset_connection() {
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+    if (conn_) {
+        PQfinish(conn_);
+        conn_ = nullptr;
+    }
+    reading_ = false;
+    writing_ = false;
+    ++generation_;
+}
+
+bool AsyncPgConnection::connect() {
+    reset_connection();
+    conn_ = PQconnectdb(conn_str_.c_str());
+    if (!conn_ || PQstatus(conn_) != CONNECTION_OK) {
+        spdlog::error("Async DB connect failed: {}", conn_ ? PQerrorMessage(conn_) : "out of memory");
+        healthy_ = false;
+        return false;
+    }
+    return finish_connect();
+}
+
+bool AsyncPgConnection::finish_connect() {
+    if (PQsetnonblocking(conn_, 1) != 0 || PQenterPipelineMode(conn_) != 1) {
+        spdlog::error("Async DB pipeline mode unavailable: {}", PQerrorMessage(conn_));
+        healthy_ = false;
+        return false;
+    }
+
+    // libpq가 소켓을 소유하므로 asio에는 복제한 fd를 넘긴다.
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+    int fd = ::dup(PQsocket(conn_));
+    if (fd < 0) {
+        spdlog::error("Async DB socket dup failed");
+        healthy_ = false;
+        return false;
+    }
+    socket_.assign(fd);
+    healthy_ = true;
+    return true;
+}
+
+// strand 위에서 PQconnectStart/PQconnectPoll로 재연결 (io 스레드를 막지 않음)
+// 호스트 이름 해석은 libpq 안에서 블로킹될 수 있으므로 운영에서는 IP(hostaddr) 사용 권장
+void AsyncPgConnection::start_reconnect() {
+    if (connecting_) return;
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_reconnect_at_) return;
+    next_reconnect_at_ = now + kReconnectInterval;
+
+    reset_connection();
+    conn_ = PQconnectStart(conn_str_.c_str());
+    if (!conn_ || PQstatus(conn_) == CONNECTION_BAD) {
+        spdlog::error("Async DB reconnect failed: {}", conn_ ? PQerrorMessage(conn_) : "out of memory");
+        return;
+    }
+    connecting_ = true;
+    poll_connect(PGRES_POLLING_WRITING);
+}
+
+void AsyncPgConnection::request_reconnect() {
+    if (healthy_ || reconnect_posted_.exchange(true)) return;
+    auto self = shared_from_this();
+    boost::asio::post(strand_, [this, self]() {
+        reconnect_posted_ = false;
+        if (!healthy_) start_reconnect();
+    });
+}
+
+void AsyncPgConnection::poll_connect(PostgresPollingStatusType status) {
+    if (status == PGRES_POLLING_OK) {
+        connecting_ = false;
+        if (finish_connect()) spdlog::info("Async DB connection restored");
+        return;
+    }
+    if (status == PGRES_POLLING_FAILED) {
+        connecting_ = false;
+        spdlog::error("Async DB reconnect failed: {}", PQerrorMessage(conn_));
+        return;
+    }
+
+    // 연결 단계마다 소켓이 바뀔 수 있어 매번 다시 복제한다
+    boost::system::error_code ec;
+    socket_.close(ec);
+    int fd = ::dup(PQsocket(conn_));
+    if (fd >= 0) {
+        socket_.assign(fd, ec);
+        if (ec) ::close(fd);
+    }
+    if (fd < 0 || ec) {
+        connecting_ = false;
+        spdlog::error("Async DB socket dup failed");
+        return;
+    }
+    const auto wait = status == PGRES_POLLING_READING
+                          ? boost::asio::posix::stream_descriptor::wait_read
+                          : boost::asio::posix::stream_descriptor::wait_write;
+    auto self = shared_from_this();
+    socket_.async_wait(wait, boost::asio::bind_executor(strand_, [this, self, gen = generation_](boost::system::error_code ec) {
+        if (gen != generation_) return;
+        if (ec) {
+            connecting_ = false;
+            if (ec != boost::asio::error::operation_aborted) {
+                spdlog::error("Async DB reconnect wait failed: {}", ec.message());
+            }
+            return;
+        }
+        poll_connect(PQconnectPoll(conn_));
+    }));
+}
+
+void AsyncPgConnection::exec_params(std::string sql, AsyncPgParams params, AsyncPgCallback cb) {
+    ++in_flight_;
+    Pending pending;
+    pending.sql = std::move(sql);
+    pending.params = std::move(params);
+    pending.cb = std::move(cb);
+
+    auto self = shared_from_this();
+    boost::asio::post(strand_, [this, self, p = std::move(pending)]() mutable {
+        if (!healthy_) {
+            // 끊긴 동안의 요청은 바로 실패시키고 재연결은 비동기로 진행
+            start_reconnect();
+            --in_flight_;
+            p.cb(AsyncPgResult::failure("connection unavailable"));
+            return;
+        }
+        send_pending(std::move(p));
+    });
+}
+
+void AsyncPgConnection::send_pending(Pending pending) {
+    std::vector<const char*> values;
+    values.reserve(pending.params.size());
+    for (const auto& v : pending.params) {
+        values.push_back(v.has_value() ? v->c_str() : nullptr);
+    }
+
+    if (PQsendQueryParams(conn_, pending.sql.c_str(), static_cast<int>(values.size()),
+                          nullptr, values.data(), nullptr, nullptr, 0) != 1 ||
+        PQpipelineSync(conn_) != 1) {
+        std::string message = PQerrorMessage(conn_);
+        --in_flight_;
+        pending.cb(AsyncPgResult::failure(message));
+        fail_all(message);
+        return;
+    }
+
+    in_pipeline_.push_back(std::move(pending));
+    flush_output();
+    wait_readable();
+}
+
+void AsyncPgConnection::flush_output() {
+    if (writing_ || !conn_) return;
+    int rc = PQflush(conn_);
+    if (rc < 0) {
+        fail_all(PQerrorMessage(conn_));
+        return;
+    }
+    if (rc == 0) return;
+
+    // 송신 버퍼가 가득 찬 경우: 쓰기 가능해지면 다시 flush
+    writing_ = true;
+    auto self = shared_from_this();
+    socket_.async_wait(boost::asio::posix::stream_descriptor::wait_write,
+                       boost::asio::bind_executor(strand_, [this, self, gen = generation_](boost::system::error_code ec) {
+                           if (gen != generation_) return; // 재연결 이전 대기
+                           writing_ = false;
+                           if (ec) {
+                               if (ec != boost::asio::error::operation_aborted) fail_all(ec.message());
+                               return;
+                           }
+                           flush_output();
+                       }));
+}
+
+void AsyncPgConnection::wait_readable() {
+    if (reading_ || in_pipeline_.empty()) return;
+    reading_ = true;
+    auto self = shared_from_this();
+    socket_.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+                       boost::asio::bind_executor(strand_, [this, self, gen = generation_](boost::system::error_code ec) {
+                           if (gen != generation_) return; // 재연결 이전 대기
+                           reading_ = false;
+                           if (ec) {
+                               if (ec != boost::asio::error::operation_aborted) fail_all(ec.message());
+                               return;
+                           }
+                           on_readable();
+                       }));
+}
+
+void AsyncPgConnection::on_readable() {
+    if (PQconsumeInput(conn_) != 1) {
+        fail_all(PQerrorMessage(conn_));
+        return;
+    }
+
+    // 파이프라인 결과 순서: [쿼리 결과..., NULL, PIPELINE_SYNC] x 쿼리 수
+    int consecutive_nulls = 0;
+    while (!in_pipeline_.empty() && !PQisBusy(conn_)) {
+        PGresult* res = PQgetResult(conn_);
+        if (!res) {
+            if (++consecutive_nulls > 1) break;
+            continue;
+        }
+        consecutive_nulls = 0;
+
+        auto& front = in_pipeline_.front();
+        if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+            PQclear(res);
+            Pending done = std::move(front);
+            in_pipeline_.pop_front();
+            --in_flight_;
+            if (!done.has_result) {
+                done.result = AsyncPgResult::failure("no result");
+            }
+            done.cb(std::move(done.result));
+            continue;
+        }
+        if (!front.has_result) {
+            front.result = AsyncPgResult(res);
+            front.has_result = true;
+        } else {
+            PQclear(res);
+        }
+    }
+
+    if (PQstatus(conn_) != CONNECTION_OK) {
+        fail_all(PQerrorMessage(conn_));
+        return;
+    }
+    flush_output();
+    wait_readable();
+}
+
+void AsyncPgConnection::fail_all(const std::string& message) {
+    spdlog::error("Async DB connection failed ({} in flight): {}", in_pipeline_.size(), message);
+    healthy_ = false;
+    boost::system::error_code ignored;
+    socket_.cancel(ignored);
+    while (!in_pipeline_.empty()) {
+        Pending p = std::move(in_pipeline_.front());
+        in_pipeline_.pop_front();
+        --in_flight_;
+        p.cb(AsyncPgResult::failure(message));
+    }
+    start_reconnect();
+}
+
+// ========== AsyncPgPool ==========
+
+AsyncPgPool::AsyncPgPool(boost::asio::io_context& io, std::string conn_str, std::size_t size)
+    : io_(io), conn_str_(std::move(conn_str)) {
+    if (size == 0) size = 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        conns_.push_back(std::make_shared<AsyncPgConnection>(io_, conn_str_));
+    }
+}
+
+bool AsyncPgPool::start() {
+    std::size_t connected = 0;
+    for (auto& conn : conns_) {
+        if (conn->connect()) ++connected;
+    }
+    spdlog::info("Async DB pool started: {}/{} pipeline connections", connected, conns_.size());
+    return connected > 0;
+}
+
+std::shared_ptr<AsyncPgConnection> AsyncPgPool::pick() {
+    // 라운드로빈 시작점에서 가장 in-flight가 적은 정상 커넥션 선택
+    std::size_t start = next_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<AsyncPgConnection> best;
+    for (std::size_t i = 0; i < conns_.size(); ++i) {
+        auto& c = conns_[(start + i) % conns_.size()];
+        if (!c->is_healthy()) {
+            // 다른 커넥션이 정상이어도 끊긴 커넥션은 계속 재연결 시도 (간격은 start_reconnect가 제한)
+            c->request_reconnect();
+            continue;
+        }
+        if (!best || c->in_flight() < best->in_flight()) best = c;
+    }
+    // 정상 커넥션이 없으면 strand 위에서 재연결을 시도하도록 그대로 넘긴다.
+    return best ? best : conns_[start % conns_.size()];
+}
+
+void AsyncPgPool::exec_params(std::string sql, AsyncPgParams params, AsyncPgCallback cb) {
+    pick()->exec_params(std::move(sql), std::move(params), std::move(cb));
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <libpq-fe.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// libpq 결과 래퍼 (PGresult 소유권 관리 + 타입 변환 헬퍼)
+class AsyncPgResult {
+public:
+    AsyncPgResult() = default;
+    explicit AsyncPgResult(PGresult* res);
+    static AsyncPgResult failure(std::string message);
+
+    bool ok() const { return ok_; }
+    const std::string& error() const { return error_; }
+
+    int rows() const;
+    bool empty() const { return rows() == 0; }
+    uint64_t affected_rows() const;
+    bool is_null(int row, int col) const;
+    std::string text(int row, int col) const;
+    uint64_t as_u64(int row, int col) const;
+    uint32_t as_u32(int row, int col) const;
+    bool as_bool(int row, int col) const;
+
+private:
+    std::shared_ptr<PGresult> res_;
+    bool ok_{false};
+    std::string error_;
+};
+
+using AsyncPgParams = std::vector<std::optional<std::string>>;
+using AsyncPgCallback = std::function<void(AsyncPgResult)>;
+
+// 파이프라인 모드 단일 커넥션: 하나의 소켓에 여러 쿼리를 동시에 흘려보낸다.
+// 각 쿼리는 개별 Sync로 끝나므로 독립된 암묵적 트랜잭션으로 실행된다.
+// 콜백은 커넥션 strand 위에서 호출되므로 세션 상태 접근 시 호출자가 다시 post 해야 한다.
+class AsyncPgConnection : public std::enable_shared_from_this<AsyncPgConnection> {
+public:
+    AsyncPgConnection(boost::asio::io_context& io, std::string conn_str);
+    ~AsyncPgConnection();
+
+    // 블로킹 연결 (io 스레드가 돌기 전 시작 시에만 사용)
+    bool connect();
+    bool is_healthy() const { return healthy_.load(std::memory_order_relaxed); }
+    std::size_t in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+    void exec_params(std::string sql, AsyncPgParams params, AsyncPgCallback cb);
+    // 끊긴 커넥션의 비동기 재연결을 strand에 요청 (대기 중인 요청이 있으면 무시)
+    void request_reconnect();
+
+private:
+    struct Pending {
+        std::string sql;
+        AsyncPgParams params;
+        AsyncPgCallback cb;
+        AsyncPgResult result;
+        bool has_result{false};
+    };
+
+    void reset_connection();
+    bool finish_connect();
+    void start_reconnect();
+    void poll_connect(PostgresPollingStatusType status);
+    void send_pending(Pending pending);
+    void flush_output();
+    void wait_readable();
+    void on_readable();
+    void fail_all(const std::string& message);
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    boost::asio::posix::stream_descriptor socket_;
+    std::string conn_str_;
+    PGconn* conn_{nullptr};
+    std::deque<Pending> in_pipeline_;
+    bool reading_{false};
+    bool writing_{false};
+    bool connecting_{false};
+    std::chrono::steady_clock::time_point next_reconnect_at_{};
+    uint64_t generation_{0};
+    std::atomic<bool> healthy_{false};
+    std::atomic<bool> reconnect_posted_{false};
+    std::atomic<std::size_t> in_flight_{0};
+};
+
+// 파이프라인 커넥션 묶음. 가장 한가한 커넥션으로 쿼리를 분배하고 끊긴 커넥션은 재연결한다.
+// 블로킹 ConnectionPool과 달리 풀 크기가 동시 처리 한도가 되지 않는다.
+class AsyncPgPool {
+public:
+    AsyncPgPool(boost::asio::io_context& io, std::string conn_str, std::size_t size);
+
+    bool start();
+
+    void exec_params(std::string sql, AsyncPgParams params, AsyncPgCallback cb);
+
+    template <typename... Args>
+    void exec(std::string sql, AsyncPgCallback cb, const Args&... args) {
+        AsyncPgParams params;
+        params.reserve(sizeof...(Args));
+        (params.push_back(to_param(args)), ...);
+        exec_params(std::move(sql), std::move(params), std::move(cb));
+    }
+
+private:
+    static std::optional<std::string> to_param(const std::string& v) { return v; }
+    static std::optional<std::string> to_param(const char* v) { return std::string(v); }
+    static std::optional<std::string> to_param(bool v) { return std::string(v ? "t" : "f"); }
+    template <typename T>
+    static std::optional<std::string> to_param(const std::optional<T>& v) {
+        if (!v.has_value()) return std::nullopt;
+        return to_param(v.value());
+    }
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+    static std::optional<std::string> to_param(T v) { return std::to_string(v); }
+
+    std::shared_ptr<AsyncPgConnection> pick();
+
+    boost::asio::io_context& io_;
+    std::string conn_str_;
+    std::vector<std::shared_ptr<AsyncPgConnection>> conns_;
+    std::atomic<std::size_t> next_{0};
+};
@@ -1,48 +1,469 @@
 #include "connection_pool.h"
+#include "request_trace.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
 
-ConnectionPool::ConnectionPool(const std::string& conn_str, std::size_t initial_size, std::size_t max_size)
-    : conn_str_(conn_str), max_size_(max_size) {
-    if (initial_size > max_size_) initial_size = max_size_;
-    for (std::size_t i = 0; i < initial_size; ++i) {
+namespace {
+// 이 시간 이상 유휴 상태였던 커넥션은 체크아웃 시 SELECT 1로 확인
+constexpr auto kValidateIdleAfter = std::chrono::seconds(30);
+// 유지보수 주기 (보충/정리)
+constexpr auto kMaintenanceInterval = std::chrono::seconds(5);
+
+// 스레드별 샤드 번호 (스레드 생성 순서대로 부여)
+std::size_t thread_shard_seed() {
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t seed = next.fetch_add(1, std::memory_order_relaxed);
+    return seed;
+}
+}
+
+// ========== IndexStack ==========
+
+void ConnectionPool::IndexStack::push(Slot* slots, uint32_t idx) {
+    uint64_t old_head = head_.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+        slots[idx].next.store(static_cast<uint32_t>(old_head), std::memory_order_relaxed);
+        new_head = (((old_head >> 32) + 1) << 32) | idx;
+    } while (!head_.compare_exchange_weak(old_head, new_head, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed));
+}
+
+uint32_t ConnectionPool::IndexStack::pop(Slot* slots) {
+    uint64_t old_head = head_.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t idx = static_cast<uint32_t>(old_head);
+        if (idx == kNil) return kNil;
+        uint32_t next = slots[idx].next.load(std::memory_order_relaxed);
+        uint64_t new_head = (((old_head >> 32) + 1) << 32) | next;
+        if (head_.compare_exchange_weak(old_head, new_head, std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            return idx;
+        }
+    }
+}
+
+// ========== ConnectionPool ==========
+
+ConnectionPool::ConnectionPool(const std::string& conn_str, std::size_t initial_size, std::size_t max_size,
+                               std::chrono::milliseconds acquire_timeout, std::chrono::seconds idle_timeout)
+    : conn_str_(conn_str),
+      initial_size_(initial_size),
+      max_size_(max_size == 0 ? 1 : max_size),
+      acquire_timeout_(acquire_timeout),
+      idle_timeout_(idle_timeout),
+      slots_(std::make_unique<Slot[]>(max_size_)),
+      coarse_now_(Clock::now().time_since_epoch().count()) {
+    if (initial_size_ > max_size_) initial_size_ = max_size_;
+    for (std::size_t i = max_size_; i > 0; --i) {
+        free_.push(slots_.get(), static_cast<uint32_t>(i - 1));
+    }
+    for (std::size_t i = 0; i < initial_size_; ++i) {
+        uint32_t idx = free_.pop(slots_.get());
         try {
-            auto conn = std::make_unique<pqxx::connection>(conn_str_);
-            idle_.push_back(std::move(conn));
+            slots_[idx].conn = std::make_unique<pqxx::connection>(conn_str_);
+            slots_[idx].since = Clock::now();
+            idle_.push(slots_.get(), idx);
             ++total_;
+            ++created_;
         } catch (const std::exception& ex) {
             spdlog::warn("DB pool preconnect failed: {}", ex.what());
+            free_.push(slots_.get(), idx);
+            ++create_failures_;
             break;
         }
     }
+    maint_thread_ = std::thread([this]() { maintenance_loop(); });
+}
+
+ConnectionPool::~ConnectionPool() {
+    {
+        std::lock_guard<std::mutex> lock(maint_mtx_);
+        stopping_ = true;
+    }
+    maint_cv_.notify_all();
+    if (maint_thread_.joinable()) {
+        maint_thread_.join();
+    }
 }
 
 ConnectionPool::ConnPtr ConnectionPool::acquire() {
-    std::unique_lock<std::mutex> lock(mtx_);
-    while (idle_.empty()) {
-        if (total_ < max_size_) {
+    return acquire(acquire_timeout_);
+}
+
+ConnectionPool::ConnPtr ConnectionPool::acquire(std::chrono::milliseconds timeout) {
+    Shard& home = home_shard();
+    // 요청 계측: 대기부터 반환까지를 DB 구간으로 본다 (반환은 deleter에서)
+    const uint64_t trace_id = request_trace::enter(request_trace::Phase::Db);
+
+    // 핫패스: 유휴 커넥션이 바로 있으면 시계 호출/대기 기록 없이 반환 (히스토그램 첫 버킷으로 집계)
+    for (uint32_t idx = take_idle(home); idx != kNil; idx = take_idle(home)) {
+        if (validate(*slots_[idx].conn, slots_[idx].since)) {
+            return wrap(home, idx, trace_id);
+        }
+        // 끊긴 커넥션은 폐기하고 다시 시도 (보충은 유지보수 스레드가 담당)
+        spdlog::warn("DB pool discarded broken idle connection");
+        discard(idx);
+    }
+
+    const auto start = Clock::now();
+    const auto deadline = start + timeout;
+    for (;;) {
+        uint32_t idx = take_idle(home);
+        if (idx != kNil) {
+            if (validate(*slots_[idx].conn, slots_[idx].since)) {
+                record_wait(start);
+                return wrap(home, idx, trace_id);
+            }
+            spdlog::warn("DB pool discarded broken idle connection");
+            discard(idx);
+            continue;
+        }
+
+        idx = free_.pop(slots_.get());
+        if (idx != kNil) {
+            // 빈 슬롯을 예약한 상태에서 새 커넥션 생성
+            ++total_;
             try {
-                auto conn = std::make_unique<pqxx::connection>(conn_str_);
-                ++total_;
-                // release captured this
-                return ConnPtr(conn.release(), [this](pqxx::connection* c) { release(c); });
+                slots_[idx].conn = std::make_unique<pqxx::connection>(conn_str_);
+                ++created_;
+                record_wait(start);
+                return wrap(home, idx, trace_id);
             } catch (const std::exception& ex) {
                 spdlog::error("DB pool connection create failed: {}", ex.what());
-                // wait a bit for existing to free
-                cv_.wait_for(lock, std::chrono::milliseconds(50));
-                continue;
+                ++create_failures_;
             }
+            --total_;
+            free_.push(slots_.get(), idx);
+            // wait a bit for existing to free
+            wait_for_release(std::min(deadline, Clock::now() + std::chrono::milliseconds(50)));
         } else {
-            cv_.wait(lock);
+            wait_for_release(deadline);
+        }
+
+        if (Clock::now() >= deadline && !has_available()) {
+            ++acquire_timeouts_;
+            record_wait(start);
+            request_trace::leave(request_trace::Phase::Db, trace_id);
+            throw std::runtime_error("DB pool acquire timeout (in_use=" + std::to_string(stats().in_use) +
+                                     ", max=" + std::to_string(max_size_) + ")");
+        }
+    }
+}
+
+void ConnectionPool::attach_replica(std::unique_ptr<ConnectionPool> replica, std::chrono::milliseconds ryw_window) {
+    replica_ = std::move(replica);
+    ryw_window_ = ryw_window;
+}
+
+ConnectionPool::ConnPtr ConnectionPool::acquire_read(const std::string& key) {
+    if (!replica_) return acquire();
+    if (written_recently(key)) {
+        ryw_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return acquire();
+    }
+    try {
+        auto conn = replica_->acquire();
+        replica_reads_.fetch_add(1, std::memory_order_relaxed);
+        return conn;
+    } catch (const std::exception& ex) {
+        spdlog::warn("DB replica acquire failed, reading from primary: {}", ex.what());
+        replica_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return acquire();
+    }
+}
+
+ConnectionPool::ConnPtr ConnectionPool::acquire_write(const std::string& key) {
+    auto conn = acquire();
+    if (!replica_ || ryw_window_.count() == 0) return conn;
+    // 커밋 이후 반환되는 시점을 쓰기 시각으로 기록
+    auto deleter = conn.get_deleter();
+    return ConnPtr(conn.release(), [this, key, deleter](pqxx::connection* c) {
+        note_write(key);
+        deleter(c);
+    });
+}
+
+void ConnectionPool::note_write(const std::string& key) {
+    auto& shard = recent_writes_[std::hash<std::string>{}(key) % kWriteShards];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.last_write[key] = Clock::now();
+}
+
+bool ConnectionPool::written_recently(const std::string& key) const {
+    if (ryw_window_.count() == 0) return false;
+    const auto& shard = recent_writes_[std::hash<std::string>{}(key) % kWriteShards];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto it = shard.last_write.find(key);
+    return it != shard.last_write.end() && Clock::now() - it->second < ryw_window_;
+}
+
+void ConnectionPool::purge_recent_writes() {
+    if (ryw_window_.count() == 0) return;
+    const auto now = Clock::now();
+    for (auto& shard : recent_writes_) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        for (auto it = shard.last_write.begin(); it != shard.last_write.end();) {
+            if (now - it->second >= ryw_window_) {
+                it = shard.last_write.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+ConnectionPool::Shard& ConnectionPool::home_shard() {
+    return shards_[thread_shard_seed() % kShards];
+}
+
+ConnectionPool::Clock::time_point ConnectionPool::coarse_now() const {
+    return Clock::time_point(Clock::duration(coarse_now_.load(std::memory_order_relaxed)));
+}
+
+uint32_t ConnectionPool::take_idle(Shard& home) {
+    // 1) 자기 스레드 슬롯
+    uint32_t idx = home.idx.exchange(kNil, std::memory_order_acquire);
+    if (idx != kNil) {
+        home.local_hits.fetch_add(1, std::memory_order_relaxed);
+        return idx;
+    }
+    // 2) 전역 스택
+    idx = idle_.pop(slots_.get());
+    if (idx != kNil) return idx;
+    // 3) 다른 스레드 슬롯에서 훔쳐오기
+    const std::size_t home_idx = static_cast<std::size_t>(&home - shards_.data());
+    for (std::size_t i = 1; i < kShards; ++i) {
+        auto& shard = shards_[(home_idx + i) % kShards];
+        if (shard.idx.load(std::memory_order_relaxed) == kNil) continue;
+        idx = shard.idx.exchange(kNil, std::memory_order_acquire);
+        if (idx != kNil) {
+            home.steals.fetch_add(1, std::memory_order_relaxed);
+            return idx;
         }
     }
-    auto conn = std::move(idle_.back());
-    idle_.pop_back();
-    return ConnPtr(conn.release(), [this](pqxx::connection* c) { release(c); });
+    return kNil;
+}
+
+void ConnectionPool::put_idle(Shard& home, uint32_t idx) {
+    uint32_t expected = kNil;
+    if (!home.idx.compare_exchange_strong(expected, idx, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+        idle_.push(slots_.get(), idx);
+    }
+}
+
+bool ConnectionPool::has_available() const {
+    if (!idle_.empty() || !free_.empty()) return true;
+    for (const auto& shard : shards_) {
+        if (shard.idx.load(std::memory_order_seq_cst) != kNil) return true;
+    }
+    return false;
+}
+
+void ConnectionPool::wait_for_release(Clock::time_point until) {
+    std::unique_lock<std::mutex> lock(wait_mtx_);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    // 대기 등록 이후 반환된 커넥션이 있으면 바로 재시도 (notify 유실 방지)
+    if (!has_available()) {
+        wait_cv_.wait_until(lock, until);
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
 }
 
-void ConnectionPool::release(pqxx::connection* conn) {
-    std::unique_lock<std::mutex> lock(mtx_);
-    idle_.emplace_back(conn);
-    lock.unlock();
-    cv_.notify_one();
+void ConnectionPool::notify_waiters() {
+    if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+    std::lock_guard<std::mutex> lock(wait_mtx_);
+    wait_cv_.notify_one();
+}
+
+ConnectionPool::ConnPtr ConnectionPool::wrap(Shard& home, uint32_t idx, uint64_t trace_id) {
+    home.acquires.fetch_add(1, std::memory_order_relaxed);
+    // 슬롯이 커넥션을 소유하므로 deleter는 반환만 한다
+    return ConnPtr(slots_[idx].conn.get(), [this, idx, trace_id](pqxx::connection*) {
+        release(idx);
+        request_trace::leave(request_trace::Phase::Db, trace_id);
+    });
+}
+
+bool ConnectionPool::validate(pqxx::connection& conn, Clock::time_point idle_since) {
+    if (!conn.is_open()) return false;
+    if (coarse_now() - idle_since < kValidateIdleAfter) return true;
+    try {
+        pqxx::nontransaction ntx(conn);
+        ntx.exec("SELECT 1");
+        return true;
+    } catch (const std::exception& ex) {
+        spdlog::warn("DB pool validation failed: {}", ex.what());
+        return false;
+    }
+}
+
+void ConnectionPool::release(uint32_t idx) {
+    // 반환 시점에 끊긴 커넥션은 풀에 넣지 않는다
+    Shard& home = home_shard();
+    home.releases.fetch_add(1, std::memory_order_relaxed);
+    if (!slots_[idx].conn->is_open()) {
+        discard(idx);
+        return;
+    }
+    slots_[idx].since = coarse_now();
+    put_idle(home, idx);
+    notify_waiters();
+}
+
+void ConnectionPool::discard(uint32_t idx) {
+    slots_[idx].conn.reset();
+    ++discarded_;
+    --total_;
+    free_.push(slots_.get(), idx);
+    maint_cv_.notify_one();
+    notify_waiters();
+}
+
+void ConnectionPool::record_wait(Clock::time_point start) {
+    auto waited_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    wait_sum_us_.fetch_add(static_cast<uint64_t>(waited_us), std::memory_order_relaxed);
+    auto waited_ms = static_cast<uint64_t>(waited_us / 1000);
+    std::size_t bucket = 0;
+    while (bucket < kWaitBucketsMs.size() && waited_ms > kWaitBucketsMs[bucket]) ++bucket;
+    wait_buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+ConnectionPool::Stats ConnectionPool::stats() const {
+    Stats s;
+    uint64_t releases = 0;
+    for (const auto& shard : shards_) {
+        s.acquires += shard.acquires.load(std::memory_order_relaxed);
+        releases += shard.releases.load(std::memory_order_relaxed);
+        s.local_hits += shard.local_hits.load(std::memory_order_relaxed);
+        s.steals += shard.steals.load(std::memory_order_relaxed);
+    }
+    s.total = total_.load(std::memory_order_relaxed);
+    s.in_use = s.acquires > releases ? static_cast<std::size_t>(s.acquires - releases) : 0;
+    s.idle = s.total > s.in_use ? s.total - s.in_use : 0;
+    s.acquire_timeouts = acquire_timeouts_.load(std::memory_order_relaxed);
+    s.created = created_.load(std::memory_order_relaxed);
+    s.create_failures = create_failures_.load(std::memory_order_relaxed);
+    s.discarded = discarded_.load(std::memory_order_relaxed);
+    s.trimmed = trimmed_.load(std::memory_order_relaxed);
+    uint64_t slow = 0;
+    for (std::size_t i = 0; i < wait_buckets_.size(); ++i) {
+        s.wait_buckets[i] = wait_buckets_[i].load(std::memory_order_relaxed);
+        slow += s.wait_buckets[i];
+    }
+    // 핫패스로 즉시 반환된 acquire는 대기 0으로 첫 버킷에 합산
+    if (s.acquires > slow) s.wait_buckets[0] += s.acquires - slow;
+    s.wait_sum_us = wait_sum_us_.load(std::memory_order_relaxed);
+    s.replica_reads = replica_reads_.load(std::memory_order_relaxed);
+    s.ryw_fallbacks = ryw_fallbacks_.load(std::memory_order_relaxed);
+    s.replica_fallbacks = replica_fallbacks_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void ConnectionPool::sweep_thread_slots() {
+    const auto now = Clock::now();
+    std::size_t evicted = 0;
+    for (auto& shard : shards_) {
+        if (shard.idx.load(std::memory_order_relaxed) == kNil) continue;
+        uint32_t idx = shard.idx.exchange(kNil, std::memory_order_acquire);
+        if (idx == kNil) continue;
+        if (now - slots_[idx].since < idle_timeout_) {
+            // 최근에 쓴 커넥션은 그대로 돌려놓는다 (그 사이 슬롯이 찼으면 전역 스택)
+            uint32_t expected = kNil;
+            if (!shard.idx.compare_exchange_strong(expected, idx, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                idle_.push(slots_.get(), idx);
+            }
+            continue;
+        }
+        if (total_.load() > initial_size_) {
+            slots_[idx].conn.reset();
+            --total_;
+            free_.push(slots_.get(), idx);
+            ++evicted;
+            continue;
+        }
+        if (!validate(*slots_[idx].conn, slots_[idx].since)) {
+            spdlog::warn("DB pool discarded broken idle connection from thread slot");
+            discard(idx);
+            continue;
+        }
+        slots_[idx].since = coarse_now();
+        idle_.push(slots_.get(), idx);
+    }
+    notify_waiters();
+    if (evicted > 0) {
+        trimmed_ += evicted;
+        spdlog::info("DB pool trimmed {} idle connection(s) from thread slots", evicted);
+    }
+}
+
+void ConnectionPool::maintenance_loop() {
+    uint64_t last_timeouts = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(maint_mtx_);
+            maint_cv_.wait_for(lock, kMaintenanceInterval);
+            if (stopping_) break;
+        }
+        coarse_now_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        purge_recent_writes();
+
+        // 0) 스레드 슬롯 점검: 조용한 스레드의 슬롯은 커넥션을 무기한 쥐고 있을 수 있으므로
+        //    idle_timeout_ 이상 쉰 커넥션을 꺼내 초과분이면 정리, 아니면 검사 후 전역 스택으로
+        sweep_thread_slots();
+
+        // 1) 초기 크기를 넘는 오래된 유휴 커넥션 정리 (전역 스택)
+        if (total_.load() > initial_size_) {
+            const auto now = Clock::now();
+            std::vector<uint32_t> keep;
+            std::size_t evicted = 0;
+            for (uint32_t idx = idle_.pop(slots_.get()); idx != kNil; idx = idle_.pop(slots_.get())) {
+                if (total_.load() > initial_size_ && now - slots_[idx].since >= idle_timeout_) {
+                    slots_[idx].conn.reset();
+                    --total_;
+                    free_.push(slots_.get(), idx);
+                    ++evicted;
+                } else {
+                    keep.push_back(idx);
+                }
+            }
+            for (auto it = keep.rbegin(); it != keep.rend(); ++it) {
+                idle_.push(slots_.get(), *it);
+            }
+            if (!keep.empty()) notify_waiters();
+            if (evicted > 0) {
+                trimmed_ += evicted;
+                spdlog::info("DB pool trimmed {} idle connection(s)", evicted);
+            }
+        }
+
+        // 2) 폐기된 커넥션 보충 (초기 크기까지)
+        while (total_.load() < initial_size_) {
+            uint32_t idx = free_.pop(slots_.get());
+            if (idx == kNil) break;
+            ++total_;
+            try {
+                slots_[idx].conn = std::make_unique<pqxx::connection>(conn_str_);
+                slots_[idx].since = Clock::now();
+                ++created_;
+            } catch (const std::exception& ex) {
+                spdlog::warn("DB pool replenish failed: {}", ex.what());
+                ++create_failures_;
+                --total_;
+                free_.push(slots_.get(), idx);
+                break;
+            }
+            idle_.push(slots_.get(), idx);
+            notify_waiters();
+        }
+
+        uint64_t timeouts = acquire_timeouts_.load(std::memory_order_relaxed);
+        if (timeouts != last_timeouts) {
+            spdlog::warn("DB pool acquire timeouts: +{} (total {})", timeouts - last_timeouts, timeouts);
+            last_timeouts = timeouts;
+        }
+    }
 }
@@ -1,26 +1,171 @@
 #pragma once
 #include <pqxx/pqxx>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-// 단순 커넥션 풀: 초기 크기만큼 미리 연결, 부족하면 최대치까지 동적 확장
+// 커넥션 풀: 초기 크기만큼 미리 연결, 부족하면 최대치까지 동적 확장
+// - 유휴 커넥션은 스레드별 로컬 슬롯 + 전역 lock-free 스택에 보관하고,
+//   로컬 슬롯이 비면 전역 스택 → 다른 스레드 슬롯 순으로 가져온다 (work-stealing)
+// - 뮤텍스/조건변수는 풀이 고갈되어 대기해야 할 때만 사용한다
+// - acquire는 데드라인까지만 대기하고 초과 시 std::runtime_error를 던진다
+// - 체크아웃/반환 시 커넥션 상태를 검사해 끊긴 커넥션은 폐기한다
+// - 백그라운드 스레드가 폐기된 커넥션을 보충하고 초과분 유휴 커넥션을 정리한다
+// - 읽기 복제본 풀을 붙이면 acquire_read 조회는 복제본으로 보낸다.
+//   같은 키(user_id 등)로 최근 acquire_write가 있었으면 복제 지연을 피하려고 primary에서 읽는다.
 class ConnectionPool {
 public:
-    ConnectionPool(const std::string& conn_str, std::size_t initial_size, std::size_t max_size);
+    using Clock = std::chrono::steady_clock;
+
+    // 대기 시간 히스토그램 버킷 상한 (ms), 마지막 버킷은 +Inf
+    static constexpr std::array<uint32_t, 11> kWaitBucketsMs{1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+
+    struct Stats {
+        std::size_t total{0};
+        std::size_t idle{0};
+        std::size_t in_use{0};
+        uint64_t acquires{0};
+        uint64_t acquire_timeouts{0};
+        uint64_t created{0};
+        uint64_t create_failures{0};
+        uint64_t discarded{0};
+        uint64_t trimmed{0};
+        uint64_t local_hits{0};
+        uint64_t steals{0};
+        uint64_t replica_reads{0};
+        uint64_t ryw_fallbacks{0};     // 최근 쓰기로 인해 primary에서 읽은 횟수
+        uint64_t replica_fallbacks{0}; // 복제본 획득 실패로 primary에서 읽은 횟수
+        std::array<uint64_t, kWaitBucketsMs.size() + 1> wait_buckets{};
+        uint64_t wait_sum_us{0};
+    };
+
+    ConnectionPool(const std::string& conn_str, std::size_t initial_size, std::size_t max_size,
+                   std::chrono::milliseconds acquire_timeout = std::chrono::milliseconds(5000),
+                   std::chrono::seconds idle_timeout = std::chrono::seconds(300));
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
 
     using ConnPtr = std::unique_ptr<pqxx::connection, std::function<void(pqxx::connection*)>>;
     ConnPtr acquire();
+    ConnPtr acquire(std::chrono::milliseconds timeout);
+
+    // 읽기 복제본 풀 연결 (ryw_window가 0이면 read-your-writes 추적 안 함)
+    void attach_replica(std::unique_ptr<ConnectionPool> replica, std::chrono::milliseconds ryw_window);
+    bool has_replica() const { return replica_ != nullptr; }
+    const ConnectionPool* replica() const { return replica_.get(); }
+
+    // 읽기 전용 조회용: 복제본이 있고 key에 최근 쓰기가 없으면 복제본 커넥션
+    ConnPtr acquire_read(const std::string& key);
+    // 쓰기용: primary 커넥션, 반환 시점에 key의 쓰기 시각을 기록
+    ConnPtr acquire_write(const std::string& key);
+
+    Stats stats() const;
 
 private:
-    void release(pqxx::connection* conn);
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr std::size_t kShards = 64;
+
+    // 커넥션 슬롯: 풀 생성 시 max_size 만큼 고정 할당, 인덱스로만 참조한다
+    struct Slot {
+        std::unique_ptr<pqxx::connection> conn;
+        Clock::time_point since;
+        std::atomic<uint32_t> next{kNil};
+    };
+
+    // 슬롯 인덱스용 Treiber 스택. head 상위 32비트 태그로 ABA를 막는다.
+    class IndexStack {
+    public:
+        void push(Slot* slots, uint32_t idx);
+        uint32_t pop(Slot* slots);
+        bool empty() const { return static_cast<uint32_t>(head_.load(std::memory_order_acquire)) == kNil; }
+
+    private:
+        std::atomic<uint64_t> head_{kNil};
+    };
+
+    // 스레드별 샤드: 로컬 유휴 슬롯 + 핫패스 카운터 (캐시 라인 분리)
+    struct alignas(64) Shard {
+        std::atomic<uint32_t> idx{kNil};
+        std::atomic<uint64_t> acquires{0};
+        std::atomic<uint64_t> releases{0};
+        std::atomic<uint64_t> local_hits{0};
+        std::atomic<uint64_t> steals{0};
+    };
+
+    Shard& home_shard();
+    Clock::time_point coarse_now() const;
+    uint32_t take_idle(Shard& home);
+    void put_idle(Shard& home, uint32_t idx);
+    bool has_available() const;
+    void wait_for_release(Clock::time_point until);
+    void notify_waiters();
+
+    void release(uint32_t idx);
+    void discard(uint32_t idx);
+    ConnPtr wrap(Shard& home, uint32_t idx, uint64_t trace_id);
+    bool validate(pqxx::connection& conn, Clock::time_point idle_since);
+    void record_wait(Clock::time_point start);
+    void maintenance_loop();
+    void sweep_thread_slots();
+
+    void note_write(const std::string& key);
+    bool written_recently(const std::string& key) const;
+    void purge_recent_writes();
 
     std::string conn_str_;
-    std::mutex mtx_;
-    std::condition_variable cv_;
-    std::vector<std::unique_ptr<pqxx::connection>> idle_;
+    std::size_t initial_size_;
     std::size_t max_size_;
-    std::size_t total_{0};
+    std::chrono::milliseconds acquire_timeout_;
+    std::chrono::seconds idle_timeout_;
+
+    std::unique_ptr<Slot[]> slots_;
+    IndexStack idle_;  // 연결된 유휴 슬롯
+    IndexStack free_;  // 커넥션이 없는 빈 슬롯
+    std::array<Shard, kShards> shards_;
+
+    std::atomic<std::size_t> total_{0};
+    // 유휴 판단용 저해상도 시계 (유지보수 스레드가 갱신, 핫패스에서 clock 호출 회피)
+    std::atomic<Clock::rep> coarse_now_{0};
+
+    // 풀 고갈 시 대기 경로 전용
+    std::mutex wait_mtx_;
+    std::condition_variable wait_cv_;
+    std::atomic<uint32_t> waiters_{0};
+
+    std::atomic<uint64_t> acquire_timeouts_{0};
+    std::atomic<uint64_t> created_{0};
+    std::atomic<uint64_t> create_failures_{0};
+    std::atomic<uint64_t> discarded_{0};
+    std::atomic<uint64_t> trimmed_{0};
+    std::array<std::atomic<uint64_t>, kWaitBucketsMs.size() + 1> wait_buckets_{};
+    std::atomic<uint64_t> wait_sum_us_{0};
+
+    // 읽기 복제본 + read-your-writes 추적 (키 해시로 샤딩)
+    static constexpr std::size_t kWriteShards = 16;
+    struct alignas(64) WriteShard {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Clock::time_point> last_write;
+    };
+    std::unique_ptr<ConnectionPool> replica_;
+    std::chrono::milliseconds ryw_window_{0};
+    std::array<WriteShard, kWriteShards> recent_writes_;
+    std::atomic<uint64_t> replica_reads_{0};
+    std::atomic<uint64_t> ryw_fallbacks_{0};
+    std::atomic<uint64_t> replica_fallbacks_{0};
+
+    std::mutex maint_mtx_;
+    std::condition_variable maint_cv_;
+    bool stopping_{false};
+    std::thread maint_thread_;
 };
@@ -1,18 +1,200 @@
 #include "connection_rate_limiter.h"
+#include <algorithm>
 
-bool ConnectionRateLimiter::allow(const std::string& ip) {
-    if (ip.empty()) return true;
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto now = std::chrono::steady_clock::now();
-    auto& ctr = counters_[ip];
-    if (ctr.window_start.time_since_epoch().count() == 0 ||
-        now - ctr.window_start >= window_) {
-        ctr.window_start = now;
-        ctr.count = 0;
-    }
-    if (ctr.count >= max_connections_per_window_) {
+namespace {
+int64_t to_ns(ConnectionRateLimiter::Clock::time_point tp) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+    return ns > 0 ? ns : 1; // 0은 빈 슬롯 표시로 사용
+}
+
+std::size_t round_up_pow2(std::size_t v) {
+    std::size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+uint64_t load_be64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+} // namespace
+
+ConnectionRateLimiter::ConnectionRateLimiter(const Options& options)
+    : options_(options),
+      host_bucket_(make_bucket(options.host_burst, options.host_window)),
+      subnet_bucket_(make_bucket(options.subnet_burst, options.subnet_window)) {
+    const std::size_t per_shard =
+        round_up_pow2(std::max<std::size_t>(options_.table_capacity / kShardCount, kProbeLimit * 8));
+    shard_mask_ = per_shard - 1;
+    for (auto& shard : shards_) {
+        shard.slots = std::make_unique<Entry[]>(per_shard);
+    }
+    if (options_.sweep_interval.count() > 0) {
+        sweeper_ = std::thread([this] { sweep_loop(); });
+    }
+}
+
+ConnectionRateLimiter::~ConnectionRateLimiter() {
+    {
+        std::lock_guard<std::mutex> lock(sweep_mutex_);
+        stopping_ = true;
+    }
+    sweep_cv_.notify_all();
+    if (sweeper_.joinable()) sweeper_.join();
+}
+
+ConnectionRateLimiter::Bucket ConnectionRateLimiter::make_bucket(uint32_t burst, std::chrono::seconds window) {
+    const int64_t window_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::max(window, std::chrono::seconds(1))).count();
+    Bucket b{};
+    b.burst = burst;
+    b.refill_per_ns = static_cast<double>(burst) / static_cast<double>(window_ns);
+    b.full_ns = window_ns;
+    return b;
+}
+
+ConnectionRateLimiter::Key ConnectionRateLimiter::host_key(const boost::asio::ip::address& address) {
+    Key key;
+    if (address.is_v4()) {
+        key.lo = address.to_v4().to_uint();
+        key.kind = 1;
+        return key;
+    }
+    const auto v6 = address.to_v6();
+    if (v6.is_v4_mapped()) {
+        key.lo = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, v6).to_uint();
+        key.kind = 1;
+        return key;
+    }
+    const auto bytes = v6.to_bytes();
+    key.hi = load_be64(bytes.data());
+    key.lo = load_be64(bytes.data() + 8);
+    key.kind = 3;
+    return key;
+}
+
+ConnectionRateLimiter::Key ConnectionRateLimiter::subnet_key(const boost::asio::ip::address& address) {
+    Key key = host_key(address);
+    if (key.kind == 1) {
+        key.lo &= 0xFFFFFF00u; // /24
+        key.kind = 2;
+    } else {
+        key.lo = 0; // /64
+        key.kind = 4;
+    }
+    return key;
+}
+
+uint64_t ConnectionRateLimiter::hash_key(const Key& key) {
+    // splitmix64 마무리 함수로 섞는다
+    uint64_t x = key.hi ^ (key.lo * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(key.kind) << 59);
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+bool ConnectionRateLimiter::allow(const boost::asio::ip::address& address, Clock::time_point now) {
+    const int64_t now_ns = to_ns(now);
+
+    if (host_bucket_.burst > 0 && !take(host_key(address), host_bucket_, now_ns)) {
+        denied_host_.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
-    ++ctr.count;
+    if (subnet_bucket_.burst > 0 && !take(subnet_key(address), subnet_bucket_, now_ns)) {
+        denied_subnet_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    allowed_.fetch_add(1, std::memory_order_relaxed);
     return true;
 }
+
+bool ConnectionRateLimiter::take(const Key& key, const Bucket& bucket, int64_t now_ns) {
+    const uint64_t h = hash_key(key);
+    auto& shard = shards_[h >> 60]; // 상위 비트로 샤드, 하위 비트로 슬롯
+    const std::size_t base = static_cast<std::size_t>(h) & shard_mask_;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry* free_slot = nullptr;
+    Entry* oldest = nullptr;
+    for (std::size_t i = 0; i < kProbeLimit; ++i) {
+        Entry& e = shard.slots[(base + i) & shard_mask_];
+        if (e.last_ns == 0) {
+            if (!free_slot) free_slot = &e;
+            continue;
+        }
+        if (e.key == key) {
+            const double refill = static_cast<double>(now_ns - e.last_ns) * bucket.refill_per_ns;
+            e.tokens = std::min<double>(bucket.burst, e.tokens + std::max(0.0, refill));
+            e.last_ns = std::max(e.last_ns, now_ns);
+            if (e.tokens < 1.0) return false;
+            e.tokens -= 1.0;
+            return true;
+        }
+        if (!oldest || e.last_ns < oldest->last_ns) oldest = &e;
+    }
+
+    // 처음 보는 키: 빈 슬롯, 없으면 탐색 구간에서 가장 오래된 항목을 덮어쓴다
+    Entry* target = free_slot;
+    if (!target) {
+        target = oldest;
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        ++shard.used;
+    }
+    target->key = key;
+    target->last_ns = now_ns;
+    target->tokens = static_cast<double>(bucket.burst) - 1.0;
+    return true;
+}
+
+void ConnectionRateLimiter::sweep(Clock::time_point now) {
+    const int64_t now_ns = to_ns(now);
+    uint64_t cleared = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.used == 0) continue;
+        for (std::size_t i = 0; i <= shard_mask_; ++i) {
+            Entry& e = shard.slots[i];
+            if (e.last_ns == 0) continue;
+            const bool is_host = e.key.kind == 1 || e.key.kind == 3;
+            const int64_t full_ns = is_host ? host_bucket_.full_ns : subnet_bucket_.full_ns;
+            // 가득 찬 버킷은 항목이 없는 것과 같으므로 비운다
+            if (now_ns - e.last_ns >= full_ns) {
+                e = Entry{};
+                --shard.used;
+                ++cleared;
+            }
+        }
+    }
+    swept_.fetch_add(cleared, std::memory_order_relaxed);
+}
+
+void ConnectionRateLimiter::sweep_loop() {
+    std::unique_lock<std::mutex> lock(sweep_mutex_);
+    while (!stopping_) {
+        sweep_cv_.wait_for(lock, options_.sweep_interval, [this] { return stopping_; });
+        if (stopping_) break;
+        lock.unlock();
+        sweep();
+        lock.lock();
+    }
+}
+
+ConnectionRateLimiter::Stats ConnectionRateLimiter::stats() const {
+    Stats s;
+    s.allowed = allowed_.load(std::memory_order_relaxed);
+    s.denied_host = denied_host_.load(std::memory_order_relaxed);
+    s.denied_subnet = denied_subnet_.load(std::memory_order_relaxed);
+    s.evictions = evictions_.load(std::memory_order_relaxed);
+    s.swept = swept_.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        s.entries += shard.used;
+    }
+    s.capacity = (shard_mask_ + 1) * kShardCount;
+    return s;
+}
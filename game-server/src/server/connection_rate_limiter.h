@@ -1,26 +1,108 @@
 #pragma once
+#include <boost/asio/ip/address.hpp>
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <string>
-#include <unordered_map>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <thread>
 
-// 간단한 per-IP 연결 레이트 리미터
+// 연결 레이트 리미터 (토큰 버킷)
+// - 호스트(IPv4 /32, IPv6 /128)와 서브넷(IPv4 /24, IPv6 /64) 버킷을 모두 통과해야 허용
+// - 키 해시로 샤드를 나누고, 샤드마다 고정 크기 오픈 어드레싱 테이블을 쓴다
+//   (탐색 구간이 차면 가장 오래된 항목을 덮어씀 → 연결 폭주에도 시간/메모리 상수)
+// - 버킷이 가득 찰 만큼 유휴 상태인 항목은 백그라운드 스레드가 비운다
 class ConnectionRateLimiter {
 public:
-    ConnectionRateLimiter(std::size_t max_connections_per_window,
-                          std::chrono::seconds window)
-        : max_connections_per_window_(max_connections_per_window),
-          window_(window) {}
+    using Clock = std::chrono::steady_clock;
 
-    bool allow(const std::string& ip);
+    struct Options {
+        uint32_t host_burst = 10;                     // 호스트당 버킷 크기 (0이면 호스트 제한 끔)
+        std::chrono::seconds host_window{10};         // 호스트 버킷이 비었다가 가득 차는 시간
+        uint32_t subnet_burst = 64;                   // 서브넷당 버킷 크기 (0이면 서브넷 제한 끔)
+        std::chrono::seconds subnet_window{10};
+        std::size_t table_capacity = 65536;           // 전체 항목 수 (샤드에 나눠 2의 거듭제곱으로 올림)
+        std::chrono::seconds sweep_interval{30};      // 유휴 항목 정리 주기
+    };
+
+    struct Stats {
+        uint64_t allowed{0};
+        uint64_t denied_host{0};
+        uint64_t denied_subnet{0};
+        uint64_t evictions{0}; // 빈 슬롯이 없어 활성 항목을 덮어쓴 횟수
+        uint64_t swept{0};
+        std::size_t entries{0};
+        std::size_t capacity{0};
+    };
+
+    explicit ConnectionRateLimiter(const Options& options);
+    ~ConnectionRateLimiter();
+
+    ConnectionRateLimiter(const ConnectionRateLimiter&) = delete;
+    ConnectionRateLimiter& operator=(const ConnectionRateLimiter&) = delete;
+
+    bool allow(const boost::asio::ip::address& address, Clock::time_point now = Clock::now());
+
+    // 유휴 항목 정리 (백그라운드 스레드에서 주기적으로 호출)
+    void sweep(Clock::time_point now = Clock::now());
+
+    Stats stats() const;
 
 private:
-    std::size_t max_connections_per_window_;
-    std::chrono::seconds window_;
-    struct Counter {
-        std::size_t count{0};
-        std::chrono::steady_clock::time_point window_start{};
+    static constexpr std::size_t kShardCount = 16;
+    static constexpr std::size_t kProbeLimit = 8;
+
+    // kind: 1 = IPv4 호스트, 2 = IPv4 /24, 3 = IPv6 호스트, 4 = IPv6 /64
+    struct Key {
+        uint64_t hi{0};
+        uint64_t lo{0};
+        uint32_t kind{0};
+        bool operator==(const Key& o) const { return hi == o.hi && lo == o.lo && kind == o.kind; }
+    };
+
+    struct Bucket {
+        uint32_t burst;
+        double refill_per_ns; // 나노초당 토큰
+        int64_t full_ns;      // 빈 버킷이 가득 차는 시간
+    };
+
+    struct Entry {
+        Key key;
+        int64_t last_ns{0}; // 0 = 빈 슬롯
+        double tokens{0.0};
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unique_ptr<Entry[]> slots;
+        std::size_t used{0};
     };
-    std::unordered_map<std::string, Counter> counters_;
-    std::mutex mutex_;
+
+    static Key host_key(const boost::asio::ip::address& address);
+    static Key subnet_key(const boost::asio::ip::address& address);
+    static uint64_t hash_key(const Key& key);
+    static Bucket make_bucket(uint32_t burst, std::chrono::seconds window);
+
+    // 버킷에서 토큰 하나를 꺼낸다. 부족하면 false
+    bool take(const Key& key, const Bucket& bucket, int64_t now_ns);
+    void sweep_loop();
+
+    Options options_;
+    Bucket host_bucket_;
+    Bucket subnet_bucket_;
+    std::size_t shard_mask_{0}; // 샤드 내 슬롯 수 - 1
+    std::array<Shard, kShardCount> shards_;
+
+    std::atomic<uint64_t> allowed_{0};
+    std::atomic<uint64_t> denied_host_{0};
+    std::atomic<uint64_t> denied_subnet_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> swept_{0};
+
+    std::mutex sweep_mutex_;
+    std::condition_variable sweep_cv_;
+    bool stopping_{false};
+    std::thread sweeper_;
 };
@@ -0,0 +1,6 @@
+#pragma once
+#include <cstddef>
+
+// 길이 접두(u32 LE) 프레임의 본문 크기 상한
+constexpr std::size_t kMaxRequestFrameSize = 64 * 1024;    // 서버가 받는 요청 (초과 시 INVALID_LENGTH)
+constexpr std::size_t kMaxResponseFrameSize = 1024 * 1024; // 클라이언트 도구가 받는 응답
@@ -0,0 +1,50 @@
+#include "game_clock.h"
+#include "time_utils.h"
+#include <atomic>
+#include <ctime>
+
+namespace game_clock {
+namespace {
+std::atomic<bool> g_virtual{false};
+std::atomic<int64_t> g_virtual_ms{0};
+std::atomic<uint32_t> g_scale{1};
+} // namespace
+
+Clock::time_point now() {
+    if (!g_virtual.load(std::memory_order_relaxed)) return Clock::now();
+    return Clock::time_point(std::chrono::milliseconds(g_virtual_ms.load(std::memory_order_relaxed)));
+}
+
+uint64_t now_ms() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now().time_since_epoch()).count());
+}
+
+bool is_virtual() {
+    return g_virtual.load(std::memory_order_relaxed);
+}
+
+void set_virtual(Clock::time_point start, uint32_t scale) {
+    g_virtual_ms = std::chrono::duration_cast<std::chrono::milliseconds>(start.time_since_epoch()).count();
+    g_scale = scale == 0 ? 1 : scale;
+    g_virtual = true;
+}
+
+void advance(std::chrono::milliseconds delta) {
+    g_virtual_ms.fetch_add(delta.count(), std::memory_order_relaxed);
+}
+
+uint32_t scale() {
+    return g_scale.load(std::memory_order_relaxed);
+}
+
+std::optional<std::string> kst_date_override() {
+    if (!is_virtual()) return std::nullopt;
+    const std::time_t tt = Clock::to_time_t(now() + std::chrono::hours(9));
+    std::tm tm = gmtime_compat(tt);
+    char buf[16];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+    return std::string(buf);
+}
+
+} // namespace game_clock
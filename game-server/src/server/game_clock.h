@@ -0,0 +1,29 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// 게임 로직용 시계 (기본은 system_clock 그대로)
+// 시뮬레이션 모드에서는 가상 시계로 바꿔 채굴 틱/리스폰/KST 일일 리셋을 압축된 시간으로 돌린다.
+// - 서버: SIM_TIME_SCALE > 1이면 틱마다 40ms * scale씩 진행
+// - 라이브러리: game-sim 도구가 advance()로 직접 진행
+// 인증 토큰 만료, 메트릭, 타이머 지연 측정은 항상 실제 시계를 쓴다.
+namespace game_clock {
+
+using Clock = std::chrono::system_clock;
+
+Clock::time_point now();
+uint64_t now_ms();
+
+bool is_virtual();
+// 가상 시계로 전환 (start 시각부터, scale은 서버 틱 배율)
+void set_virtual(Clock::time_point start, uint32_t scale = 1);
+void advance(std::chrono::milliseconds delta);
+// 서버 틱 1회(실제 40ms)에 진행할 게임 시간 배율 (실시간이면 1)
+uint32_t scale();
+
+// 가상 시계일 때 KST 날짜 "YYYY-MM-DD", 실시간이면 nullopt (DB의 CURRENT_TIMESTAMP 사용)
+std::optional<std::string> kst_date_override();
+
+} // namespace game_clock
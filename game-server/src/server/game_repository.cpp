@@ -1,17 +1,17 @@
 #include "game_repository.h"
 #include "connection_pool.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <sstream>
 #include <cmath>
 
-GameRepository::GameRepository(ConnectionPool& pool, const MetadataLoader& meta)
+GameRepository::GameRepository(ConnectionPool& pool, const MetadataStore& meta)
     : pool_(pool), meta_(meta) {}
 
 bool GameRepository::ensure_user_initialized(const std::string& user_id) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         tx.exec_params(
             "INSERT INTO game_schema.user_game_data (user_id) VALUES ($1) "
@@ -27,7 +27,8 @@ bool GameRepository::ensure_user_initialized(const std::string& user_id) {
         constexpr uint32_t kCritDamage = 15000;  // 150%
         uint64_t dps = 10;
 
-        if (const auto* pl = meta_.pickaxe_level(0)) {
+        auto meta = meta_.current();
+        if (const auto* pl = meta->pickaxe_level(0)) {
             level = pl->level;
             tier = pl->tier;
             attack_power = pl->attack_power;
@@ -78,7 +79,7 @@ bool GameRepository::ensure_user_initialized(const std::string& user_id) {
                 user_id, static_cast<int64_t>(total_dps), static_cast<int32_t>(level));
 
             // 보석 인벤토리 초기화
-            uint32_t base_capacity = meta_.gem_inventory_config().base_capacity;
+            uint32_t base_capacity = meta->gem_inventory_config().base_capacity;
             tx.exec_params(
                 "INSERT INTO game_schema.user_gem_inventory (user_id, current_capacity) "
                 "VALUES ($1, $2) ON CONFLICT (user_id) DO NOTHING",
@@ -161,7 +162,7 @@ UserGameData GameRepository::get_user_game_data(const std::string& user_id) {
 
 std::optional<uint32_t> GameRepository::add_crystal(const std::string& user_id, uint32_t delta) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         auto row = tx.exec_params1(
             "UPDATE game_schema.user_game_data "
@@ -180,7 +181,7 @@ std::optional<uint32_t> GameRepository::add_crystal(const std::string& user_id,
 
 bool GameRepository::set_current_mineral(const std::string& user_id, uint32_t mineral_id, uint64_t mineral_hp) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         tx.exec_params(
             "UPDATE game_schema.user_game_data "
@@ -199,8 +200,8 @@ bool GameRepository::set_current_mineral(const std::string& user_id, uint32_t mi
 GemInventoryInfo GameRepository::get_gem_inventory_info(const std::string& user_id) {
     GemInventoryInfo info{};
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
 
         // 인벤토리 용량 조회
         auto inv_row = tx.exec_params1(
@@ -218,7 +219,7 @@ GemInventoryInfo GameRepository::get_gem_inventory_info(const std::string& user_
     } catch (const std::exception& ex) {
         spdlog::error("get_gem_inventory_info failed for user {}: {}", user_id, ex.what());
         // 기본값 반환 (메타데이터 기반)
-        info.capacity = meta_.gem_inventory_config().base_capacity;
+        info.capacity = meta_.current()->gem_inventory_config().base_capacity;
         info.total_gems = 0;
     }
     return info;
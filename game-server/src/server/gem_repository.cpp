@@ -3,11 +3,12 @@
 #include <spdlog/spdlog.h>
 #include <chrono>
 
-std::vector<GemSlotData> GemRepository::get_gem_slots_for_pickaxe(const std::string& pickaxe_slot_id) {
+std::vector<GemSlotData> GemRepository::get_gem_slots_for_pickaxe(const std::string& user_id,
+                                                                  const std::string& pickaxe_slot_id) {
     std::vector<GemSlotData> slots;
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
 
         auto result = tx.exec_params(
             "SELECT "
@@ -52,8 +53,8 @@ std::vector<GemSlotData> GemRepository::get_gem_slots_for_pickaxe(const std::str
 std::vector<GemInstanceData> GemRepository::get_user_gems(const std::string& user_id) {
     std::vector<GemInstanceData> gems;
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
 
         auto result = tx.exec_params(
             "SELECT gem_instance_id, gem_id, "
@@ -109,8 +110,8 @@ std::optional<GemInstanceData> GemRepository::get_gem_by_instance_id(const std::
 
 uint32_t GemRepository::get_inventory_capacity(const std::string& user_id) {
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
 
         auto row = tx.exec_params1(
             "SELECT current_capacity FROM game_schema.user_gem_inventory "
@@ -128,7 +129,7 @@ uint32_t GemRepository::get_inventory_capacity(const std::string& user_id) {
 
 std::optional<GemInstanceData> GemRepository::create_gem(const std::string& user_id, uint32_t gem_id) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         auto result = tx.exec_params(
@@ -155,16 +156,14 @@ std::optional<GemInstanceData> GemRepository::create_gem(const std::string& user
     }
 }
 
-bool GemRepository::delete_gems(const std::vector<std::string>& gem_instance_ids) {
+bool GemRepository::delete_gems(const std::string& user_id, const std::vector<std::string>& gem_instance_ids) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
-        for (const auto& id : gem_instance_ids) {
-            tx.exec_params(
-                "DELETE FROM game_schema.user_gems WHERE gem_instance_id = $1::uuid",
-                id);
-        }
+        tx.exec_params(
+            "DELETE FROM game_schema.user_gems WHERE gem_instance_id = ANY($1::uuid[]) AND user_id = $2::uuid",
+            gem_instance_ids, user_id);
 
         tx.commit();
         return true;
@@ -174,10 +173,10 @@ bool GemRepository::delete_gems(const std::vector<std::string>& gem_instance_ids
     }
 }
 
-bool GemRepository::equip_gem(const std::string& pickaxe_slot_id, uint32_t gem_slot_index,
-                               const std::string& gem_instance_id) {
+bool GemRepository::equip_gem(const std::string& user_id, const std::string& pickaxe_slot_id,
+                               uint32_t gem_slot_index, const std::string& gem_instance_id) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -196,9 +195,10 @@ bool GemRepository::equip_gem(const std::string& pickaxe_slot_id, uint32_t gem_s
     }
 }
 
-bool GemRepository::unequip_gem(const std::string& pickaxe_slot_id, uint32_t gem_slot_index) {
+bool GemRepository::unequip_gem(const std::string& user_id, const std::string& pickaxe_slot_id,
+                                 uint32_t gem_slot_index) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -218,7 +218,7 @@ GachaResult GemRepository::gacha_pull(const std::string& user_id, uint32_t cryst
                                        const std::vector<uint32_t>& gem_ids) {
     GachaResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 인벤토리 용량 확인
@@ -252,19 +252,23 @@ GachaResult GemRepository::gacha_pull(const std::string& user_id, uint32_t cryst
 
         result.remaining_crystal = crystal_row[0][0].as<uint32_t>();
 
-        // 보석 생성
-        for (uint32_t gem_id : gem_ids) {
-            auto gem_row = tx.exec_params(
-                "INSERT INTO game_schema.user_gems (user_id, gem_id) "
-                "VALUES ($1::uuid, $2) "
-                "RETURNING gem_instance_id, gem_id, "
-                "  FLOOR(EXTRACT(EPOCH FROM acquired_at) * 1000)::BIGINT AS acquired_at_ms",
-                user_id, static_cast<int32_t>(gem_id));
+        // 보석 생성 (unnest 배열로 한 번에 INSERT, 뽑은 순서 유지)
+        std::vector<int32_t> gem_id_params(gem_ids.begin(), gem_ids.end());
+        auto gem_rows = tx.exec_params(
+            "INSERT INTO game_schema.user_gems (user_id, gem_id) "
+            "SELECT $1::uuid, g.gem_id "
+            "FROM unnest($2::int[]) WITH ORDINALITY AS g(gem_id, ord) "
+            "ORDER BY g.ord "
+            "RETURNING gem_instance_id, gem_id, "
+            "  FLOOR(EXTRACT(EPOCH FROM acquired_at) * 1000)::BIGINT AS acquired_at_ms",
+            user_id, gem_id_params);
 
+        result.created_gems.reserve(gem_rows.size());
+        for (auto row : gem_rows) {
             GemInstanceData gem;
-            gem.gem_instance_id = gem_row[0][0].as<std::string>();
-            gem.gem_id = gem_row[0][1].as<uint32_t>();
-            gem.acquired_at = gem_row[0][2].as<uint64_t>();
+            gem.gem_instance_id = row[0].as<std::string>();
+            gem.gem_id = row[1].as<uint32_t>();
+            gem.acquired_at = row[2].as<uint64_t>();
             result.created_gems.push_back(gem);
         }
 
@@ -282,7 +286,7 @@ SynthesisResult GemRepository::synthesize_gems(const std::string& user_id,
                                                 uint32_t result_gem_id) {
     SynthesisResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 3개 보석 소유 확인
@@ -297,11 +301,9 @@ SynthesisResult GemRepository::synthesize_gems(const std::string& user_id,
         }
 
         // 3개 보석 삭제
-        for (const auto& id : gem_instance_ids) {
-            tx.exec_params(
-                "DELETE FROM game_schema.user_gems WHERE gem_instance_id = $1::uuid",
-                id);
-        }
+        tx.exec_params(
+            "DELETE FROM game_schema.user_gems WHERE gem_instance_id = ANY($1::uuid[])",
+            gem_instance_ids);
 
         // 합성 성공 시 새 보석 생성
         if (result_gem_id > 0) {
@@ -328,25 +330,23 @@ SynthesisResult GemRepository::synthesize_gems(const std::string& user_id,
     return result;
 }
 
-ConversionResult GemRepository::convert_gem_type(const std::string& gem_instance_id,
+ConversionResult GemRepository::convert_gem_type(const std::string& user_id, const std::string& gem_instance_id,
                                                   uint32_t new_gem_id, uint32_t crystal_cost) {
     ConversionResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
-        // 보석 소유자 조회
+        // 보석 소유 확인
         auto gem_row = tx.exec_params(
-            "SELECT user_id FROM game_schema.user_gems WHERE gem_instance_id = $1::uuid",
-            gem_instance_id);
+            "SELECT 1 FROM game_schema.user_gems WHERE gem_instance_id = $1::uuid AND user_id = $2::uuid",
+            gem_instance_id, user_id);
 
         if (gem_row.empty()) {
             result.gem_not_found = true;
             return result;
         }
 
-        std::string user_id = gem_row[0][0].as<std::string>();
-
         // 크리스탈 차감
         auto crystal_row = tx.exec_params(
             "UPDATE game_schema.user_game_data "
@@ -383,16 +383,14 @@ DiscardResult GemRepository::discard_gems(const std::string& user_id,
                                            uint32_t crystal_reward) {
     DiscardResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 보석 삭제
-        for (const auto& id : gem_instance_ids) {
-            tx.exec_params(
-                "DELETE FROM game_schema.user_gems "
-                "WHERE gem_instance_id = $1::uuid AND user_id = $2::uuid",
-                id, user_id);
-        }
+        tx.exec_params(
+            "DELETE FROM game_schema.user_gems "
+            "WHERE gem_instance_id = ANY($1::uuid[]) AND user_id = $2::uuid",
+            gem_instance_ids, user_id);
 
         // 크리스탈 지급
         auto crystal_row = tx.exec_params(
@@ -416,11 +414,11 @@ DiscardResult GemRepository::discard_gems(const std::string& user_id,
     return result;
 }
 
-GemSlotUnlockResult GemRepository::unlock_gem_slot(const std::string& pickaxe_slot_id,
+GemSlotUnlockResult GemRepository::unlock_gem_slot(const std::string& user_id, const std::string& pickaxe_slot_id,
                                                      uint32_t gem_slot_index, uint32_t crystal_cost) {
     GemSlotUnlockResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 이미 해금되었는지 확인
@@ -434,17 +432,15 @@ GemSlotUnlockResult GemRepository::unlock_gem_slot(const std::string& pickaxe_sl
             return result;
         }
 
-        // 곡괭이 소유자 조회
+        // 곡괭이 소유 확인
         auto owner_row = tx.exec_params(
-            "SELECT user_id FROM game_schema.pickaxe_slots WHERE slot_id = $1::uuid",
-            pickaxe_slot_id);
+            "SELECT 1 FROM game_schema.pickaxe_slots WHERE slot_id = $1::uuid AND user_id = $2::uuid",
+            pickaxe_slot_id, user_id);
 
         if (owner_row.empty()) {
             return result;
         }
 
-        std::string user_id = owner_row[0][0].as<std::string>();
-
         // 크리스탈 차감
         auto crystal_row = tx.exec_params(
             "UPDATE game_schema.user_game_data "
@@ -481,7 +477,7 @@ GemSlotUnlockResult GemRepository::unlock_gem_slot(const std::string& pickaxe_sl
 InventoryExpandResult GemRepository::expand_inventory(const std::string& user_id, uint32_t crystal_cost) {
     InventoryExpandResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 현재 용량 조회
@@ -71,19 +71,20 @@ public:
     explicit GemRepository(ConnectionPool& pool) : pool_(pool) {}
 
     // 조회
-    std::vector<GemSlotData> get_gem_slots_for_pickaxe(const std::string& pickaxe_slot_id);
+    // 보석/슬롯 조회와 변경은 모두 user_id를 키로 풀을 잡는다 (쓰기 직후 읽기는 primary로)
+    std::vector<GemSlotData> get_gem_slots_for_pickaxe(const std::string& user_id, const std::string& pickaxe_slot_id);
     std::vector<GemInstanceData> get_user_gems(const std::string& user_id);
     std::optional<GemInstanceData> get_gem_by_instance_id(const std::string& gem_instance_id);
     uint32_t get_inventory_capacity(const std::string& user_id);
 
     // 보석 생성/삭제
     std::optional<GemInstanceData> create_gem(const std::string& user_id, uint32_t gem_id);
-    bool delete_gems(const std::vector<std::string>& gem_instance_ids);
+    bool delete_gems(const std::string& user_id, const std::vector<std::string>& gem_instance_ids);
 
     // 장착/해제
-    bool equip_gem(const std::string& pickaxe_slot_id, uint32_t gem_slot_index,
+    bool equip_gem(const std::string& user_id, const std::string& pickaxe_slot_id, uint32_t gem_slot_index,
                    const std::string& gem_instance_id);
-    bool unequip_gem(const std::string& pickaxe_slot_id, uint32_t gem_slot_index);
+    bool unequip_gem(const std::string& user_id, const std::string& pickaxe_slot_id, uint32_t gem_slot_index);
 
     // 트랜잭션
     GachaResult gacha_pull(const std::string& user_id, uint32_t crystal_cost,
@@ -91,12 +92,12 @@ public:
     SynthesisResult synthesize_gems(const std::string& user_id,
                                      const std::vector<std::string>& gem_instance_ids,
                                      uint32_t result_gem_id);
-    ConversionResult convert_gem_type(const std::string& gem_instance_id,
+    ConversionResult convert_gem_type(const std::string& user_id, const std::string& gem_instance_id,
                                        uint32_t new_gem_id, uint32_t crystal_cost);
     DiscardResult discard_gems(const std::string& user_id,
                                 const std::vector<std::string>& gem_instance_ids,
                                 uint32_t crystal_reward);
-    GemSlotUnlockResult unlock_gem_slot(const std::string& pickaxe_slot_id,
+    GemSlotUnlockResult unlock_gem_slot(const std::string& user_id, const std::string& pickaxe_slot_id,
                                          uint32_t gem_slot_index, uint32_t crystal_cost);
     InventoryExpandResult expand_inventory(const std::string& user_id, uint32_t crystal_cost);
 
@@ -1,26 +1,11 @@
 #include "gem_service.h"
+#include "pickaxe_stats.h"
+#include "rng_service.h"
 #include <spdlog/spdlog.h>
 #include <random>
 #include <cmath>
 #include <set>
 
-namespace {
-// 랜덤 넘버 생성기
-std::random_device rd;
-std::mt19937 gen(rd());
-
-// DPS 계산 (slot_service.cpp와 동일)
-uint64_t compute_expected_dps(uint64_t attack_power, uint32_t attack_speed_x100,
-                              uint32_t crit_percent, uint32_t crit_damage) {
-    double attack_speed = static_cast<double>(attack_speed_x100) / 100.0;
-    double crit_rate = static_cast<double>(crit_percent) / 10000.0;
-    double crit_mult = static_cast<double>(crit_damage) / 10000.0;
-    double expected = static_cast<double>(attack_power) * attack_speed *
-                      (1.0 + crit_rate * (crit_mult - 1.0));
-    return static_cast<uint64_t>(std::llround(expected));
-}
-}
-
 infinitepickaxe::GemListResponse GemService::handle_gem_list(const std::string& user_id) {
     infinitepickaxe::GemListResponse response;
 
@@ -41,8 +26,11 @@ infinitepickaxe::GemListResponse GemService::handle_gem_list(const std::string&
 infinitepickaxe::GemGachaResult GemService::handle_gacha_pull(const std::string& user_id, uint32_t pull_count) {
     infinitepickaxe::GemGachaResult result;
 
+    // 요청 처리 동안 같은 메타데이터 버전 사용
+    auto meta = meta_.current();
+
     // pull_count 검증 (1 또는 11)
-    const auto& gacha_meta = meta_.gem_gacha();
+    const auto& gacha_meta = meta->gem_gacha();
     uint32_t crystal_cost = 0;
     if (pull_count == 1) {
         crystal_cost = gacha_meta.single_pull_cost;
@@ -54,11 +42,19 @@ infinitepickaxe::GemGachaResult GemService::handle_gacha_pull(const std::string&
         return result;
     }
 
-    // 가중치 랜덤으로 gem_id 선택
+    // 로드 시 구성된 alias 테이블로 gem_id 추첨 (회당 O(1))
+    const auto& sampler = meta->gem_gacha_sampler();
+    if (sampler.empty()) {
+        spdlog::error("handle_gacha_pull: gacha sampler is empty (check gem_gacha/gem_definitions)");
+        result.set_success(false);
+        result.set_error_code("GACHA_NOT_CONFIGURED");
+        return result;
+    }
+    auto rng = RngService::stream(user_id, RngDomain::Gacha);
     std::vector<uint32_t> selected_gem_ids;
+    selected_gem_ids.reserve(pull_count);
     for (uint32_t i = 0; i < pull_count; ++i) {
-        uint32_t gem_id = select_random_gem_by_grade_rate(gacha_meta.grade_rates);
-        selected_gem_ids.push_back(gem_id);
+        selected_gem_ids.push_back(sampler.sample_gem(rng));
     }
 
     // Repository 호출
@@ -119,8 +115,10 @@ infinitepickaxe::GemSynthesisResult GemService::handle_synthesis(const std::stri
         gems.push_back(gem_opt.value());
     }
 
+    auto meta = meta_.current();
+
     // 모두 같은 grade, type인지 검증
-    const auto* first_def = meta_.gem_definition(gems[0].gem_id);
+    const auto* first_def = meta->gem_definition(gems[0].gem_id);
     if (!first_def) {
         result.set_success(false);
         result.set_error_code("INVALID_GEM_METADATA");
@@ -131,7 +129,7 @@ infinitepickaxe::GemSynthesisResult GemService::handle_synthesis(const std::stri
     uint32_t type_id = first_def->type_id;
 
     for (size_t i = 1; i < gems.size(); ++i) {
-        const auto* def = meta_.gem_definition(gems[i].gem_id);
+        const auto* def = meta->gem_definition(gems[i].gem_id);
         if (!def || def->grade_id != grade_id || def->type_id != type_id) {
             result.set_success(false);
             result.set_error_code("GRADE_TYPE_MISMATCH");
@@ -139,23 +137,14 @@ infinitepickaxe::GemSynthesisResult GemService::handle_synthesis(const std::stri
         }
     }
 
-    // grade_id를 grade string으로 변환
-    const auto* grade = meta_.gem_grade(grade_id);
-    if (!grade) {
+    if (!meta->gem_grade(grade_id)) {
         result.set_success(false);
         result.set_error_code("INVALID_GRADE_METADATA");
         return result;
     }
 
-    // 합성 규칙 조회
-    const GemSynthesisRule* rule = nullptr;
-    for (const auto& r : meta_.gem_synthesis_rules()) {
-        if (r.from_grade == grade->grade) {
-            rule = &r;
-            break;
-        }
-    }
-
+    // 합성 규칙 조회 (from_grade는 로드 시 grade_id로 변환됨)
+    const GemSynthesisRule* rule = meta->gem_synthesis_rule(grade_id);
     if (!rule) {
         result.set_success(false);
         result.set_error_code("NO_SYNTHESIS_RULE");
@@ -163,41 +152,27 @@ infinitepickaxe::GemSynthesisResult GemService::handle_synthesis(const std::stri
     }
 
     // 확률 판정
-    std::uniform_int_distribution<> dist(0, 9999);
-    uint32_t roll = dist(gen);
+    auto rng = RngService::stream(user_id, RngDomain::Synthesis);
+    uint32_t roll = RngService::roll_bp_10000(rng);
     bool synthesis_success = roll < rule->success_rate_percent;
 
     // 결과 gem_id 계산
     uint32_t result_gem_id = 0;
     if (synthesis_success) {
-        // to_grade string을 grade_id로 변환
-        uint32_t to_grade_id = 0;
-        for (const auto& g : meta_.gem_grades()) {
-            if (g.grade == rule->to_grade) {
-                to_grade_id = g.id;
-                break;
-            }
-        }
-
-        if (to_grade_id == 0) {
+        if (!rule->to_grade_id.has_value()) {
             result.set_success(false);
             result.set_error_code("INVALID_TO_GRADE");
             return result;
         }
 
         // 다음 등급의 같은 타입 gem_id 찾기
-        for (const auto& def : meta_.gem_definitions()) {
-            if (def.grade_id == to_grade_id && def.type_id == type_id) {
-                result_gem_id = def.gem_id;
-                break;
-            }
-        }
-
-        if (result_gem_id == 0) {
+        const auto* next_def = meta->gem_definition_for(*rule->to_grade_id, type_id);
+        if (!next_def) {
             result.set_success(false);
             result.set_error_code("RESULT_GEM_NOT_FOUND");
             return result;
         }
+        result_gem_id = next_def->gem_id;
     }
 
     // Repository 호출
@@ -244,35 +219,36 @@ infinitepickaxe::GemConversionResult GemService::handle_conversion(const std::st
     }
 
     const auto& gem = gem_opt.value();
-    const auto* gem_def = meta_.gem_definition(gem.gem_id);
+    auto meta = meta_.current();
+    const auto* gem_def = meta->gem_definition(gem.gem_id);
     if (!gem_def) {
         result.set_success(false);
         result.set_error_code("INVALID_GEM_METADATA");
         return result;
     }
 
-    // 현재 타입 확인
-    const auto* current_type = meta_.gem_type(gem_def->type_id);
-    if (!current_type) {
+    // 현재 타입 확인 (type_enum은 로드 시 변환됨)
+    if (gem_def->type_enum == infinitepickaxe::GEM_TYPE_UNKNOWN) {
         result.set_success(false);
         result.set_error_code("INVALID_TYPE_METADATA");
         return result;
     }
 
-    // 타입 변환 (enum -> string)
-    std::string target_type_str;
-    switch (target_type) {
-        case infinitepickaxe::ATTACK_SPEED: target_type_str = "ATTACK_SPEED"; break;
-        case infinitepickaxe::CRIT_RATE: target_type_str = "CRIT_RATE"; break;
-        case infinitepickaxe::CRIT_DMG: target_type_str = "CRIT_DMG"; break;
-        default:
-            result.set_success(false);
-            result.set_error_code("INVALID_TARGET_TYPE");
-            return result;
+    if (target_type == infinitepickaxe::GEM_TYPE_UNKNOWN || !infinitepickaxe::GemType_IsValid(target_type)) {
+        result.set_success(false);
+        result.set_error_code("INVALID_TARGET_TYPE");
+        return result;
+    }
+
+    const auto* target_type_meta = meta->gem_type_by_enum(target_type);
+    if (!target_type_meta) {
+        result.set_success(false);
+        result.set_error_code("TARGET_TYPE_NOT_FOUND");
+        return result;
     }
 
     // 같은 타입인지 확인
-    if (current_type->type == target_type_str) {
+    if (gem_def->type_enum == target_type) {
         result.set_success(false);
         result.set_error_code("SAME_TYPE");
         return result;
@@ -280,7 +256,7 @@ infinitepickaxe::GemConversionResult GemService::handle_conversion(const std::st
 
     // 비용 계산
     const GemConversionCost* cost_meta = nullptr;
-    for (const auto& c : meta_.gem_conversion_costs()) {
+    for (const auto& c : meta->gem_conversion_costs()) {
         if (c.grade_id == gem_def->grade_id) {
             cost_meta = &c;
             break;
@@ -296,36 +272,16 @@ infinitepickaxe::GemConversionResult GemService::handle_conversion(const std::st
     uint32_t crystal_cost = use_fixed_cost ? cost_meta->fixed_cost : cost_meta->random_cost;
 
     // 새로운 gem_id 계산 (같은 grade, 다른 type)
-    uint32_t target_type_id = 0;
-    for (const auto& t : meta_.gem_types()) {
-        if (t.type == target_type_str) {
-            target_type_id = t.id;
-            break;
-        }
-    }
-
-    if (target_type_id == 0) {
-        result.set_success(false);
-        result.set_error_code("TARGET_TYPE_NOT_FOUND");
-        return result;
-    }
-
-    uint32_t new_gem_id = 0;
-    for (const auto& def : meta_.gem_definitions()) {
-        if (def.grade_id == gem_def->grade_id && def.type_id == target_type_id) {
-            new_gem_id = def.gem_id;
-            break;
-        }
-    }
-
-    if (new_gem_id == 0) {
+    const auto* new_def = meta->gem_definition_for(gem_def->grade_id, target_type_meta->id);
+    if (!new_def) {
         result.set_success(false);
         result.set_error_code("NEW_GEM_NOT_FOUND");
         return result;
     }
+    uint32_t new_gem_id = new_def->gem_id;
 
     // Repository 호출
-    auto conv_result = gem_repo_.convert_gem_type(gem_instance_id, new_gem_id, crystal_cost);
+    auto conv_result = gem_repo_.convert_gem_type(user_id, gem_instance_id, new_gem_id, crystal_cost);
 
     if (!conv_result.success) {
         result.set_success(false);
@@ -351,13 +307,14 @@ infinitepickaxe::GemConversionResult GemService::handle_conversion(const std::st
     result.set_remaining_crystal(conv_result.remaining_crystal);
 
     spdlog::info("handle_conversion: user={} gem={} target_type={} cost={}",
-                 user_id, gem_instance_id, target_type_str, crystal_cost);
+                 user_id, gem_instance_id, target_type_meta->type, crystal_cost);
     return result;
 }
 
 infinitepickaxe::GemDiscardResult GemService::handle_discard(const std::string& user_id,
                                                               const std::vector<std::string>& gem_instance_ids) {
     infinitepickaxe::GemDiscardResult result;
+    auto meta = meta_.current();
 
     if (gem_instance_ids.empty()) {
         result.set_success(false);
@@ -375,7 +332,7 @@ infinitepickaxe::GemDiscardResult GemService::handle_discard(const std::string&
             return result;
         }
 
-        const auto* gem_def = meta_.gem_definition(gem_opt->gem_id);
+        const auto* gem_def = meta->gem_definition(gem_opt->gem_id);
         if (!gem_def) {
             result.set_success(false);
             result.set_error_code("INVALID_GEM_METADATA");
@@ -384,7 +341,7 @@ infinitepickaxe::GemDiscardResult GemService::handle_discard(const std::string&
 
         // 보상 조회
         const GemDiscardReward* reward_meta = nullptr;
-        for (const auto& r : meta_.gem_discard_rewards()) {
+        for (const auto& r : meta->gem_discard_rewards()) {
             if (r.grade_id == gem_def->grade_id) {
                 reward_meta = &r;
                 break;
@@ -438,7 +395,7 @@ infinitepickaxe::GemEquipResult GemService::handle_equip(const std::string& user
     const auto& slot = slot_opt.value();
 
     // Repository 호출
-    bool equip_success = gem_repo_.equip_gem(slot.slot_id, gem_slot_index, gem_instance_id);
+    bool equip_success = gem_repo_.equip_gem(user_id, slot.slot_id, gem_slot_index, gem_instance_id);
     if (!equip_success) {
         result.set_success(false);
         result.set_error_code("EQUIP_FAILED");
@@ -446,7 +403,7 @@ infinitepickaxe::GemEquipResult GemService::handle_equip(const std::string& user
     }
 
     // 보석 보너스 계산
-    auto gem_bonus = calculate_pickaxe_stats_with_gems(slot.slot_id);
+    auto gem_bonus = calculate_pickaxe_stats_with_gems(user_id, slot.slot_id);
 
     // 기본 스탯 + 보석 보너스 적용
     PickaxeSlot updated_slot = slot;
@@ -509,7 +466,7 @@ infinitepickaxe::GemUnequipResult GemService::handle_unequip(const std::string&
     const auto& slot = slot_opt.value();
 
     // 기존 장착 gem 정보 조회 (해제 전)
-    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(slot.slot_id);
+    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(user_id, slot.slot_id);
     std::optional<GemInstanceData> unequipped_gem;
     for (const auto& gs : gem_slots) {
         if (gs.gem_slot_index == gem_slot_index && gs.equipped_gem.has_value()) {
@@ -519,7 +476,7 @@ infinitepickaxe::GemUnequipResult GemService::handle_unequip(const std::string&
     }
 
     // Repository 호출
-    bool unequip_success = gem_repo_.unequip_gem(slot.slot_id, gem_slot_index);
+    bool unequip_success = gem_repo_.unequip_gem(user_id, slot.slot_id, gem_slot_index);
     if (!unequip_success) {
         result.set_success(false);
         result.set_error_code("UNEQUIP_FAILED");
@@ -527,7 +484,7 @@ infinitepickaxe::GemUnequipResult GemService::handle_unequip(const std::string&
     }
 
     // 보석 보너스 계산 (해제 후)
-    auto gem_bonus = calculate_pickaxe_stats_with_gems(slot.slot_id);
+    auto gem_bonus = calculate_pickaxe_stats_with_gems(user_id, slot.slot_id);
 
     // 기본 스탯 + 보석 보너스 적용
     PickaxeSlot updated_slot = slot;
@@ -589,8 +546,9 @@ infinitepickaxe::GemSlotUnlockResult GemService::handle_slot_unlock(const std::s
     const auto& slot = slot_opt.value();
 
     // 해금 비용 조회
+    auto meta = meta_.current();
     const GemSlotUnlockCost* cost_meta = nullptr;
-    for (const auto& c : meta_.gem_slot_unlock_costs()) {
+    for (const auto& c : meta->gem_slot_unlock_costs()) {
         if (c.slot_index == gem_slot_index) {
             cost_meta = &c;
             break;
@@ -605,7 +563,7 @@ infinitepickaxe::GemSlotUnlockResult GemService::handle_slot_unlock(const std::s
 
     // 순차 해금 검증: 0번부터 gem_slot_index-1번까지 모두 해금되었는지 확인
     if (gem_slot_index > 0) {
-        auto all_gem_slots = gem_repo_.get_gem_slots_for_pickaxe(slot.slot_id);
+        auto all_gem_slots = gem_repo_.get_gem_slots_for_pickaxe(user_id, slot.slot_id);
         std::set<uint32_t> unlocked_indices;
 
         for (const auto& gs : all_gem_slots) {
@@ -627,7 +585,7 @@ infinitepickaxe::GemSlotUnlockResult GemService::handle_slot_unlock(const std::s
     }
 
     // Repository 호출
-    auto unlock_result = gem_repo_.unlock_gem_slot(slot.slot_id, gem_slot_index, cost_meta->unlock_cost_crystal);
+    auto unlock_result = gem_repo_.unlock_gem_slot(user_id, slot.slot_id, gem_slot_index, cost_meta->unlock_cost_crystal);
 
     if (!unlock_result.success) {
         result.set_success(false);
@@ -655,7 +613,8 @@ infinitepickaxe::GemSlotUnlockResult GemService::handle_slot_unlock(const std::s
 infinitepickaxe::GemInventoryExpandResult GemService::handle_inventory_expand(const std::string& user_id) {
     infinitepickaxe::GemInventoryExpandResult result;
 
-    const auto& inv_config = meta_.gem_inventory_config();
+    auto meta = meta_.current();
+    const auto& inv_config = meta->gem_inventory_config();
 
     // Repository 호출
     auto expand_result = gem_repo_.expand_inventory(user_id, inv_config.expand_cost);
@@ -684,59 +643,14 @@ infinitepickaxe::GemInventoryExpandResult GemService::handle_inventory_expand(co
 
 // ========== Private Helpers ==========
 
-uint32_t GemService::select_random_gem_by_grade_rate(const std::vector<GemGradeRate>& grade_rates) {
-    // 가중치 합계 계산
-    uint32_t total_weight = 0;
-    for (const auto& rate : grade_rates) {
-        total_weight += rate.rate_percent;
-    }
-
-    // 랜덤 값 생성
-    std::uniform_int_distribution<> dist(0, total_weight - 1);
-    uint32_t roll = dist(gen);
-
-    // 누적 합으로 등급 선택
-    uint32_t cumulative = 0;
-    uint32_t selected_grade_id = 0;
-    for (const auto& rate : grade_rates) {
-        cumulative += rate.rate_percent;
-        if (roll < cumulative) {
-            selected_grade_id = rate.grade_id;
-            break;
-        }
-    }
-
-    if (selected_grade_id == 0) {
-        // fallback: 첫 번째 등급
-        selected_grade_id = grade_rates[0].grade_id;
-    }
-
-    // 해당 등급의 gem_id들 중 랜덤 선택
-    std::vector<uint32_t> candidate_gem_ids;
-    for (const auto& def : meta_.gem_definitions()) {
-        if (def.grade_id == selected_grade_id) {
-            candidate_gem_ids.push_back(def.gem_id);
-        }
-    }
-
-    if (candidate_gem_ids.empty()) {
-        spdlog::error("select_random_gem_by_grade_rate: no gems found for grade_id={}", selected_grade_id);
-        return 1; // fallback to first gem
-    }
-
-    std::uniform_int_distribution<> gem_dist(0, static_cast<int>(candidate_gem_ids.size()) - 1);
-    uint32_t gem_id = candidate_gem_ids[gem_dist(gen)];
-
-    return gem_id;
-}
-
 void GemService::populate_gem_info(const GemInstanceData& gem, infinitepickaxe::GemInfo* gem_info) {
     gem_info->set_gem_instance_id(gem.gem_instance_id);
     gem_info->set_gem_id(gem.gem_id);
     gem_info->set_acquired_at(gem.acquired_at);
 
     // 메타데이터에서 상세 정보 조회
-    const auto* gem_def = meta_.gem_definition(gem.gem_id);
+    auto meta = meta_.current();
+    const auto* gem_def = meta->gem_definition(gem.gem_id);
     if (!gem_def) {
         spdlog::warn("populate_gem_info: gem_id={} not found in metadata", gem.gem_id);
         return;
@@ -746,63 +660,52 @@ void GemService::populate_gem_info(const GemInstanceData& gem, infinitepickaxe::
     gem_info->set_icon(gem_def->icon);
     gem_info->set_stat_multiplier(gem_def->stat_multiplier);
 
-    // GemGrade enum 변환
-    const auto* grade = meta_.gem_grade(gem_def->grade_id);
-    if (grade) {
-        if (grade->grade == "COMMON") gem_info->set_grade(infinitepickaxe::COMMON);
-        else if (grade->grade == "RARE") gem_info->set_grade(infinitepickaxe::RARE);
-        else if (grade->grade == "EPIC") gem_info->set_grade(infinitepickaxe::EPIC);
-        else if (grade->grade == "HERO") gem_info->set_grade(infinitepickaxe::HERO);
-        else if (grade->grade == "LEGENDARY") gem_info->set_grade(infinitepickaxe::LEGENDARY);
-    }
-
-    // GemType enum 변환
-    const auto* type = meta_.gem_type(gem_def->type_id);
-    if (type) {
-        if (type->type == "ATTACK_SPEED") gem_info->set_type(infinitepickaxe::ATTACK_SPEED);
-        else if (type->type == "CRIT_RATE") gem_info->set_type(infinitepickaxe::CRIT_RATE);
-        else if (type->type == "CRIT_DMG") gem_info->set_type(infinitepickaxe::CRIT_DMG);
-    }
+    // grade/type enum은 메타데이터 로드 시 변환됨
+    if (gem_def->grade_enum != infinitepickaxe::GEM_GRADE_UNKNOWN) gem_info->set_grade(gem_def->grade_enum);
+    if (gem_def->type_enum != infinitepickaxe::GEM_TYPE_UNKNOWN) gem_info->set_type(gem_def->type_enum);
 }
 
-PickaxeSlot GemService::calculate_pickaxe_stats_with_gems(const std::string& pickaxe_slot_id) {
+PickaxeSlot GemService::calculate_pickaxe_stats_with_gems(const std::string& user_id,
+                                                          const std::string& pickaxe_slot_id) {
     // pickaxe_slot_id로 기본 슬롯 정보 조회
     // SlotRepository에 get_slot_by_id가 없으므로, user_id와 slot_index를 찾아야 함
     // 하지만 handle_equip/unequip에서 이미 slot을 조회했으므로, 그 정보를 활용하는 것이 좋음
     // 여기서는 장착된 보석들의 스탯 보너스만 계산하고, 호출하는 쪽에서 기본 슬롯 정보와 합산
 
     // 장착된 보석들의 스탯 보너스 계산
-    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(pickaxe_slot_id);
+    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(user_id, pickaxe_slot_id);
 
     uint32_t attack_speed_bonus = 0;     // basis 100
     uint32_t crit_rate_bonus = 0;        // basis 10000
     uint32_t crit_damage_bonus = 0;      // basis 100
 
+    auto meta = meta_.current();
     for (const auto& gem_slot : gem_slots) {
         if (!gem_slot.equipped_gem.has_value()) {
             continue;
         }
 
         const auto& gem = gem_slot.equipped_gem.value();
-        const auto* gem_def = meta_.gem_definition(gem.gem_id);
+        const auto* gem_def = meta->gem_definition(gem.gem_id);
         if (!gem_def) {
             continue;
         }
 
-        const auto* type = meta_.gem_type(gem_def->type_id);
-        if (!type) {
-            continue;
-        }
-
         uint32_t multiplier = gem_def->stat_multiplier; // x100
 
-        if (type->type == "ATTACK_SPEED") {
-            attack_speed_bonus += multiplier; // x100
-        } else if (type->type == "CRIT_RATE") {
-            // multiplier는 x100 (예: 500 = 5%), basis 10000으로 변환 (500 -> 5000)
-            crit_rate_bonus += multiplier * 100;
-        } else if (type->type == "CRIT_DMG") {
-            crit_damage_bonus += multiplier; // x100
+        switch (gem_def->type_enum) {
+            case infinitepickaxe::ATTACK_SPEED:
+                attack_speed_bonus += multiplier; // x100
+                break;
+            case infinitepickaxe::CRIT_RATE:
+                // multiplier는 x100 (예: 500 = 5%), basis 10000으로 변환 (500 -> 5000)
+                crit_rate_bonus += multiplier * 100;
+                break;
+            case infinitepickaxe::CRIT_DMG:
+                crit_damage_bonus += multiplier; // x100
+                break;
+            default:
+                break;
         }
     }
 
@@ -830,7 +733,7 @@ void GemService::populate_pickaxe_slot_info(const PickaxeSlot& slot, infinitepic
     slot_info->set_is_unlocked(true);
 
     // 보석 슬롯 정보 추가
-    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(slot.slot_id);
+    auto gem_slots = gem_repo_.get_gem_slots_for_pickaxe(slot.user_id, slot.slot_id);
     for (const auto& gem_slot : gem_slots) {
         auto* gem_slot_info = slot_info->add_gem_slots();
         gem_slot_info->set_gem_slot_index(gem_slot.gem_slot_index);
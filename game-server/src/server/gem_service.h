@@ -2,13 +2,13 @@
 #include "game.pb.h"
 #include "gem_repository.h"
 #include "slot_repository.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include <string>
 #include <vector>
 
 class GemService {
 public:
-    GemService(GemRepository& gem_repo, SlotRepository& slot_repo, const MetadataLoader& meta)
+    GemService(GemRepository& gem_repo, SlotRepository& slot_repo, const MetadataStore& meta)
         : gem_repo_(gem_repo), slot_repo_(slot_repo), meta_(meta) {}
 
     // 보석 목록 조회
@@ -53,16 +53,13 @@ public:
 private:
     GemRepository& gem_repo_;
     SlotRepository& slot_repo_;
-    const MetadataLoader& meta_;
-
-    // 가중치 랜덤 선택 (gacha용)
-    uint32_t select_random_gem_by_grade_rate(const std::vector<GemGradeRate>& grade_rates);
+    const MetadataStore& meta_;
 
     // GemInstanceData → GemInfo protobuf 변환
     void populate_gem_info(const GemInstanceData& gem, infinitepickaxe::GemInfo* gem_info);
 
     // 보석 장착/해제 시 곡괭이 스탯 보너스 계산
-    PickaxeSlot calculate_pickaxe_stats_with_gems(const std::string& pickaxe_slot_id);
+    PickaxeSlot calculate_pickaxe_stats_with_gems(const std::string& user_id, const std::string& pickaxe_slot_id);
 
     // PickaxeSlot → PickaxeSlotInfo protobuf 변환 (gem_slots 포함)
     void populate_pickaxe_slot_info(const PickaxeSlot& slot, infinitepickaxe::PickaxeSlotInfo* slot_info);
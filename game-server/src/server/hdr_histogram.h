@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// HDR 방식(로그-선형) 지연 히스토그램 (마이크로초 단위)
+// - 2의 거듭제곱 구간마다 2^kSubBucketBits개로 나눠 전 범위에서 상대 오차 ~3%를 유지
+// - 기록은 relaxed fetch_add 한 번 (lock-free), 백분위 조회는 전체 버킷 스캔
+class HdrHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr unsigned kMaxMagnitude = 26; // 2^26us ≈ 67초, 초과분은 마지막 버킷
+    static constexpr std::size_t kBucketCount = (kMaxMagnitude - kSubBucketBits + 2) * kSubBuckets;
+
+    void record(uint64_t value_us) {
+        buckets_[index_of(value_us)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t prev = max_.load(std::memory_order_relaxed);
+        while (value_us > prev && !max_.compare_exchange_weak(prev, value_us, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // q(0~1) 백분위 값 (해당 버킷의 상한, 최대 기록값을 넘지 않음)
+    uint64_t percentile(double q) const {
+        const uint64_t total = count();
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.5);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t upper = upper_bound_of(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+
+private:
+    static std::size_t index_of(uint64_t v) {
+        if (v < kSubBuckets) return static_cast<std::size_t>(v);
+        unsigned magnitude = 63u - static_cast<unsigned>(__builtin_clzll(v));
+        if (magnitude > kMaxMagnitude) return kBucketCount - 1;
+        const unsigned shift = magnitude - kSubBucketBits;
+        const uint64_t sub = v >> shift; // [kSubBuckets, 2*kSubBuckets)
+        return static_cast<std::size_t>((shift + 1) * kSubBuckets + (sub - kSubBuckets));
+    }
+
+    static uint64_t upper_bound_of(std::size_t index) {
+        if (index < kSubBuckets) return index;
+        const uint64_t shift = index / kSubBuckets - 1;
+        const uint64_t sub = index % kSubBuckets + kSubBuckets;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_{0};
+};
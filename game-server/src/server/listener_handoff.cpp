@@ -0,0 +1,147 @@
+#include "listener_handoff.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char kAck = 'A';
+constexpr int kReceiveTimeoutSec = 5;
+} // namespace
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+std::optional<int> receive_listener(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) return std::nullopt;
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    const int conn = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (conn < 0) return std::nullopt;
+    timeval timeout{kReceiveTimeoutSec, 0};
+    ::setsockopt(conn, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (::connect(conn, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        // 이전 프로세스 없음 (첫 기동이거나 남은 소켓 파일)
+        ::close(conn);
+        return std::nullopt;
+    }
+
+    char byte = 0;
+    iovec iov{&byte, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    std::optional<int> fd;
+    if (::recvmsg(conn, &msg, 0) == 1) {
+        for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+                int received = -1;
+                std::memcpy(&received, CMSG_DATA(c), sizeof(int));
+                fd = received;
+            }
+        }
+    }
+    if (fd) {
+        // 확인 응답을 받아야 이전 프로세스가 accept를 멈추고 드레인한다
+        if (::send(conn, &kAck, 1, MSG_NOSIGNAL) != 1) {
+            ::close(*fd);
+            fd.reset();
+        }
+    } else {
+        spdlog::warn("Listener handoff from {} failed: {}", path, std::strerror(errno));
+    }
+    ::close(conn);
+    return fd;
+}
+
+ListenerHandoff::ListenerHandoff(boost::asio::io_context& io, std::string path, int listen_fd,
+                                 std::function<void()> on_handoff)
+    : acceptor_(io), path_(std::move(path)), listen_fd_(listen_fd), on_handoff_(std::move(on_handoff)) {}
+
+bool ListenerHandoff::start() {
+    try {
+        ::unlink(path_.c_str());
+        boost::asio::local::stream_protocol::endpoint endpoint(path_);
+        acceptor_.open(endpoint.protocol());
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+    } catch (const std::exception& ex) {
+        spdlog::error("Listener handoff socket {} unavailable: {}", path_, ex.what());
+        return false;
+    }
+    spdlog::info("Listener handoff ready at {}", path_);
+    do_accept();
+    return true;
+}
+
+void ListenerHandoff::do_accept() {
+    acceptor_.async_accept([this](boost::system::error_code ec, boost::asio::local::stream_protocol::socket peer) {
+        if (ec || handed_off_) return;
+
+        char byte = 0;
+        iovec iov{&byte, 1};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* c = CMSG_FIRSTHDR(&msg);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(c), &listen_fd_, sizeof(int));
+        if (::sendmsg(peer.native_handle(), &msg, MSG_NOSIGNAL) != 1) {
+            spdlog::warn("Listener handoff send failed: {}", std::strerror(errno));
+            do_accept();
+            return;
+        }
+
+        auto conn = std::make_shared<boost::asio::local::stream_protocol::socket>(std::move(peer));
+        auto ack = std::make_shared<char>(0);
+        boost::asio::async_read(*conn, boost::asio::buffer(ack.get(), 1),
+                                [this, conn, ack](boost::system::error_code read_ec, std::size_t) {
+                                    if (read_ec || *ack != kAck) {
+                                        // 새 프로세스가 리슨 소켓을 쓰지 못함 → 계속 서비스
+                                        spdlog::warn("Listener handoff not acknowledged, keep serving");
+                                        do_accept();
+                                        return;
+                                    }
+                                    handed_off_ = true;
+                                    boost::system::error_code ignored;
+                                    acceptor_.close(ignored);
+                                    spdlog::info("Listener handed off to new process, draining");
+                                    if (on_handoff_) on_handoff_();
+                                });
+    });
+}
+
+#else
+
+std::optional<int> receive_listener(const std::string&) {
+    return std::nullopt;
+}
+
+ListenerHandoff::ListenerHandoff(boost::asio::io_context&, std::string path, int listen_fd,
+                                 std::function<void()> on_handoff)
+    : path_(std::move(path)), listen_fd_(listen_fd), on_handoff_(std::move(on_handoff)) {}
+
+bool ListenerHandoff::start() {
+    spdlog::warn("Listener handoff is not supported on this platform");
+    return false;
+}
+
+void ListenerHandoff::do_accept() {}
+
+#endif
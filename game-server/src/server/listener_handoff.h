@@ -0,0 +1,32 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <functional>
+#include <optional>
+#include <string>
+
+// 무중단 재시작용 리슨 소켓 전달 (유닉스 도메인 소켓 + SCM_RIGHTS)
+// - 새 프로세스: receive_listener(path)로 이전 프로세스에 접속해 리슨 소켓 fd를 받고 바로 accept 시작
+// - 이전 프로세스: ListenerHandoff가 path에서 대기하다 fd를 보내고, 새 프로세스의 확인 응답을 받으면
+//   on_handoff(드레인 시작)를 호출한다. 재접속하는 클라이언트는 같은 리슨 큐에서 새 프로세스가 받는다.
+// 경로의 소켓 파일은 항상 새 프로세스가 지우고 다시 만든다 (이전 프로세스는 지우지 않음).
+
+// 이전 프로세스가 없거나 응답이 없으면 nullopt (그때는 직접 bind)
+std::optional<int> receive_listener(const std::string& path);
+
+class ListenerHandoff {
+public:
+    ListenerHandoff(boost::asio::io_context& io, std::string path, int listen_fd, std::function<void()> on_handoff);
+
+    bool start();
+
+private:
+    void do_accept();
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+#endif
+    std::string path_;
+    int listen_fd_;
+    std::function<void()> on_handoff_;
+    bool handed_off_{false};
+};
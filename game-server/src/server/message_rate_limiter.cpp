@@ -0,0 +1,90 @@
+#include "message_rate_limiter.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <sstream>
+
+MessageRatePolicy MessageRatePolicy::defaults() {
+    using namespace infinitepickaxe;
+    MessageRatePolicy p;
+    auto set = [&p](MessageType type, uint16_t cost) { p.costs[static_cast<std::size_t>(type)] = cost; };
+    set(HEARTBEAT, 1);
+    set(MISSION_PROGRESS_UPDATE, 1);
+    set(MINERAL_LIST_REQUEST, 4);
+    set(CHANGE_MINERAL_REQUEST, 4);
+    set(UPGRADE_REQUEST, 4);
+    set(SLOT_UNLOCK, 4);
+    set(DAILY_MISSIONS_REQUEST, 6);
+    set(OFFLINE_REWARD_REQUEST, 6);
+    set(ALL_SLOTS_REQUEST, 8);
+    set(GEM_LIST_REQUEST, 8);
+    set(GEM_SYNTHESIS_REQUEST, 6);
+    set(GEM_CONVERSION_REQUEST, 6);
+    set(GEM_GACHA_REQUEST, 10);
+    return p;
+}
+
+void MessageRatePolicy::apply_overrides(const std::string& spec) {
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        const auto eq = item.find('=');
+        if (eq == std::string::npos) {
+            spdlog::warn("Ignoring malformed message cost entry '{}'", item);
+            continue;
+        }
+        const std::string name = item.substr(0, eq);
+        infinitepickaxe::MessageType type;
+        if (!infinitepickaxe::MessageType_Parse(name, &type) ||
+            static_cast<std::size_t>(type) >= kMaxType) {
+            spdlog::warn("Ignoring message cost for unknown type '{}'", name);
+            continue;
+        }
+        try {
+            const auto cost = std::stoul(item.substr(eq + 1));
+            costs[static_cast<std::size_t>(type)] = static_cast<uint16_t>(std::min<unsigned long>(cost, 0xFFFF));
+        } catch (const std::exception& ex) {
+            spdlog::warn("Ignoring message cost '{}': {}", item, ex.what());
+        }
+    }
+}
+
+void MessageRatePolicy::clamp_to_capacity() {
+    // 버킷보다 비싸면 영원히 거부되므로 capacity로 낮춘다
+    const uint16_t max_cost = static_cast<uint16_t>(std::min<uint32_t>(std::max<uint32_t>(capacity, 1), 0xFFFF));
+    if (default_cost > max_cost) {
+        spdlog::warn("Default message cost {} exceeds bucket capacity, clamped to {}", default_cost, max_cost);
+        default_cost = max_cost;
+    }
+    for (std::size_t i = 0; i < kMaxType; ++i) {
+        if (costs[i] <= max_cost) continue;
+        const auto type = static_cast<infinitepickaxe::MessageType>(i);
+        const std::string name = infinitepickaxe::MessageType_IsValid(static_cast<int>(i))
+                                     ? infinitepickaxe::MessageType_Name(type)
+                                     : std::to_string(i);
+        spdlog::warn("Message cost for {} ({}) exceeds bucket capacity, clamped to {}", name, costs[i], max_cost);
+        costs[i] = max_cost;
+    }
+}
+
+bool MessageRateLimiter::try_consume(infinitepickaxe::MessageType type, Clock::time_point now) {
+    if (now > last_) {
+        const double elapsed = std::chrono::duration<double>(now - last_).count();
+        tokens_ = std::min<double>(policy_.capacity, tokens_ + elapsed * policy_.refill_per_sec);
+        last_ = now;
+    }
+    const double cost = static_cast<double>(policy_.cost(type));
+    if (tokens_ < cost) return false;
+    tokens_ -= cost;
+    return true;
+}
+
+uint32_t MessageRateLimiter::record_violation(Clock::time_point now) {
+    violations_.push_back(now);
+    while (!violations_.empty() &&
+           ((policy_.violation_window.count() > 0 && violations_.front() + policy_.violation_window <= now) ||
+            violations_.size() > std::max<uint32_t>(policy_.max_violations, 1))) {
+        violations_.pop_front();
+    }
+    return static_cast<uint32_t>(violations_.size());
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "game.pb.h"
+
+// 메시지 타입별 비용 정책 (서버 전체 공유, 읽기 전용)
+// - 세션마다 capacity 크기의 토큰 버킷을 두고 요청마다 타입별 비용만큼 차감한다
+// - DB 조회가 많은 요청(보석 목록/가챠, 전체 슬롯 등)은 비싸게, 하트비트는 싸게
+struct MessageRatePolicy {
+    static constexpr std::size_t kMaxType = 128; // MessageType 값 상한 (이상은 default_cost)
+
+    uint32_t capacity = 60;          // 버킷 크기 (순간 허용량)
+    uint32_t refill_per_sec = 20;    // 초당 충전 토큰
+    uint32_t max_violations = 20;    // violation_window 안의 초과 횟수가 이 값에 도달하면 연결 종료 (0이면 종료 안 함)
+    std::chrono::seconds violation_window{60}; // 0이면 세션 전체 누적
+    uint16_t default_cost = 2;
+    std::array<uint16_t, kMaxType> costs{}; // 0 = default_cost
+
+    static MessageRatePolicy defaults();
+
+    // "GEM_LIST_REQUEST=10,HEARTBEAT=1" 형식의 비용 재정의. 알 수 없는 타입은 경고 후 무시.
+    void apply_overrides(const std::string& spec);
+    // capacity와 비용을 모두 정한 뒤 호출: capacity보다 큰 비용(기본값 포함)은 capacity로 낮춘다
+    void clamp_to_capacity();
+
+    uint32_t cost(infinitepickaxe::MessageType type) const {
+        const auto idx = static_cast<std::size_t>(type);
+        if (idx >= kMaxType || costs[idx] == 0) return default_cost;
+        return costs[idx];
+    }
+};
+
+// 세션별 인바운드 메시지 토큰 버킷 (세션 읽기 루프에서만 호출되므로 잠금 없음)
+class MessageRateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MessageRateLimiter(const MessageRatePolicy& policy)
+        : policy_(policy), tokens_(static_cast<double>(policy.capacity)), last_(Clock::now()) {}
+
+    // 비용만큼 토큰이 있으면 차감하고 true
+    bool try_consume(infinitepickaxe::MessageType type, Clock::time_point now = Clock::now());
+
+    // 초과 1회 기록 후 최근 violation_window 안의 초과 횟수 (max_violations개까지만 보관)
+    uint32_t record_violation(Clock::time_point now = Clock::now());
+
+    const MessageRatePolicy& policy() const { return policy_; }
+
+private:
+    const MessageRatePolicy& policy_;
+    double tokens_;
+    Clock::time_point last_;
+    std::deque<Clock::time_point> violations_;
+};
@@ -1,2 +1,134 @@
 #include "message_router.h"
-// 현재 구현은 헤더에 모든 로직이 있어 빈 파일입니다.
+#include "hdr_histogram.h"
+#include <spdlog/spdlog.h>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <optional>
+
+namespace {
+
+constexpr std::size_t kMaxType = metrics::kMaxMessageType;
+
+struct TypeStats {
+    HdrHistogram latency;
+    std::array<std::atomic<uint64_t>, request_trace::kPhaseCount + 1> phase_ns{}; // 마지막은 handler
+};
+
+// 타입별 통계는 처음 쓰일 때 할당 (실제 쓰는 타입은 20여 개뿐)
+std::array<std::atomic<TypeStats*>, kMaxType> g_stats{};
+std::atomic<int64_t> g_slow_threshold_ns{200'000'000};
+
+TypeStats& stats_for(std::size_t idx) {
+    TypeStats* s = g_stats[idx].load(std::memory_order_acquire);
+    if (s) return *s;
+    auto fresh = std::make_unique<TypeStats>();
+    if (g_stats[idx].compare_exchange_strong(s, fresh.get(), std::memory_order_acq_rel)) {
+        return *fresh.release(); // 프로세스 종료까지 유지
+    }
+    return *s;
+}
+
+double to_ms(std::chrono::nanoseconds ns) {
+    return std::chrono::duration<double, std::milli>(ns).count();
+}
+
+std::string type_name(std::size_t idx) {
+    if (infinitepickaxe::MessageType_IsValid(static_cast<int>(idx))) {
+        return infinitepickaxe::MessageType_Name(static_cast<infinitepickaxe::MessageType>(idx));
+    }
+    return std::to_string(idx);
+}
+
+} // namespace
+
+bool MessageRouter::dispatch(const infinitepickaxe::Envelope& env, const std::string& user_id) const {
+    auto it = handlers_.find(env.type());
+    if (it == handlers_.end()) return false;
+
+    // 호출자가 Scope를 열지 않았으면 여기서 연다 (파싱 구간은 비어 있음)
+    std::optional<request_trace::Scope> own_scope;
+    if (!request_trace::Scope::current()) own_scope.emplace();
+    auto* scope = request_trace::Scope::current();
+
+    it->second(env);
+
+    record(env.type(), user_id, scope->snapshot());
+    return true;
+}
+
+void MessageRouter::record(infinitepickaxe::MessageType type, const std::string& user_id,
+                           const request_trace::Breakdown& breakdown) {
+    using request_trace::Phase;
+    metrics::observe_request(type, breakdown.total);
+
+    const auto idx = static_cast<std::size_t>(type);
+    if (idx < kMaxType) {
+        auto& s = stats_for(idx);
+        s.latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(breakdown.total).count()));
+        for (std::size_t i = 0; i < request_trace::kPhaseCount; ++i) {
+            s.phase_ns[i].fetch_add(static_cast<uint64_t>(breakdown.phases[i].count()), std::memory_order_relaxed);
+        }
+        s.phase_ns[request_trace::kPhaseCount].fetch_add(static_cast<uint64_t>(breakdown.handler().count()),
+                                                         std::memory_order_relaxed);
+    }
+
+    const int64_t threshold = g_slow_threshold_ns.load(std::memory_order_relaxed);
+    if (threshold > 0 && breakdown.total.count() >= threshold) {
+        auto phase = [&breakdown](Phase p) { return to_ms(breakdown.phases[static_cast<std::size_t>(p)]); };
+        spdlog::warn("Slow request type={} user_id={} total={:.2f}ms parse={:.2f} db={:.2f} redis={:.2f} "
+                     "serialize={:.2f} send={:.2f} handler={:.2f}",
+                     type_name(idx), user_id.empty() ? "-" : user_id, to_ms(breakdown.total),
+                     phase(Phase::Parse), phase(Phase::Db), phase(Phase::Redis),
+                     phase(Phase::Serialize), phase(Phase::Send), to_ms(breakdown.handler()));
+    }
+}
+
+void MessageRouter::configure(std::chrono::milliseconds slow_threshold) {
+    g_slow_threshold_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(slow_threshold).count(),
+                              std::memory_order_relaxed);
+}
+
+void MessageRouter::render_metrics(metrics::Writer& writer) {
+    static constexpr std::array<double, 4> kQuantiles{0.5, 0.9, 0.99, 0.999};
+
+    const std::string latency = "game_request_latency_seconds";
+    writer.header(latency, "summary", "Request latency percentiles by message type since start (HDR, ~3% error)");
+    for (std::size_t idx = 0; idx < kMaxType; ++idx) {
+        const TypeStats* s = g_stats[idx].load(std::memory_order_acquire);
+        if (!s || s->latency.count() == 0) continue;
+        const std::string label = "type=\"" + type_name(idx) + "\"";
+        for (double q : kQuantiles) {
+            char qbuf[16];
+            std::snprintf(qbuf, sizeof(qbuf), "%g", q);
+            writer.sample(latency, label + ",quantile=\"" + qbuf + "\"",
+                          static_cast<double>(s->latency.percentile(q)) / 1e6);
+        }
+        writer.sample(latency + "_count", label, static_cast<double>(s->latency.count()));
+    }
+
+    const std::string latency_max = "game_request_latency_max_seconds";
+    writer.header(latency_max, "gauge", "Slowest request by message type since start");
+    for (std::size_t idx = 0; idx < kMaxType; ++idx) {
+        const TypeStats* s = g_stats[idx].load(std::memory_order_acquire);
+        if (!s || s->latency.count() == 0) continue;
+        writer.sample(latency_max, "type=\"" + type_name(idx) + "\"", static_cast<double>(s->latency.max()) / 1e6);
+    }
+
+    const std::string phases = "game_request_phase_seconds_total";
+    writer.header(phases, "counter", "Request time spent per phase by message type");
+    for (std::size_t idx = 0; idx < kMaxType; ++idx) {
+        const TypeStats* s = g_stats[idx].load(std::memory_order_acquire);
+        if (!s || s->latency.count() == 0) continue;
+        const std::string label = "type=\"" + type_name(idx) + "\",phase=\"";
+        for (std::size_t i = 0; i <= request_trace::kPhaseCount; ++i) {
+            const char* name = i < request_trace::kPhaseCount
+                                   ? request_trace::phase_name(static_cast<request_trace::Phase>(i))
+                                   : "handler";
+            writer.sample(phases, label + name + "\"",
+                          static_cast<double>(s->phase_ns[i].load(std::memory_order_relaxed)) / 1e9);
+        }
+    }
+}
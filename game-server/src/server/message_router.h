@@ -1,9 +1,16 @@
 #pragma once
+#include <chrono>
 #include <functional>
+#include <string>
 #include <unordered_map>
 #include "game.pb.h"
+#include "metrics.h"
+#include "request_trace.h"
 
 // 각 메시지 타입을 핸들러에 매핑하는 간단한 라우터
+// - 모든 핸들러 호출을 구간별(parse/db/redis/serialize/send/handler)로 계측해
+//   타입별 HDR 히스토그램과 구간 누적 시간을 남긴다
+// - 임계값을 넘은 요청은 user_id와 구간 분해를 함께 경고 로그로 남긴다
 class MessageRouter {
 public:
     using HandlerFn = std::function<void(const infinitepickaxe::Envelope&)>;
@@ -12,12 +19,18 @@ public:
         handlers_[msg_type] = std::move(fn);
     }
 
-    bool dispatch(const infinitepickaxe::Envelope& env) const {
-        auto it = handlers_.find(env.type());
-        if (it == handlers_.end()) return false;
-        it->second(env);
-        return true;
-    }
+    // 핸들러가 없으면 false. 호출자가 연 request_trace::Scope가 있으면 그 시작 시각부터 잰다.
+    bool dispatch(const infinitepickaxe::Envelope& env, const std::string& user_id) const;
+
+    // 라우터 밖에서 처리한 요청(핸드셰이크 등)의 계측 기록
+    static void record(infinitepickaxe::MessageType type, const std::string& user_id,
+                       const request_trace::Breakdown& breakdown);
+
+    // 느린 요청 로그 임계값 (0이면 끔)
+    static void configure(std::chrono::milliseconds slow_threshold);
+
+    // /metrics: 타입별 지연 백분위와 구간 누적 시간
+    static void render_metrics(metrics::Writer& writer);
 
 private:
     std::unordered_map<infinitepickaxe::MessageType, HandlerFn> handlers_;
@@ -0,0 +1,213 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace metrics {
+namespace {
+
+constexpr std::size_t kBucketSlots = kLatencyBuckets.size() + 1;
+
+// 단일 writer 값: 소유 스레드만 증가시키고 스크레이프 스레드는 읽기만 한다
+struct Cell {
+    std::atomic<uint64_t> v{0};
+    void add(uint64_t n) { v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    uint64_t get() const { return v.load(std::memory_order_relaxed); }
+};
+
+struct HistCells {
+    std::array<Cell, kBucketSlots> buckets;
+    Cell count;
+    Cell sum_ns;
+
+    void observe(std::chrono::nanoseconds elapsed) {
+        const int64_t ns = std::max<int64_t>(0, elapsed.count());
+        const double sec = static_cast<double>(ns) / 1e9;
+        std::size_t i = 0;
+        while (i < kLatencyBuckets.size() && sec > kLatencyBuckets[i]) ++i;
+        buckets[i].add(1);
+        count.add(1);
+        sum_ns.add(static_cast<uint64_t>(ns));
+    }
+};
+
+struct alignas(64) ThreadShard {
+    std::array<Cell, static_cast<std::size_t>(Counter::Count)> counters;
+    std::array<HistCells, static_cast<std::size_t>(Histogram::Count)> histograms;
+    std::array<HistCells, kMaxMessageType> requests;
+};
+
+struct ShardList {
+    std::mutex mutex;
+    // 스레드가 끝나도 누적값이 남아야 하므로 샤드는 해제하지 않는다 (스레드 수만큼만 생성됨)
+    std::vector<std::unique_ptr<ThreadShard>> shards;
+};
+
+ShardList& shard_list() {
+    static ShardList list;
+    return list;
+}
+
+ThreadShard& local_shard() {
+    thread_local ThreadShard* shard = [] {
+        auto owned = std::make_unique<ThreadShard>();
+        auto* raw = owned.get();
+        auto& list = shard_list();
+        std::lock_guard<std::mutex> lock(list.mutex);
+        list.shards.push_back(std::move(owned));
+        return raw;
+    }();
+    return *shard;
+}
+
+struct HistTotals {
+    std::array<uint64_t, kBucketSlots> buckets{};
+    uint64_t count{0};
+    uint64_t sum_ns{0};
+
+    void merge(const HistCells& cells) {
+        for (std::size_t i = 0; i < kBucketSlots; ++i) buckets[i] += cells.buckets[i].get();
+        count += cells.count.get();
+        sum_ns += cells.sum_ns.get();
+    }
+};
+
+std::string format_number(double value) {
+    char buf[32];
+    if (std::floor(value) == value && std::fabs(value) < 9.0e15) {
+        std::snprintf(buf, sizeof(buf), "%.0f", value);
+    } else {
+        std::snprintf(buf, sizeof(buf), "%.9g", value);
+    }
+    return buf;
+}
+
+const char* counter_name(Counter c) {
+    switch (c) {
+    case Counter::ConnectionsAccepted: return "game_connections_accepted_total";
+    case Counter::ConnectionsRejected: return "game_connections_rejected_total";
+    case Counter::MessagesRateLimited: return "game_messages_rate_limited_total";
+    case Counter::BytesIn: return "game_bytes_received_total";
+    case Counter::BytesOut: return "game_bytes_sent_total";
+    case Counter::Count: break;
+    }
+    return "game_unknown_total";
+}
+
+const char* counter_help(Counter c) {
+    switch (c) {
+    case Counter::ConnectionsAccepted: return "Accepted TCP connections";
+    case Counter::ConnectionsRejected: return "Connections rejected by the connection rate limiter";
+    case Counter::MessagesRateLimited: return "Client messages rejected by the per-session message budget";
+    case Counter::BytesIn: return "Bytes read from client sockets including length prefix";
+    case Counter::BytesOut: return "Bytes written to client sockets including length prefix";
+    case Counter::Count: break;
+    }
+    return "";
+}
+
+const char* histogram_name(Histogram h) {
+    switch (h) {
+    case Histogram::TickDuration: return "game_mining_tick_duration_seconds";
+    case Histogram::TickLag: return "game_mining_tick_lag_seconds";
+    case Histogram::RedisLatency: return "game_redis_command_duration_seconds";
+    case Histogram::Count: break;
+    }
+    return "game_unknown_seconds";
+}
+
+const char* histogram_help(Histogram h) {
+    switch (h) {
+    case Histogram::TickDuration: return "Time spent running one mining tick over all sessions";
+    case Histogram::TickLag: return "Delay between the scheduled and actual start of a mining tick";
+    case Histogram::RedisLatency: return "Round trip time of a single Redis command";
+    case Histogram::Count: break;
+    }
+    return "";
+}
+
+} // namespace
+
+void add(Counter counter, uint64_t n) {
+    local_shard().counters[static_cast<std::size_t>(counter)].add(n);
+}
+
+void observe(Histogram histogram, std::chrono::nanoseconds elapsed) {
+    local_shard().histograms[static_cast<std::size_t>(histogram)].observe(elapsed);
+}
+
+void observe_request(infinitepickaxe::MessageType type, std::chrono::nanoseconds elapsed) {
+    const auto idx = static_cast<std::size_t>(type);
+    if (idx >= kMaxMessageType) return;
+    local_shard().requests[idx].observe(elapsed);
+}
+
+void Writer::header(const std::string& name, const char* type, const char* help) {
+    out_ += "# HELP " + name + " " + help + "\n";
+    out_ += "# TYPE " + name + " " + type + "\n";
+}
+
+void Writer::sample(const std::string& name, const std::string& labels, double value) {
+    out_ += name;
+    if (!labels.empty()) out_ += "{" + labels + "}";
+    out_ += " " + format_number(value) + "\n";
+}
+
+void Writer::write_histogram(const std::string& name, const std::string& labels, const double* bounds,
+                             std::size_t n, const uint64_t* bucket_counts, double sum) {
+    const std::string prefix = labels.empty() ? std::string() : labels + ",";
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        cumulative += bucket_counts[i];
+        sample(name + "_bucket", prefix + "le=\"" + format_number(bounds[i]) + "\"", static_cast<double>(cumulative));
+    }
+    cumulative += bucket_counts[n];
+    sample(name + "_bucket", prefix + "le=\"+Inf\"", static_cast<double>(cumulative));
+    sample(name + "_sum", labels, sum);
+    sample(name + "_count", labels, static_cast<double>(cumulative));
+}
+
+void render_builtin(Writer& writer) {
+    std::array<uint64_t, static_cast<std::size_t>(Counter::Count)> counters{};
+    std::array<HistTotals, static_cast<std::size_t>(Histogram::Count)> histograms{};
+    std::vector<HistTotals> requests(kMaxMessageType);
+    {
+        auto& list = shard_list();
+        std::lock_guard<std::mutex> lock(list.mutex);
+        for (const auto& shard : list.shards) {
+            for (std::size_t i = 0; i < counters.size(); ++i) counters[i] += shard->counters[i].get();
+            for (std::size_t i = 0; i < histograms.size(); ++i) histograms[i].merge(shard->histograms[i]);
+            for (std::size_t i = 0; i < kMaxMessageType; ++i) requests[i].merge(shard->requests[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < counters.size(); ++i) {
+        const auto c = static_cast<Counter>(i);
+        writer.header(counter_name(c), "counter", counter_help(c));
+        writer.sample(counter_name(c), "", static_cast<double>(counters[i]));
+    }
+    for (std::size_t i = 0; i < histograms.size(); ++i) {
+        const auto h = static_cast<Histogram>(i);
+        writer.header(histogram_name(h), "histogram", histogram_help(h));
+        writer.histogram(histogram_name(h), "", kLatencyBuckets, histograms[i].buckets,
+                         static_cast<double>(histograms[i].sum_ns) / 1e9);
+    }
+
+    const std::string req_name = "game_request_duration_seconds";
+    writer.header(req_name, "histogram", "Client request handling time by message type");
+    for (std::size_t i = 0; i < kMaxMessageType; ++i) {
+        const auto& totals = requests[i];
+        if (totals.count == 0) continue;
+        const auto type = static_cast<infinitepickaxe::MessageType>(i);
+        std::string type_name = infinitepickaxe::MessageType_IsValid(static_cast<int>(i))
+                                    ? infinitepickaxe::MessageType_Name(type)
+                                    : std::to_string(i);
+        writer.histogram(req_name, "type=\"" + type_name + "\"", kLatencyBuckets, totals.buckets,
+                         static_cast<double>(totals.sum_ns) / 1e9);
+    }
+}
+
+} // namespace metrics
@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "game.pb.h"
+
+// 서버 지표 (Prometheus 텍스트 포맷으로 노출)
+// - 기록은 스레드별 샤드에 단일 writer로 쓰므로 잠금/원자 RMW가 없다
+// - 스크레이프 시 모든 샤드를 합산한다 (값은 단조 증가, 합산 중 약간의 어긋남은 허용)
+namespace metrics {
+
+enum class Counter : std::size_t {
+    ConnectionsAccepted,
+    ConnectionsRejected,   // 연결 레이트 리미트로 거부
+    MessagesRateLimited,   // 세션 메시지 비용 초과로 거부
+    BytesIn,
+    BytesOut,
+    Count
+};
+
+enum class Histogram : std::size_t {
+    TickDuration,  // 채굴 틱 1회 처리 시간
+    TickLag,       // 예정 시각 대비 틱 시작 지연
+    RedisLatency,  // Redis 명령 1회 왕복
+    Count
+};
+
+// 히스토그램 버킷 상한 (초), 마지막 버킷은 +Inf
+constexpr std::array<double, 14> kLatencyBuckets{
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5};
+
+constexpr std::size_t kMaxMessageType = 128;
+
+void add(Counter counter, uint64_t n = 1);
+void observe(Histogram histogram, std::chrono::nanoseconds elapsed);
+void observe_request(infinitepickaxe::MessageType type, std::chrono::nanoseconds elapsed);
+
+// 범위를 벗어날 때 경과 시간을 기록
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { observe(histogram_, std::chrono::steady_clock::now() - start_); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Prometheus 텍스트 출력 도우미
+class Writer {
+public:
+    void header(const std::string& name, const char* type, const char* help);
+    void sample(const std::string& name, const std::string& labels, double value);
+    // bucket_counts는 구간별 개수 (누적 아님), 마지막은 +Inf 구간
+    template <std::size_t N, std::size_t M>
+    void histogram(const std::string& name, const std::string& labels,
+                   const std::array<double, N>& bounds, const std::array<uint64_t, M>& bucket_counts,
+                   double sum) {
+        static_assert(M == N + 1, "bucket_counts must have one extra +Inf slot");
+        write_histogram(name, labels, bounds.data(), N, bucket_counts.data(), sum);
+    }
+
+    const std::string& str() const { return out_; }
+
+private:
+    void write_histogram(const std::string& name, const std::string& labels, const double* bounds,
+                         std::size_t n, const uint64_t* bucket_counts, double sum);
+    std::string out_;
+};
+
+// 스레드별 기록을 합산해 기본 지표를 출력
+void render_builtin(Writer& writer);
+
+} // namespace metrics
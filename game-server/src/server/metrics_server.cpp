@@ -0,0 +1,83 @@
+#include "metrics_server.h"
+#include <httplib.h>
+#include <spdlog/spdlog.h>
+
+MetricsServer::MetricsServer() : server_(std::make_unique<httplib::Server>()) {
+    server_->Get("/healthz", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("ok\n", "text/plain");
+    });
+
+    server_->Get("/readyz", [this](const httplib::Request&, httplib::Response& res) {
+        std::string reason;
+        if (check_ready(reason)) {
+            res.set_content("ready\n", "text/plain");
+        } else {
+            res.status = 503;
+            res.set_content(reason + "\n", "text/plain");
+        }
+    });
+
+    server_->Get("/metrics", [this](const httplib::Request&, httplib::Response& res) {
+        res.set_content(render(), "text/plain; version=0.0.4");
+    });
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+void MetricsServer::add_collector(Collector collector) {
+    collectors_.push_back(std::move(collector));
+}
+
+void MetricsServer::add_readiness_check(std::string name, ReadinessCheck check) {
+    readiness_checks_.emplace_back(std::move(name), std::move(check));
+}
+
+bool MetricsServer::start(const std::string& host, unsigned short port) {
+    if (!server_->bind_to_port(host.c_str(), port)) {
+        spdlog::error("Metrics server failed to bind {}:{}", host, port);
+        return false;
+    }
+    thread_ = std::thread([this] { server_->listen_after_bind(); });
+    spdlog::info("Metrics/health endpoint listening on {}:{}", host, port);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (server_) server_->stop();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool MetricsServer::check_ready(std::string& reason) const {
+    if (!ready_.load(std::memory_order_relaxed)) {
+        reason = "draining";
+        return false;
+    }
+    for (const auto& [name, check] : readiness_checks_) {
+        std::string detail;
+        try {
+            if (!check(detail)) {
+                reason = name + ": " + detail;
+                return false;
+            }
+        } catch (const std::exception& ex) {
+            reason = name + ": " + ex.what();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string MetricsServer::render() const {
+    metrics::Writer writer;
+    metrics::render_builtin(writer);
+    for (const auto& collector : collectors_) {
+        try {
+            collector(writer);
+        } catch (const std::exception& ex) {
+            spdlog::warn("Metrics collector failed: {}", ex.what());
+        }
+    }
+    return writer.str();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "metrics.h"
+
+namespace httplib {
+class Server;
+}
+
+// health_port에서 동작하는 내장 HTTP 서버
+// - GET /healthz : 프로세스 생존 확인 (항상 200)
+// - GET /readyz  : 등록된 준비 상태 검사가 모두 통과하면 200, 아니면 503 + 실패 사유
+// - GET /metrics : 기본 지표 + 등록된 수집기 출력 (Prometheus 텍스트 포맷)
+class MetricsServer {
+public:
+    using Collector = std::function<void(metrics::Writer&)>;
+    // 준비되지 않았으면 false를 반환하고 reason을 채운다
+    using ReadinessCheck = std::function<bool(std::string& reason)>;
+
+    MetricsServer();
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // start 이전에 등록
+    void add_collector(Collector collector);
+    void add_readiness_check(std::string name, ReadinessCheck check);
+
+    // 별도 스레드에서 리슨 시작. 바인드 실패 시 false
+    bool start(const std::string& host, unsigned short port);
+    void stop();
+
+    // 종료 절차 중에는 준비 상태를 내려 로드밸런서가 새 연결을 보내지 않게 한다
+    void set_ready(bool ready) { ready_.store(ready, std::memory_order_relaxed); }
+
+    std::string render() const;
+
+private:
+    bool check_ready(std::string& reason) const;
+
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+    std::vector<Collector> collectors_;
+    std::vector<std::pair<std::string, ReadinessCheck>> readiness_checks_;
+    std::atomic<bool> ready_{true};
+};
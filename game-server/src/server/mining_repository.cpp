@@ -5,7 +5,7 @@
 MiningRepository::CompletionResult MiningRepository::record_completion(const std::string& user_id, uint32_t mineral_id, uint64_t gold_earned) {
     CompletionResult result;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         // 골드 지급 및 카운트 증가
         auto r = tx.exec_params1(
@@ -18,8 +18,36 @@ MiningRepository::CompletionResult MiningRepository::record_completion(const std
         result.mining_count = r[1].as<int64_t>();
 
         tx.commit();
+        result.ok = true;
     } catch (const std::exception& ex) {
         spdlog::error("record_completion failed for user {}: {}", user_id, ex.what());
     }
     return result;
 }
+
+void MiningRepository::record_completion_async(const std::string& user_id, uint32_t mineral_id, uint64_t gold_earned,
+                                               std::function<void(CompletionResult)> cb) {
+    if (!async_pool_) {
+        cb(record_completion(user_id, mineral_id, gold_earned));
+        return;
+    }
+    async_pool_->exec(
+        "UPDATE game_schema.user_game_data "
+        "SET gold = gold + $2, total_mining_count = total_mining_count + 1, updated_at = NOW() "
+        "WHERE user_id = $1 "
+        "RETURNING gold, total_mining_count",
+        [this, user_id, mineral_id, gold_earned, cb = std::move(cb)](AsyncPgResult res) {
+            if (!res.ok() || res.empty()) {
+                spdlog::warn("record_completion_async failed for user {}: {}, retrying on blocking pool", user_id,
+                             res.ok() ? "no row" : res.error());
+                cb(record_completion(user_id, mineral_id, gold_earned));
+                return;
+            }
+            CompletionResult result;
+            result.ok = true;
+            result.total_gold = res.as_u64(0, 0);
+            result.mining_count = res.as_u64(0, 1);
+            cb(result);
+        },
+        user_id, static_cast<int64_t>(gold_earned));
+}
@@ -1,17 +1,26 @@
 #pragma once
 #include "connection_pool.h"
+#include "async_pg_pool.h"
+#include <functional>
 
 class MiningRepository {
 public:
-    explicit MiningRepository(ConnectionPool& pool) : pool_(pool) {}
+    explicit MiningRepository(ConnectionPool& pool, AsyncPgPool* async_pool = nullptr)
+        : pool_(pool), async_pool_(async_pool) {}
 
     struct CompletionResult {
+        bool ok{false}; // false면 골드가 지급되지 않음
         uint64_t total_gold{0};
         uint64_t mining_count{0};
     };
 
     CompletionResult record_completion(const std::string& user_id, uint32_t mineral_id, uint64_t gold_earned);
+    // 단일 UPDATE 문이므로 파이프라인 커넥션에서 트랜잭션 없이 실행 가능
+    // 파이프라인 실패 시 블로킹 record_completion으로 한 번 더 시도한다
+    void record_completion_async(const std::string& user_id, uint32_t mineral_id, uint64_t gold_earned,
+                                 std::function<void(CompletionResult)> cb);
 
 private:
     ConnectionPool& pool_;
+    AsyncPgPool* async_pool_;
 };
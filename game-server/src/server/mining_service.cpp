@@ -57,7 +57,8 @@
 infinitepickaxe::MiningComplete MiningService::handle_complete(const std::string& user_id, uint32_t mineral_id) const {
     uint64_t reward = 0;
     uint32_t respawn = 5;
-    if (auto m = meta_.mineral(mineral_id)) {
+    auto meta = meta_.current();
+    if (auto m = meta->mineral(mineral_id)) {
         reward = m->reward;
         respawn = m->respawn_time;
     }
@@ -76,6 +77,32 @@ infinitepickaxe::MiningComplete MiningService::handle_complete(const std::string
     return comp;
 }
 
+void MiningService::handle_complete_async(const std::string& user_id, uint32_t mineral_id,
+                                          std::function<void(std::optional<infinitepickaxe::MiningComplete>)> cb) const {
+    uint64_t reward = 0;
+    uint32_t respawn = 5;
+    auto meta = meta_.current();
+    if (auto m = meta->mineral(mineral_id)) {
+        reward = m->reward;
+        respawn = m->respawn_time;
+    }
+
+    repo_.record_completion_async(user_id, mineral_id, reward,
+        [mineral_id, reward, respawn, cb = std::move(cb)](MiningRepository::CompletionResult res) {
+            if (!res.ok) {
+                cb(std::nullopt);
+                return;
+            }
+            infinitepickaxe::MiningComplete comp;
+            comp.set_mineral_id(mineral_id);
+            comp.set_gold_earned(reward);
+            comp.set_total_gold(res.total_gold);
+            comp.set_mining_count(res.mining_count);
+            comp.set_respawn_time(respawn);
+            cb(std::move(comp));
+        });
+}
+
 uint64_t MiningService::calculate_user_dps(const std::string& user_id) const {
     // total_dps 캐시를 활용하여 성능 최적화
     auto game_data = game_repo_.get_user_game_data(user_id);
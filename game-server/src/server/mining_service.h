@@ -1,14 +1,16 @@
 #pragma once
 #include "game.pb.h"
 #include <string>
+#include <functional>
+#include <optional>
 #include "mining_repository.h"
 #include "slot_repository.h"
 #include "game_repository.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 
 class MiningService {
 public:
-    MiningService(MiningRepository& repo, SlotRepository& slot_repo, GameRepository& game_repo, const MetadataLoader& meta)
+    MiningService(MiningRepository& repo, SlotRepository& slot_repo, GameRepository& game_repo, const MetadataStore& meta)
         : repo_(repo), slot_repo_(slot_repo), game_repo_(game_repo), meta_(meta) {}
 
     // 서버 권위형 아키텍처로 변경되어 더 이상 사용하지 않음
@@ -16,6 +18,10 @@ public:
     // infinitepickaxe::MiningUpdate handle_sync(const std::string& user_id, uint32_t mineral_id, uint64_t client_hp) const;
 
     infinitepickaxe::MiningComplete handle_complete(const std::string& user_id, uint32_t mineral_id) const;
+    // 틱 루프를 막지 않도록 DB 기록을 비동기로 수행 (콜백은 DB 스레드에서 호출될 수 있음)
+    // 골드 지급에 실패하면 nullopt
+    void handle_complete_async(const std::string& user_id, uint32_t mineral_id,
+                               std::function<void(std::optional<infinitepickaxe::MiningComplete>)> cb) const;
 
 private:
     // 유저의 총 DPS 계산 (total_dps 캐시 활용)
@@ -24,5 +30,5 @@ private:
     MiningRepository& repo_;
     SlotRepository& slot_repo_;
     GameRepository& game_repo_;
-    const MetadataLoader& meta_;
+    const MetadataStore& meta_;
 };
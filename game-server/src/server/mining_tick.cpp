@@ -0,0 +1,9 @@
+#include "mining_tick.h"
+
+void fill_mining_update(const MiningState& state, uint64_t server_timestamp_ms,
+                        infinitepickaxe::MiningUpdate& update) {
+    update.set_mineral_id(state.current_mineral_id);
+    update.set_current_hp(state.current_hp);
+    update.set_max_hp(state.max_hp);
+    update.set_server_timestamp(server_timestamp_ms);
+}
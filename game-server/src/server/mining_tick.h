@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "game.pb.h"
+#include "rng_service.h"
+
+// 각 슬롯의 채굴 상태
+struct SlotMiningState {
+    uint32_t slot_index;          // 0-3
+    uint64_t attack_power;        // 공격력
+    float attack_speed;           // APS (attacks per second)
+    uint32_t critical_hit_percent; // 크리티컬 확률 * 10000
+    uint32_t critical_damage;      // 크리티컬 데미지 * 100
+    float next_attack_timer_ms;   // 다음 공격까지 남은 시간 (밀리초)
+};
+
+// 세션의 채굴 상태
+struct MiningState {
+    bool is_mining = false;
+    uint32_t current_mineral_id = 1;
+    uint64_t current_hp = 0;
+    uint64_t max_hp = 0;
+    std::vector<SlotMiningState> slots;  // 활성화된 슬롯들
+    float respawn_timer_ms = 0.0f;       // 리스폰 대기 중일 때 (5000ms)
+    std::chrono::steady_clock::time_point last_update_time;
+    uint64_t last_sent_hp = std::numeric_limits<uint64_t>::max(); // 마지막으로 전송한 HP (푸시 최소화)
+};
+
+// 슬롯 공격 타이머를 delta_ms만큼 진행하고, 발생한 공격을 update.attacks에 바로 추가한다.
+// (틱마다 호출되는 경로라 중간 vector/메시지 복사 없이 전송할 메시지에 직접 기록)
+// 반환값은 이번 틱의 총 피해량.
+template <typename Rng>
+uint64_t advance_slot_attacks(std::vector<SlotMiningState>& slots, float delta_ms, Rng& crit_rng,
+                              infinitepickaxe::MiningUpdate& update) {
+    uint64_t total_damage = 0;
+    for (auto& slot : slots) {
+        slot.next_attack_timer_ms -= delta_ms;
+
+        // 40ms 동안 여러 번 공격할 수 있음 (attack_speed가 매우 빠른 경우)
+        if (slot.next_attack_timer_ms > 0) continue;
+        const float attack_interval_ms = 1000.0f / std::max(slot.attack_speed, 0.01f);
+        while (slot.next_attack_timer_ms <= 0) {
+            const bool is_crit = RngService::roll_bp_10000(crit_rng) < slot.critical_hit_percent;
+            uint64_t damage = slot.attack_power;
+            if (is_crit) {
+                damage = static_cast<uint64_t>(
+                    (static_cast<long double>(slot.attack_power) * static_cast<long double>(slot.critical_damage)) / 10000.0L);
+            }
+
+            auto* attack = update.add_attacks();
+            attack->set_slot_index(slot.slot_index);
+            attack->set_damage(damage);
+            attack->set_is_critical(is_crit);
+
+            slot.next_attack_timer_ms += attack_interval_ms;
+            total_damage += damage;
+        }
+    }
+    return total_damage;
+}
+
+// MINING_UPDATE의 광물 상태 필드 채우기 (attacks는 건드리지 않음)
+void fill_mining_update(const MiningState& state, uint64_t server_timestamp_ms,
+                        infinitepickaxe::MiningUpdate& update);
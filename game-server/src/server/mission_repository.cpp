@@ -1,4 +1,5 @@
 #include "mission_repository.h"
+#include "game_clock.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -11,16 +12,19 @@
 DailyMissionInfo MissionRepository::get_or_create_daily_mission_info(const std::string& user_id) {
     DailyMissionInfo info;
     info.user_id = user_id;
-    info.mission_date = std::chrono::system_clock::now();
+    info.mission_date = game_clock::now();
     info.completed_count = 0;
     info.reroll_count = 0;
     info.reset_today = false;
 
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
-        auto kst_row = tx.exec1("SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d");
+        // 시뮬레이션 모드에서는 가상 시계의 KST 날짜 기준으로 리셋
+        auto kst_row = tx.exec_params1(
+            "SELECT COALESCE($1::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date)::text AS d",
+            game_clock::kst_date_override());
         auto kst_date_str = kst_row["d"].as<std::string>();
         std::tm tm_kst = {};
         std::istringstream ss_kst(kst_date_str);
@@ -80,16 +84,16 @@ DailyMissionInfo MissionRepository::get_or_create_daily_mission_info(const std::
 
 bool MissionRepository::increment_completed_count(const std::string& user_id, uint32_t count) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
-            "WITH kst_today AS (SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d) "
+            "WITH kst_today AS (SELECT COALESCE($3::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) AS d) "
             "INSERT INTO game_schema.user_mission_daily (user_id, mission_date, completed_count, reroll_count) "
             "SELECT $1, d, $2, 0 FROM kst_today "
             "ON CONFLICT (user_id, mission_date) DO UPDATE "
             "SET completed_count = user_mission_daily.completed_count + $2",
-            user_id, count
+            user_id, count, game_clock::kst_date_override()
         );
 
         tx.commit();
@@ -103,16 +107,16 @@ bool MissionRepository::increment_completed_count(const std::string& user_id, ui
 
 bool MissionRepository::increment_reroll_count(const std::string& user_id) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
-            "WITH kst_today AS (SELECT (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AS d) "
+            "WITH kst_today AS (SELECT COALESCE($2::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) AS d) "
             "INSERT INTO game_schema.user_mission_daily (user_id, mission_date, completed_count, reroll_count) "
             "SELECT $1, d, 0, 1 FROM kst_today "
             "ON CONFLICT (user_id, mission_date) DO UPDATE "
             "SET reroll_count = user_mission_daily.reroll_count + 1",
-            user_id
+            user_id, game_clock::kst_date_override()
         );
 
         tx.commit();
@@ -130,9 +134,10 @@ bool MissionRepository::has_milestone_claimed(const std::string& user_id, uint32
         pqxx::work tx(*conn);
         auto res = tx.exec_params(
             "SELECT 1 FROM game_schema.user_milestones "
-            "WHERE user_id = $1 AND milestone_date = (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date AND milestone_count = $2 "
+            "WHERE user_id = $1 AND milestone_date = COALESCE($3::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) "
+            "AND milestone_count = $2 "
             "LIMIT 1",
-            user_id, milestone_count);
+            user_id, milestone_count, game_clock::kst_date_override());
         tx.commit();
         return !res.empty();
     } catch (const std::exception& ex) {
@@ -143,13 +148,13 @@ bool MissionRepository::has_milestone_claimed(const std::string& user_id, uint32
 
 bool MissionRepository::insert_milestone_claim(const std::string& user_id, uint32_t milestone_count) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         auto res = tx.exec_params(
             "INSERT INTO game_schema.user_milestones (user_id, milestone_date, milestone_count) "
-            "VALUES ($1, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date, $2) "
+            "VALUES ($1, COALESCE($3::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date), $2) "
             "ON CONFLICT DO NOTHING",
-            user_id, milestone_count);
+            user_id, milestone_count, game_clock::kst_date_override());
         tx.commit();
         return res.affected_rows() > 0;
     } catch (const std::exception& ex) {
@@ -162,13 +167,13 @@ bool MissionRepository::insert_milestone_claim(const std::string& user_id, uint3
 std::vector<uint32_t> MissionRepository::get_claimed_milestones(const std::string& user_id) {
     std::vector<uint32_t> milestones;
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
         auto res = tx.exec_params(
             "SELECT milestone_count FROM game_schema.user_milestones "
-            "WHERE user_id = $1 AND milestone_date = (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date "
+            "WHERE user_id = $1 AND milestone_date = COALESCE($2::date, (CURRENT_TIMESTAMP AT TIME ZONE 'Asia/Seoul')::date) "
             "ORDER BY milestone_count",
-            user_id);
+            user_id, game_clock::kst_date_override());
         for (auto row : res) {
             milestones.push_back(row["milestone_count"].as<uint32_t>());
         }
@@ -242,8 +247,8 @@ std::vector<MissionSlot> MissionRepository::get_all_mission_slots(const std::str
     std::vector<MissionSlot> slots;
 
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
 
         auto res = tx.exec_params(
             "SELECT user_id, slot_no, mission_id, mission_type, target_value, current_value, "
@@ -300,7 +305,7 @@ bool MissionRepository::assign_mission_to_slot(const std::string& user_id, uint3
                                                uint32_t mission_id, const std::string& mission_type,
                                                uint32_t target_value, uint32_t reward_crystal) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -329,7 +334,7 @@ bool MissionRepository::assign_mission_to_slot(const std::string& user_id, uint3
 bool MissionRepository::update_mission_progress(const std::string& user_id, uint32_t slot_no,
                                                 uint32_t new_current_value, const std::string& new_status) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -352,7 +357,7 @@ bool MissionRepository::update_mission_progress(const std::string& user_id, uint
 
 bool MissionRepository::complete_mission(const std::string& user_id, uint32_t slot_no) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -373,7 +378,7 @@ bool MissionRepository::complete_mission(const std::string& user_id, uint32_t sl
 
 bool MissionRepository::claim_mission_reward(const std::string& user_id, uint32_t slot_no) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -394,7 +399,7 @@ bool MissionRepository::claim_mission_reward(const std::string& user_id, uint32_
 
 bool MissionRepository::delete_mission_slot(const std::string& user_id, uint32_t slot_no) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         tx.exec_params(
@@ -1,4 +1,5 @@
 #include "mission_service.h"
+#include "rng_service.h"
 #include "ad_service.h"
 #include "time_utils.h"
 #include <spdlog/spdlog.h>
@@ -17,9 +18,9 @@ constexpr int kMissionCacheTtlSeconds = 60 * 60 * 48;
 constexpr int kMissionFlushIntervalSeconds = 60 * 5;
 
 std::string kst_date_key() {
-    auto now = std::chrono::system_clock::now() + std::chrono::hours(9);
+    auto now = game_clock::now() + std::chrono::hours(9);
     std::time_t tt = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::gmtime(&tt);
+    std::tm tm = gmtime_compat(tt);
     char buf[16];
     std::strftime(buf, sizeof(buf), "%Y%m%d", &tm);
     return std::string(buf);
@@ -55,13 +56,14 @@ uint32_t resolve_max_daily_assign(const MetadataLoader& meta) {
 infinitepickaxe::DailyMissionsResponse MissionService::get_missions(const std::string& user_id) {
     infinitepickaxe::DailyMissionsResponse response;
 
+    auto metadata = meta_.current();
     auto daily_info = ensure_daily_state_kst(user_id);
     response.set_completed_count(daily_info.completed_count);
-    const uint32_t free_rerolls = meta_.mission_reroll().free_rerolls_per_day;
+    const uint32_t free_rerolls = metadata->mission_reroll().free_rerolls_per_day;
     const uint32_t free_used = normalize_free_rerolls_used(daily_info.reroll_count, free_rerolls);
     auto ad_counter = ad_service_.get_or_create_ad_counter(user_id, "mission_reroll");
     response.set_rerolls_free(free_rerolls);
-    response.set_rerolls_total_limit(free_rerolls + meta_.mission_reroll().ad_rerolls_per_day);
+    response.set_rerolls_total_limit(free_rerolls + metadata->mission_reroll().ad_rerolls_per_day);
     response.set_reset_timestamp_ms(kst_next_midnight_ms());
     response.set_reroll_count(free_used + ad_counter.ad_count);
 
@@ -90,7 +92,7 @@ infinitepickaxe::DailyMissionsResponse MissionService::get_missions(const std::s
     }
 
     for (const auto& slot : slots) {
-        const MissionMeta* meta = get_mission_meta_for_slot(slot);
+        const MissionMeta* meta = get_mission_meta_for_slot(*metadata, slot);
 
         auto* entry = response.add_missions();
         entry->set_slot_no(slot.slot_no);
@@ -129,7 +131,7 @@ infinitepickaxe::MissionCompleteResult MissionService::claim_mission_reward(
     result.set_slot_no(slot_no);
 
     auto daily_info = ensure_daily_state_kst(user_id);
-    const uint32_t max_daily_assign = resolve_max_daily_assign(meta_);
+    const uint32_t max_daily_assign = resolve_max_daily_assign(*meta_.current());
     if (max_daily_assign > 0 && daily_info.completed_count >= max_daily_assign) {
         result.set_error_code("DAILY_LIMIT_REACHED");
         return result;
@@ -222,14 +224,15 @@ infinitepickaxe::MissionRerollResult MissionService::reroll_missions_internal(
     infinitepickaxe::MissionRerollResult result;
     result.set_success(false);
 
+    auto metadata = meta_.current();
     auto daily_info = ensure_daily_state_kst(user_id);
-    const uint32_t max_daily_assign = resolve_max_daily_assign(meta_);
+    const uint32_t max_daily_assign = resolve_max_daily_assign(*metadata);
     if (max_daily_assign > 0 && daily_info.completed_count >= max_daily_assign) {
         result.set_error_code("DAILY_LIMIT_REACHED");
         return result;
     }
 
-    const auto reroll_meta = meta_.mission_reroll();
+    const auto reroll_meta = metadata->mission_reroll();
     const uint32_t free_rerolls = reroll_meta.free_rerolls_per_day;
     const uint32_t free_used = normalize_free_rerolls_used(daily_info.reroll_count, free_rerolls);
     auto ad_counter = ad_service_.get_or_create_ad_counter(user_id, "mission_reroll");
@@ -259,7 +262,7 @@ infinitepickaxe::MissionRerollResult MissionService::reroll_missions_internal(
     auto slots = repo_.get_all_mission_slots(user_id);
     cache_slots(user_id, slots);
     for (const auto& slot : slots) {
-        const MissionMeta* meta = get_mission_meta_for_slot(slot);
+        const MissionMeta* meta = get_mission_meta_for_slot(*metadata, slot);
         auto* entry = result.add_rerolled_missions();
         entry->set_slot_no(slot.slot_no);
         entry->set_mission_id(slot.mission_id);
@@ -296,8 +299,9 @@ infinitepickaxe::MilestoneClaimResult MissionService::handle_milestone_claim(
     res.set_success(false);
     res.set_milestone_count(milestone_count);
 
+    auto metadata = meta_.current();
     uint32_t bonus_hours = 0;
-    for (const auto& m : meta_.milestone_bonuses()) {
+    for (const auto& m : metadata->milestone_bonuses()) {
         if (m.completed == milestone_count) {
             bonus_hours = m.bonus_hours;
             break;
@@ -326,7 +330,7 @@ infinitepickaxe::MilestoneClaimResult MissionService::handle_milestone_claim(
     }
 
     uint32_t bonus_seconds = bonus_hours * 3600;
-    uint32_t initial_seconds = meta_.offline_defaults().initial_offline_seconds;
+    uint32_t initial_seconds = metadata->offline_defaults().initial_offline_seconds;
     auto updated_seconds = offline_repo_.add_offline_seconds(user_id, bonus_seconds, initial_seconds);
     if (!updated_seconds.has_value()) {
         res.set_error_code("DB_ERROR");
@@ -451,7 +455,8 @@ bool MissionService::assign_random_missions_unique(const std::string& user_id, u
 
 bool MissionService::assign_random_mission(const std::string& user_id, uint32_t slot_no,
                                            std::unordered_set<uint32_t>& used_meta_ids) {
-    const auto& missions = meta_.missions();
+    auto metadata = meta_.current();
+    const auto& missions = metadata->missions();
     if (missions.empty()) {
         spdlog::error("assign_random_mission: no missions in metadata");
         return false;
@@ -470,7 +475,7 @@ bool MissionService::assign_random_mission(const std::string& user_id, uint32_t
         else medium.push_back(&m); // default medium
     }
 
-    auto choose_pool = [&](std::mt19937& rng) -> std::vector<const MissionMeta*>* {
+    auto choose_pool = [&](Xoshiro256ss& rng) -> std::vector<const MissionMeta*>* {
         struct Pool { std::vector<const MissionMeta*>* vec; uint32_t weight; };
         std::vector<Pool> pools;
         if (!easy.empty()) pools.push_back({&easy, 50});
@@ -490,7 +495,7 @@ bool MissionService::assign_random_mission(const std::string& user_id, uint32_t
         return pools.back().vec;
     };
 
-    static std::mt19937 rng(std::random_device{}());
+    auto& rng = RngService::thread_rng();
     auto pool = choose_pool(rng);
     if (!pool || pool->empty()) {
         spdlog::warn("assign_random_mission: no pool available after filtering");
@@ -513,28 +518,29 @@ bool MissionService::assign_random_mission(const std::string& user_id, uint32_t
     return success;
 }
 
-const MissionMeta* MissionService::get_mission_meta_by_id(uint32_t meta_id) const {
-    for (const auto& m : meta_.missions()) {
+const MissionMeta* MissionService::get_mission_meta_by_id(const MetadataLoader& metadata, uint32_t meta_id) const {
+    for (const auto& m : metadata.missions()) {
         if (m.id == meta_id) return &m;
     }
     return nullptr;
 }
 
-const MissionMeta* MissionService::get_mission_meta_for_slot(const MissionSlot& slot) const {
-    return get_mission_meta_by_id(slot.mission_id);
+const MissionMeta* MissionService::get_mission_meta_for_slot(const MetadataLoader& metadata, const MissionSlot& slot) const {
+    return get_mission_meta_by_id(metadata, slot.mission_id);
 }
 
 std::vector<infinitepickaxe::MissionProgressUpdate> MissionService::apply_progress_delta(
     const std::string& user_id,
     const std::function<uint64_t(const MissionSlot&, const MissionMeta*)>& delta_fn) {
     std::vector<infinitepickaxe::MissionProgressUpdate> updates;
+    auto metadata = meta_.current();
     auto slots = load_cached_slots(user_id);
     bool any_updated = false;
     for (auto& slot : slots) {
         if (slot.status != "active") {
             continue;
         }
-        const MissionMeta* meta = get_mission_meta_for_slot(slot);
+        const MissionMeta* meta = get_mission_meta_for_slot(*metadata, slot);
         uint64_t delta = delta_fn(slot, meta);
         if (delta == 0) {
             continue;
@@ -659,7 +665,7 @@ void MissionService::update_slot_cache(const std::string& user_id, const Mission
 
 bool MissionService::flush_slots_if_due(const std::string& user_id, const std::vector<MissionSlot>& slots) {
     const std::string key = "mission:flush:" + user_id + ":" + kst_date_key();
-    auto now = std::chrono::system_clock::now();
+    auto now = game_clock::now();
     auto now_seconds = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
 
     auto last_str = redis_.get_string(key);
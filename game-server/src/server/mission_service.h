@@ -1,7 +1,7 @@
 #pragma once
 #include "game.pb.h"
 #include "mission_repository.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include "game_repository.h"
 #include "offline_repository.h"
 #include "redis_client.h"
@@ -16,7 +16,7 @@ class AdService;
 class MissionService {
 public:
     MissionService(MissionRepository& repo, GameRepository& game_repo, OfflineRepository& offline_repo,
-                   AdService& ad_service, const MetadataLoader& meta, RedisClient& redis)
+                   AdService& ad_service, const MetadataStore& meta, RedisClient& redis)
         : repo_(repo), game_repo_(game_repo), offline_repo_(offline_repo),
           ad_service_(ad_service), meta_(meta), redis_(redis) {}
 
@@ -47,8 +47,9 @@ private:
     bool assign_random_missions_unique(const std::string& user_id, uint32_t count);
     bool assign_random_mission(const std::string& user_id, uint32_t slot_no,
                                std::unordered_set<uint32_t>& used_meta_ids);
-    const MissionMeta* get_mission_meta_by_id(uint32_t meta_id) const;
-    const MissionMeta* get_mission_meta_for_slot(const MissionSlot& slot) const;
+    // 반환 포인터는 전달한 스냅샷이 살아 있는 동안만 유효
+    const MissionMeta* get_mission_meta_by_id(const MetadataLoader& metadata, uint32_t meta_id) const;
+    const MissionMeta* get_mission_meta_for_slot(const MetadataLoader& metadata, const MissionSlot& slot) const;
     std::vector<infinitepickaxe::MissionProgressUpdate> apply_progress_delta(
         const std::string& user_id,
         const std::function<uint64_t(const MissionSlot&, const MissionMeta*)>& delta_fn);
@@ -67,6 +68,6 @@ private:
     GameRepository& game_repo_;
     OfflineRepository& offline_repo_;
     AdService& ad_service_;
-    const MetadataLoader& meta_;
+    const MetadataStore& meta_;
     RedisClient& redis_;
 };
@@ -1,9 +1,11 @@
 #include "offline_repository.h"
+#include "game_clock.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <tuple>
 
 namespace {
 std::chrono::system_clock::time_point parse_date(const std::string& date_str) {
@@ -18,21 +20,21 @@ OfflineState OfflineRepository::get_or_create_state(const std::string& user_id,
     OfflineState state;
     state.user_id = user_id;
     state.current_offline_seconds = initial_seconds;
-    state.offline_date = std::chrono::system_clock::now();
+    state.offline_date = game_clock::now();
 
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         auto row = tx.exec_params1(
             "INSERT INTO game_schema.user_offline_state (user_id, offline_date, current_offline_hours) "
-            "VALUES ($1, CURRENT_DATE, $2) "
+            "VALUES ($1, COALESCE($3::date, CURRENT_DATE), $2) "
             "ON CONFLICT (user_id) DO UPDATE "
-            "SET current_offline_hours = CASE WHEN user_offline_state.offline_date < CURRENT_DATE THEN $2 "
+            "SET current_offline_hours = CASE WHEN user_offline_state.offline_date < COALESCE($3::date, CURRENT_DATE) THEN $2 "
             "                                    ELSE user_offline_state.current_offline_hours END, "
-            "    offline_date = CASE WHEN user_offline_state.offline_date < CURRENT_DATE THEN CURRENT_DATE "
+            "    offline_date = CASE WHEN user_offline_state.offline_date < COALESCE($3::date, CURRENT_DATE) THEN COALESCE($3::date, CURRENT_DATE) "
             "                         ELSE user_offline_state.offline_date END "
             "RETURNING offline_date, current_offline_hours",
-            user_id, static_cast<int64_t>(initial_seconds));
+            user_id, static_cast<int64_t>(initial_seconds), game_clock::kst_date_override());
 
         state.current_offline_seconds = row["current_offline_hours"].as<uint32_t>();
         state.offline_date = parse_date(row["offline_date"].as<std::string>());
@@ -46,20 +48,21 @@ OfflineState OfflineRepository::get_or_create_state(const std::string& user_id,
 
 std::optional<uint32_t> OfflineRepository::add_offline_seconds(const std::string& user_id, uint32_t delta_seconds, uint32_t initial_seconds) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         auto row = tx.exec_params1(
             "INSERT INTO game_schema.user_offline_state (user_id, offline_date, current_offline_hours) "
-            "VALUES ($1, CURRENT_DATE, $3::integer + $2::integer) "
+            "VALUES ($1, COALESCE($4::date, CURRENT_DATE), $3::integer + $2::integer) "
             "ON CONFLICT (user_id) DO UPDATE "
-            "SET current_offline_hours = (CASE WHEN user_offline_state.offline_date < CURRENT_DATE THEN $3::integer "
+            "SET current_offline_hours = (CASE WHEN user_offline_state.offline_date < COALESCE($4::date, CURRENT_DATE) THEN $3::integer "
             "                                   ELSE user_offline_state.current_offline_hours END) + $2::integer, "
-            "    offline_date = CASE WHEN user_offline_state.offline_date < CURRENT_DATE THEN CURRENT_DATE "
+            "    offline_date = CASE WHEN user_offline_state.offline_date < COALESCE($4::date, CURRENT_DATE) THEN COALESCE($4::date, CURRENT_DATE) "
             "                         ELSE user_offline_state.offline_date END "
             "RETURNING current_offline_hours",
             user_id,
             static_cast<int64_t>(delta_seconds),
-            static_cast<int64_t>(initial_seconds));
+            static_cast<int64_t>(initial_seconds),
+            game_clock::kst_date_override());
 
         uint32_t total = row["current_offline_hours"].as<uint32_t>();
         tx.commit();
@@ -69,3 +72,43 @@ std::optional<uint32_t> OfflineRepository::add_offline_seconds(const std::string
         return std::nullopt;
     }
 }
+
+std::optional<OfflineClaimResult> OfflineRepository::claim_reward(
+    const std::string& user_id, uint32_t initial_seconds,
+    const std::function<std::pair<uint64_t, uint64_t>(uint32_t)>& reward_for_seconds) {
+    try {
+        auto conn = pool_.acquire_write(user_id);
+        pqxx::work tx(*conn);
+        // 일일 리셋 반영 + 행 잠금 (ON CONFLICT DO UPDATE가 트랜잭션 끝까지 잠금 유지)
+        auto state = tx.exec_params1(
+            "INSERT INTO game_schema.user_offline_state (user_id, offline_date, current_offline_hours) "
+            "VALUES ($1, COALESCE($3::date, CURRENT_DATE), $2) "
+            "ON CONFLICT (user_id) DO UPDATE "
+            "SET current_offline_hours = CASE WHEN user_offline_state.offline_date < COALESCE($3::date, CURRENT_DATE) THEN $2 "
+            "                                    ELSE user_offline_state.current_offline_hours END, "
+            "    offline_date = CASE WHEN user_offline_state.offline_date < COALESCE($3::date, CURRENT_DATE) THEN COALESCE($3::date, CURRENT_DATE) "
+            "                         ELSE user_offline_state.offline_date END "
+            "RETURNING current_offline_hours",
+            user_id, static_cast<int64_t>(initial_seconds), game_clock::kst_date_override());
+
+        OfflineClaimResult result;
+        result.claimed_seconds = state["current_offline_hours"].as<uint32_t>();
+        std::tie(result.gold_earned, result.mining_count) = reward_for_seconds(result.claimed_seconds);
+
+        tx.exec_params0(
+            "UPDATE game_schema.user_offline_state SET current_offline_hours = 0 WHERE user_id = $1",
+            user_id);
+        auto gold = tx.exec_params1(
+            "UPDATE game_schema.user_game_data "
+            "SET gold = gold + $2, total_mining_count = total_mining_count + $3, updated_at = NOW() "
+            "WHERE user_id = $1 "
+            "RETURNING gold",
+            user_id, static_cast<int64_t>(result.gold_earned), static_cast<int64_t>(result.mining_count));
+        result.total_gold = gold[0].as<int64_t>();
+        tx.commit();
+        return result;
+    } catch (const std::exception& ex) {
+        spdlog::error("claim_reward failed: user={} error={}", user_id, ex.what());
+        return std::nullopt;
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "connection_pool.h"
 #include <chrono>
+#include <functional>
 #include <optional>
 #include <string>
 
@@ -10,6 +11,14 @@ struct OfflineState {
     uint32_t current_offline_seconds{0}; // DB: seconds stored in current_offline_hours 컬럼
 };
 
+// 오프라인 보상 수령 결과 (소모한 초 + 지급한 골드/채굴 횟수)
+struct OfflineClaimResult {
+    uint32_t claimed_seconds{0};
+    uint64_t gold_earned{0};
+    uint64_t mining_count{0};
+    uint64_t total_gold{0};
+};
+
 class OfflineRepository {
 public:
     explicit OfflineRepository(ConnectionPool& pool) : pool_(pool) {}
@@ -17,6 +26,12 @@ public:
     OfflineState get_or_create_state(const std::string& user_id, uint32_t initial_seconds);
     std::optional<uint32_t> add_offline_seconds(const std::string& user_id, uint32_t delta_seconds, uint32_t initial_seconds);
 
+    // 오프라인 시간을 한 트랜잭션에서 소모하고 보상 지급 (중복 수령 방지: 행 잠금 후 0으로)
+    // reward_for_seconds: 소모할 초 → (골드, 채굴 횟수)
+    std::optional<OfflineClaimResult> claim_reward(
+        const std::string& user_id, uint32_t initial_seconds,
+        const std::function<std::pair<uint64_t, uint64_t>(uint32_t)>& reward_for_seconds);
+
 private:
     ConnectionPool& pool_;
 };
@@ -0,0 +1,265 @@
+#include "offline_reward.h"
+#include "metadata/metadata_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace {
+
+// 치명타 조합을 정확히 나열하는 최대 경우의 수 (그 이상은 정규 근사)
+constexpr double kExactCombinationLimit = 512.0;
+// 적분 구간 폭 (기대 타수 ± 표준편차 배수)
+constexpr double kWindowSigma = 8.0;
+// 기대 타수가 이보다 많으면 E[t_N] ≈ (E[N] - 1/2)/λ (오차 O(1/N))
+constexpr double kAsymptoticHits = 256.0;
+
+// 같은 (공격력, 치명 피해, 치명 확률) 슬롯 묶음: 타격 c회 피해 = c·normal + K·(crit - normal), K ~ Bin(c, p)
+struct DamageGroup {
+    uint64_t normal{0};
+    uint64_t crit{0};
+    double p{0.0};
+};
+
+double interval_ms(const SlotMiningState& slot) {
+    return 1000.0 / static_cast<double>(std::max(slot.attack_speed, 0.01f));
+}
+
+// advance_slot_attacks와 같은 치명타 피해 (절사)
+uint64_t crit_damage(const SlotMiningState& slot) {
+    return static_cast<uint64_t>((static_cast<long double>(slot.attack_power) *
+                                  static_cast<long double>(slot.critical_damage)) / 10000.0L);
+}
+
+double crit_chance(const SlotMiningState& slot) {
+    return std::min(static_cast<double>(slot.critical_hit_percent), 10000.0) / 10000.0;
+}
+
+bool deterministic(const DamageGroup& g) {
+    return g.p <= 0.0 || g.p >= 1.0 || g.normal == g.crit;
+}
+
+// Bin(n, p) 확률표
+std::vector<double> binomial_row(uint64_t n, double p) {
+    std::vector<double> row(n + 1);
+    row[0] = std::pow(1.0 - p, static_cast<double>(n));
+    for (uint64_t k = 0; k < n; ++k) {
+        row[k + 1] = row[k] * static_cast<double>(n - k) / static_cast<double>(k + 1) * p / (1.0 - p);
+    }
+    return row;
+}
+
+// 묶음별 타격 수가 counts일 때 P(누적 피해 < H), 같은 counts는 캐시
+class DamageBelow {
+public:
+    DamageBelow(std::vector<DamageGroup> groups, uint64_t hp) : groups_(std::move(groups)), hp_(hp) {}
+
+    double operator()(const std::vector<uint64_t>& counts) {
+        auto it = cache_.find(counts);
+        if (it != cache_.end()) return it->second;
+        const double value = compute(counts);
+        cache_.emplace(counts, value);
+        return value;
+    }
+
+private:
+    struct Term {
+        uint64_t n;
+        long double normal;
+        long double crit;
+        std::vector<double> pmf;
+    };
+
+    double compute(const std::vector<uint64_t>& counts) const {
+        long double fixed = 0.0L;
+        double combinations = 1.0;
+        std::vector<std::size_t> random;
+        for (std::size_t i = 0; i < groups_.size(); ++i) {
+            if (counts[i] == 0) continue;
+            const auto& g = groups_[i];
+            if (deterministic(g)) {
+                fixed += static_cast<long double>(counts[i]) * (g.p >= 1.0 ? g.crit : g.normal);
+            } else {
+                random.push_back(i);
+                combinations *= static_cast<double>(counts[i] + 1);
+            }
+        }
+        if (random.empty()) return fixed < static_cast<long double>(hp_) ? 1.0 : 0.0;
+
+        if (combinations <= kExactCombinationLimit) {
+            std::vector<Term> terms;
+            for (std::size_t i : random) {
+                const auto& g = groups_[i];
+                terms.push_back({counts[i], static_cast<long double>(g.normal), static_cast<long double>(g.crit),
+                                 binomial_row(counts[i], g.p)});
+            }
+            // 남은 묶음의 최소/최대 피해 (가지치기용)
+            std::vector<long double> rest_min(terms.size() + 1, 0.0L);
+            std::vector<long double> rest_max(terms.size() + 1, 0.0L);
+            for (std::size_t j = terms.size(); j-- > 0;) {
+                const long double n = static_cast<long double>(terms[j].n);
+                rest_min[j] = rest_min[j + 1] + n * std::min(terms[j].normal, terms[j].crit);
+                rest_max[j] = rest_max[j + 1] + n * std::max(terms[j].normal, terms[j].crit);
+            }
+            return enumerate(terms, rest_min, rest_max, 0, fixed, 1.0);
+        }
+
+        // 정규 근사 (연속성 보정: 정수 피해 S < H ⇔ S ≤ H - 1)
+        double mean = static_cast<double>(fixed);
+        double variance = 0.0;
+        for (std::size_t i : random) {
+            const auto& g = groups_[i];
+            const auto c = static_cast<double>(counts[i]);
+            const double spread = static_cast<double>(g.crit) - static_cast<double>(g.normal);
+            mean += c * (static_cast<double>(g.normal) + g.p * spread);
+            variance += c * g.p * (1.0 - g.p) * spread * spread;
+        }
+        const double z = (static_cast<double>(hp_) - 0.5 - mean) / std::sqrt(variance);
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+
+    double enumerate(const std::vector<Term>& terms, const std::vector<long double>& rest_min,
+                     const std::vector<long double>& rest_max, std::size_t index, long double partial,
+                     double weight) const {
+        const auto hp = static_cast<long double>(hp_);
+        if (partial + rest_min[index] >= hp) return 0.0;
+        if (partial + rest_max[index] < hp) return weight;
+        const auto& term = terms[index];
+        double below = 0.0;
+        for (uint64_t k = 0; k <= term.n; ++k) {
+            const long double damage = static_cast<long double>(term.n - k) * term.normal +
+                                       static_cast<long double>(k) * term.crit;
+            below += enumerate(terms, rest_min, rest_max, index + 1, partial + damage, weight * term.pmf[k]);
+        }
+        return below;
+    }
+
+    std::vector<DamageGroup> groups_;
+    uint64_t hp_;
+    std::map<std::vector<uint64_t>, double> cache_;
+};
+
+} // namespace
+
+OfflineRewardEstimate estimate_offline_reward(const std::vector<SlotMiningState>& slots,
+                                              const MineralMeta& mineral,
+                                              uint64_t offline_seconds,
+                                              float tick_ms) {
+    OfflineRewardEstimate estimate;
+    if (slots.empty() || mineral.hp == 0 || offline_seconds == 0 || tick_ms <= 0.0f) return estimate;
+
+    // 피해 분포가 같은 슬롯끼리 묶음 (동일 슬롯 k개 = 이항분포 하나)
+    std::vector<DamageGroup> groups;
+    std::vector<std::size_t> group_of;
+    std::vector<double> periods;
+    double rate_per_ms = 0.0; // 전체 공격 빈도 λ
+    double mean = 0.0;        // 타당 기대 피해 μ
+    double second = 0.0;      // 타당 피해 제곱 기대값 E[X²]
+    uint64_t min_damage = std::numeric_limits<uint64_t>::max();
+    uint64_t max_damage = 0;
+    for (const auto& slot : slots) {
+        const DamageGroup g{slot.attack_power, crit_damage(slot), crit_chance(slot)};
+        auto it = std::find_if(groups.begin(), groups.end(), [&](const DamageGroup& o) {
+            return o.normal == g.normal && o.crit == g.crit && o.p == g.p;
+        });
+        group_of.push_back(static_cast<std::size_t>(it - groups.begin()));
+        if (it == groups.end()) groups.push_back(g);
+
+        const double period = interval_ms(slot);
+        const double rate = 1.0 / period;
+        const auto normal = static_cast<double>(g.normal);
+        const auto crit = static_cast<double>(g.crit);
+        periods.push_back(period);
+        rate_per_ms += rate;
+        mean += rate * ((1.0 - g.p) * normal + g.p * crit);
+        second += rate * ((1.0 - g.p) * normal * normal + g.p * crit * crit);
+        if (g.p < 1.0) {
+            min_damage = std::min(min_damage, g.normal);
+            max_damage = std::max(max_damage, g.normal);
+        }
+        if (g.p > 0.0) {
+            min_damage = std::min(min_damage, g.crit);
+            max_damage = std::max(max_damage, g.crit);
+        }
+    }
+    if (min_damage == 0) return estimate;
+    mean /= rate_per_ms;
+    second /= rate_per_ms;
+
+    const auto hp = static_cast<double>(mineral.hp);
+    const auto most_hits = static_cast<double>((mineral.hp + min_damage - 1) / min_damage);
+    const auto fewest_hits = static_cast<double>((mineral.hp + max_damage - 1) / max_damage);
+    estimate.expected_hits = std::clamp(hp / mean + second / (2.0 * mean * mean), fewest_hits, most_hits);
+
+    double kill_hit_ms = (estimate.expected_hits - 0.5) / rate_per_ms;
+    if (estimate.expected_hits <= kAsymptoticHits) {
+        // 처치 타격 시각 E[t_N] = ∫ P(S(t) < H) dt
+        // 슬롯 i의 [0, t] 타격 수 = floor(t/T_i) + Bernoulli(frac(t/T_i)) (위상이 [0, T_i)에서 균등)이고
+        // 피해는 타격 수가 정해지면 시각과 독립 → T_i 배수 사이에서 2^k개 경우의 확률이 t의 다항식
+        const auto k = static_cast<double>(slots.size());
+        const double sigma_hits = std::sqrt(estimate.expected_hits * std::max(second - mean * mean, 0.0)) / mean;
+        const double lo = std::max({0.0, (fewest_hits - k - 1.0) / rate_per_ms,
+                                    (estimate.expected_hits - kWindowSigma * sigma_hits - k - 1.0) / rate_per_ms});
+        const double hi = std::min((most_hits + k) / rate_per_ms,
+                                   (estimate.expected_hits + kWindowSigma * sigma_hits + k + 1.0) / rate_per_ms);
+
+        std::vector<double> cuts{lo, hi};
+        for (double period : periods) {
+            for (double c = std::ceil(lo / period) * period; c < hi; c += period) cuts.push_back(c);
+        }
+        std::sort(cuts.begin(), cuts.end());
+
+        DamageBelow below(groups, mineral.hp);
+        std::vector<uint64_t> base(slots.size());
+        std::vector<double> frac(slots.size());
+        std::vector<uint64_t> counts(groups.size());
+        auto survival = [&](double t) {
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                const double whole = std::floor(t / periods[i]);
+                base[i] = static_cast<uint64_t>(whole);
+                frac[i] = t / periods[i] - whole;
+            }
+            double total = 0.0;
+            for (uint32_t mask = 0; mask < (1u << slots.size()); ++mask) {
+                double weight = 1.0;
+                std::fill(counts.begin(), counts.end(), 0);
+                for (std::size_t i = 0; i < slots.size(); ++i) {
+                    const bool extra = (mask >> i) & 1u;
+                    weight *= extra ? frac[i] : 1.0 - frac[i];
+                    counts[group_of[i]] += base[i] + (extra ? 1 : 0);
+                }
+                if (weight > 0.0) total += weight * below(counts);
+            }
+            return total;
+        };
+
+        // 3점 가우스-르장드르: 5차까지 정확 (슬롯 4개 → 구간 내 4차 다항식)
+        static const double kNodes[3] = {-0.7745966692414834, 0.0, 0.7745966692414834};
+        static const double kWeights[3] = {5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0};
+        kill_hit_ms = lo; // lo 이전은 확률 1
+        for (std::size_t i = 0; i + 1 < cuts.size(); ++i) {
+            const double a = cuts[i];
+            const double b = cuts[i + 1];
+            if (b <= a) continue;
+            const double mid = (a + b) / 2.0;
+            const double half = (b - a) / 2.0;
+            for (int q = 0; q < 3; ++q) kill_hit_ms += half * kWeights[q] * survival(mid + half * kNodes[q]);
+        }
+    }
+
+    // 처치 판정은 그 타격이 속한 틱 끝 (평균 반 틱 뒤)
+    const double tick = static_cast<double>(tick_ms);
+    const double kill_ms = kill_hit_ms + tick / 2.0;
+    // 리스폰 타이머는 처치 틱에 설정되어 매 틱 감소, 0 이하가 된 틱에 새 광물 (최소 1틱)
+    const double respawn_ticks = std::max(1.0, std::ceil(static_cast<double>(mineral.respawn_time) * 1000.0 / tick));
+    const double cycle_ms = kill_ms + respawn_ticks * tick;
+
+    estimate.kill_seconds = kill_ms / 1000.0;
+    estimate.cycle_seconds = cycle_ms / 1000.0;
+    const double total_ms = static_cast<double>(offline_seconds) * 1000.0;
+    if (total_ms >= kill_ms) {
+        estimate.kills = 1 + static_cast<uint64_t>((total_ms - kill_ms) / cycle_ms);
+    }
+    estimate.gold = estimate.kills * mineral.reward;
+    return estimate;
+}
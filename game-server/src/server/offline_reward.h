@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "mining_tick.h"
+
+struct MineralMeta;
+
+// 오프라인 보상 계산 (틱 시뮬레이션 없이 닫힌 식으로)
+// Session::update_mining_tick을 offline_seconds 동안 돌린 것과 같은 기대값을 낸다:
+// - 광물마다 슬롯 공격 위상이 새로 랜덤 (start_new_mineral → refresh_slots_from_service)
+// - 처치 판정은 틱 끝, 리스폰은 틱 단위로 카운트다운 후 다음 틱부터 공격
+// 처치 1회 = E[처치 타격 시각] + (틱 양자화) + (리스폰 틱 수 * 틱)
+// E[처치 타격 시각] = ∫ P(t까지 누적 피해 < HP) dt 를 슬롯 주기 경계 사이 구간별로 적분
+// (구간 안에서 슬롯별 타격 수는 두 값 중 하나, 치명타 조합은 적으면 나열하고 많으면 정규 근사)
+// 검증: tools/offline_reward_check.cpp (같은 입력으로 틱 시뮬레이션과 비교)
+struct OfflineRewardEstimate {
+    uint64_t kills{0};
+    uint64_t gold{0};
+    double expected_hits{0.0};      // 광물 1개당 기대 타수 (갱신 이론 근사, 보고용)
+    double kill_seconds{0.0};       // 광물 생성 → 처치 판정까지 기대 시간
+    double cycle_seconds{0.0};      // 처치 간격 (리스폰 포함)
+};
+
+OfflineRewardEstimate estimate_offline_reward(const std::vector<SlotMiningState>& slots,
+                                              const MineralMeta& mineral,
+                                              uint64_t offline_seconds,
+                                              float tick_ms = 40.0f);
@@ -1,17 +1,63 @@
 #include "offline_service.h"
+#include "offline_reward.h"
+#include <algorithm>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace {
+// Session::refresh_slots_from_service와 같은 규칙으로 해금 슬롯만 채굴 상태로 변환
+std::vector<SlotMiningState> to_mining_slots(const infinitepickaxe::AllSlotsResponse& response) {
+    std::vector<SlotMiningState> slots;
+    for (const auto& info : response.slots()) {
+        if (!info.is_unlocked()) continue;
+        SlotMiningState slot{};
+        slot.slot_index = info.slot_index();
+        slot.attack_power = info.attack_power();
+        slot.attack_speed = std::max(static_cast<float>(info.attack_speed_x100()) / 100.0f, 0.01f);
+        slot.critical_hit_percent = info.critical_hit_percent();
+        slot.critical_damage = info.critical_damage();
+        slots.push_back(slot);
+    }
+    return slots;
+}
+} // namespace
 
 OfflineState OfflineService::get_state(const std::string& user_id) {
-    uint32_t initial_seconds = meta_.offline_defaults().initial_offline_seconds;
+    uint32_t initial_seconds = meta_.current()->offline_defaults().initial_offline_seconds;
     return repo_.get_or_create_state(user_id, initial_seconds);
 }
 
 infinitepickaxe::OfflineRewardResult OfflineService::handle_request(const std::string& user_id) {
-    // TODO: 오프라인 전투 보상 계산 로직 추가
-    auto state = get_state(user_id);
+    auto meta = meta_.current();
+    const uint32_t initial_seconds = meta->offline_defaults().initial_offline_seconds;
     infinitepickaxe::OfflineRewardResult res;
-    res.set_elapsed_seconds(state.current_offline_seconds);
-    res.set_gold_earned(0);
-    res.set_mining_count(0);
-    res.set_total_gold(0);
+
+    // 채굴 중인 광물이 없으면 오프라인 시간을 소모하지 않음
+    const auto game_data = game_repo_.get_user_game_data(user_id);
+    const uint32_t mineral_id = game_data.current_mineral_id.value_or(0);
+    const auto* mineral = mineral_id != 0 ? meta->mineral(mineral_id) : nullptr;
+    const auto slots = to_mining_slots(slot_service_.handle_all_slots(user_id));
+    if (!mineral || slots.empty()) {
+        res.set_elapsed_seconds(repo_.get_or_create_state(user_id, initial_seconds).current_offline_seconds);
+        res.set_total_gold(game_data.gold);
+        return res;
+    }
+
+    auto claim = repo_.claim_reward(user_id, initial_seconds, [&](uint32_t seconds) {
+        const auto estimate = estimate_offline_reward(slots, *mineral, seconds);
+        return std::make_pair(estimate.gold, estimate.kills);
+    });
+    if (!claim) {
+        res.set_total_gold(game_data.gold);
+        return res;
+    }
+
+    spdlog::info("Offline reward: user={} mineral={} seconds={} kills={} gold={}",
+                 user_id, mineral_id, claim->claimed_seconds, claim->mining_count, claim->gold_earned);
+    res.set_elapsed_seconds(claim->claimed_seconds);
+    res.set_gold_earned(claim->gold_earned);
+    res.set_mining_count(static_cast<uint32_t>(
+        std::min<uint64_t>(claim->mining_count, std::numeric_limits<uint32_t>::max())));
+    res.set_total_gold(claim->total_gold);
     return res;
 }
@@ -1,15 +1,20 @@
 #pragma once
 #include "game.pb.h"
 #include "offline_repository.h"
-#include "metadata/metadata_loader.h"
+#include "slot_service.h"
+#include "game_repository.h"
+#include "metadata/metadata_store.h"
 
 class OfflineService {
 public:
-    OfflineService(OfflineRepository& repo, const MetadataLoader& meta)
-        : repo_(repo), meta_(meta) {}
+    OfflineService(OfflineRepository& repo, SlotService& slot_service, GameRepository& game_repo,
+                   const MetadataStore& meta)
+        : repo_(repo), slot_service_(slot_service), game_repo_(game_repo), meta_(meta) {}
     OfflineState get_state(const std::string& user_id);
     infinitepickaxe::OfflineRewardResult handle_request(const std::string& user_id);
 private:
     OfflineRepository& repo_;
-    const MetadataLoader& meta_;
+    SlotService& slot_service_;
+    GameRepository& game_repo_;
+    const MetadataStore& meta_;
 };
@@ -0,0 +1,18 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// 기대 DPS = 공격력 * APS * (1 + 치명 확률 * (치명 배율 - 1))
+// attack_speed_x100: APS * 100, crit_percent/crit_damage: basis 10000
+// 결과가 0이면 fallback_dps를 쓴다 (메타데이터 기본값 등)
+inline uint64_t compute_expected_dps(uint64_t attack_power, uint32_t attack_speed_x100,
+                                     uint32_t crit_percent, uint32_t crit_damage,
+                                     uint64_t fallback_dps = 0) {
+    double attack_speed = static_cast<double>(attack_speed_x100) / 100.0;
+    double crit_rate = static_cast<double>(crit_percent) / 10000.0;
+    double crit_mult = static_cast<double>(crit_damage) / 10000.0;
+    double expected = static_cast<double>(attack_power) * attack_speed *
+                      (1.0 + crit_rate * (crit_mult - 1.0));
+    uint64_t dps = static_cast<uint64_t>(std::llround(expected));
+    return dps == 0 ? fallback_dps : dps;
+}
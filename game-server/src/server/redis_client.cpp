@@ -1,4 +1,6 @@
 #include "redis_client.h"
+#include "metrics.h"
+#include "request_trace.h"
 #include <sw/redis++/redis++.h>
 #include <spdlog/spdlog.h>
 
@@ -10,6 +12,8 @@ bool RedisClient::set_session(const std::string& user_id,
                               const std::string& device_id,
                               const std::string& client_ip) {
     try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
         sw::redis::ConnectionOptions opts;
         opts.host = host_;
         opts.port = static_cast<int>(port_);
@@ -40,6 +44,8 @@ bool RedisClient::hset_fields(const std::string& key,
                               const std::unordered_map<std::string, std::string>& fields,
                               std::chrono::seconds ttl) {
     try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
         sw::redis::ConnectionOptions opts;
         opts.host = host_;
         opts.port = static_cast<int>(port_);
@@ -59,6 +65,8 @@ bool RedisClient::hset_fields(const std::string& key,
 bool RedisClient::hgetall(const std::string& key,
                           std::unordered_map<std::string, std::string>& out_fields) {
     try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
         sw::redis::ConnectionOptions opts;
         opts.host = host_;
         opts.port = static_cast<int>(port_);
@@ -75,6 +83,8 @@ bool RedisClient::hgetall(const std::string& key,
 
 bool RedisClient::set_string(const std::string& key, const std::string& value, std::chrono::seconds ttl) {
     try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
         sw::redis::ConnectionOptions opts;
         opts.host = host_;
         opts.port = static_cast<int>(port_);
@@ -90,6 +100,8 @@ bool RedisClient::set_string(const std::string& key, const std::string& value, s
 
 std::optional<std::string> RedisClient::get_string(const std::string& key) {
     try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
         sw::redis::ConnectionOptions opts;
         opts.host = host_;
         opts.port = static_cast<int>(port_);
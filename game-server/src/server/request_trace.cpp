@@ -0,0 +1,74 @@
+#include "request_trace.h"
+#include <algorithm>
+#include <atomic>
+
+namespace request_trace {
+namespace {
+thread_local Scope* t_current = nullptr;
+// 다른 스레드에서 leave가 불려도 엉뚱한 Scope에 합산되지 않도록 전역 고유 id
+std::atomic<uint64_t> g_next_id{1};
+} // namespace
+
+const char* phase_name(Phase phase) {
+    switch (phase) {
+    case Phase::Parse: return "parse";
+    case Phase::Db: return "db";
+    case Phase::Redis: return "redis";
+    case Phase::Serialize: return "serialize";
+    case Phase::Send: return "send";
+    case Phase::Count: break;
+    }
+    return "unknown";
+}
+
+std::chrono::nanoseconds Breakdown::handler() const {
+    auto rest = total;
+    for (const auto& p : phases) rest -= p;
+    return std::max(rest, std::chrono::nanoseconds(0));
+}
+
+Scope::Scope() : id_(g_next_id.fetch_add(1, std::memory_order_relaxed)), start_(Clock::now()), previous_(t_current) {
+    t_current = this;
+}
+
+Scope::~Scope() {
+    t_current = previous_;
+}
+
+Scope* Scope::current() {
+    return t_current;
+}
+
+Breakdown Scope::snapshot() const {
+    const auto now = Clock::now();
+    Breakdown b;
+    b.total = now - start_;
+    for (std::size_t i = 0; i < kPhaseCount; ++i) {
+        int64_t ns = phase_ns_[i];
+        if (depth_[i] > 0) ns += std::chrono::duration_cast<std::chrono::nanoseconds>(now - since_[i]).count();
+        b.phases[i] = std::chrono::nanoseconds(ns);
+    }
+    return b;
+}
+
+uint64_t enter(Phase phase) {
+    Scope* scope = t_current;
+    if (!scope) return 0;
+    const auto i = static_cast<std::size_t>(phase);
+    if (scope->depth_[i]++ == 0) scope->since_[i] = Scope::Clock::now();
+    return scope->id_;
+}
+
+void leave(Phase phase, uint64_t trace_id) {
+    Scope* scope = t_current;
+    if (trace_id == 0 || !scope || scope->id_ != trace_id) return;
+    const auto i = static_cast<std::size_t>(phase);
+    if (scope->depth_[i] == 0) return;
+    if (--scope->depth_[i] == 0) {
+        scope->phase_ns_[i] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   Scope::Clock::now() - scope->since_[i])
+                                   .count();
+    }
+}
+
+} // namespace request_trace
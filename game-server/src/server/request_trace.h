@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// 요청 단위 구간(phase) 시간 추적
+// - 세션이 요청 하나를 처리하는 동안 Scope를 열어 두면, 같은 스레드에서 실행되는
+//   DB/Redis/직렬화/전송 구간이 enter/leave(PhaseScope)로 자기 시간을 누적한다
+// - 같은 구간이 중첩되면 가장 바깥 구간만 센다 (커넥션 두 개를 동시에 잡는 경우 등)
+// - 활성 Scope가 없는 스레드(유지보수 스레드, 도구)에서는 아무 것도 하지 않는다
+namespace request_trace {
+
+enum class Phase : std::size_t {
+    Parse,
+    Db,
+    Redis,
+    Serialize,
+    Send,
+    Count
+};
+
+constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::Count);
+
+const char* phase_name(Phase phase);
+
+struct Breakdown {
+    std::chrono::nanoseconds total{0};
+    std::array<std::chrono::nanoseconds, kPhaseCount> phases{};
+
+    // 어느 구간에도 속하지 않은 핸들러 자체 시간
+    std::chrono::nanoseconds handler() const;
+};
+
+class Scope {
+public:
+    Scope();
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // 현재까지의 누적 (열려 있는 구간은 지금까지 경과분 포함)
+    Breakdown snapshot() const;
+
+    // 이 스레드의 활성 Scope (없으면 nullptr)
+    static Scope* current();
+
+private:
+    friend uint64_t enter(Phase phase);
+    friend void leave(Phase phase, uint64_t trace_id);
+
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t id_;
+    Clock::time_point start_;
+    std::array<int64_t, kPhaseCount> phase_ns_{};
+    std::array<uint32_t, kPhaseCount> depth_{};
+    std::array<Clock::time_point, kPhaseCount> since_{};
+    Scope* previous_;
+};
+
+// 구간 시작. 활성 Scope의 id를 반환 (없으면 0). leave에 그대로 넘긴다.
+uint64_t enter(Phase phase);
+// 구간 종료. 시작 이후 Scope가 바뀌었으면 무시한다 (LIFO가 아니어도 안전)
+void leave(Phase phase, uint64_t trace_id);
+
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase) : phase_(phase), trace_id_(enter(phase)) {}
+    ~PhaseScope() { leave(phase_, trace_id_); }
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    Phase phase_;
+    uint64_t trace_id_;
+};
+
+} // namespace request_trace
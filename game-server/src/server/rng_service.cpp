@@ -0,0 +1,90 @@
+#include "rng_service.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+
+namespace {
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t mix(uint64_t h, uint64_t v) {
+    uint64_t state = h ^ v;
+    return splitmix64(state);
+}
+
+// FNV-1a 64 (std::hash는 구현 의존이라 재현용 시드에 쓰지 않는다)
+uint64_t fnv1a(const std::string& s) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+std::atomic<uint64_t> g_audit_seed{0};
+// 재시작 후에도 겹치지 않도록 시작 시각(us) 기준으로 증가
+std::atomic<uint64_t> g_nonce{0};
+std::atomic<uint64_t> g_thread_counter{0};
+}
+
+void Xoshiro256ss::reseed(uint64_t seed) {
+    uint64_t state = seed;
+    for (auto& word : s_) {
+        word = splitmix64(state);
+    }
+}
+
+RngStream RngStream::replay(uint64_t master_seed, const std::string& user_id, RngDomain domain, uint64_t nonce) {
+    return RngStream(RngService::derive_seed(master_seed, user_id, domain, nonce), nonce, true);
+}
+
+void RngService::configure(uint64_t audit_seed) {
+    g_audit_seed.store(audit_seed, std::memory_order_relaxed);
+    auto now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    g_nonce.store(static_cast<uint64_t>(now_us), std::memory_order_relaxed);
+    if (audit_seed != 0) {
+        spdlog::info("RNG audit mode enabled (nonce base {})", now_us);
+    }
+}
+
+Xoshiro256ss& RngService::thread_rng() {
+    thread_local Xoshiro256ss rng([] {
+        std::random_device rd;
+        uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+        return mix(seed, g_thread_counter.fetch_add(1, std::memory_order_relaxed));
+    }());
+    return rng;
+}
+
+RngStream RngService::stream(const std::string& user_id, RngDomain domain) {
+    const uint64_t master = g_audit_seed.load(std::memory_order_relaxed);
+    if (master == 0) {
+        return RngStream(thread_rng()(), 0, false);
+    }
+    const uint64_t nonce = g_nonce.fetch_add(1, std::memory_order_relaxed);
+    spdlog::info("rng_audit user={} domain={} nonce={}", user_id, to_string(domain), nonce);
+    return RngStream(derive_seed(master, user_id, domain, nonce), nonce, true);
+}
+
+uint64_t RngService::derive_seed(uint64_t master_seed, const std::string& user_id, RngDomain domain, uint64_t nonce) {
+    uint64_t h = mix(master_seed, fnv1a(user_id));
+    h = mix(h, static_cast<uint64_t>(domain));
+    return mix(h, nonce);
+}
+
+const char* to_string(RngDomain domain) {
+    switch (domain) {
+        case RngDomain::Gacha: return "gacha";
+        case RngDomain::Synthesis: return "synthesis";
+        case RngDomain::Upgrade: return "upgrade";
+        case RngDomain::Crit: return "crit";
+    }
+    return "unknown";
+}
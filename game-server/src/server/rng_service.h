@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+// xoshiro256** (UniformRandomBitGenerator). 상태 32바이트, 스레드 간 공유하지 않는다.
+class Xoshiro256ss {
+public:
+    using result_type = uint64_t;
+
+    Xoshiro256ss() : Xoshiro256ss(0) {}
+    explicit Xoshiro256ss(uint64_t seed) { reseed(seed); }
+
+    void reseed(uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    std::array<uint64_t, 4> s_{};
+};
+
+// 감사/재현 대상 확률 판정 종류 (로그에 숫자로 남으므로 값 변경 금지)
+enum class RngDomain : uint32_t {
+    Gacha = 1,
+    Synthesis = 2,
+    Upgrade = 3,
+    Crit = 4,
+};
+
+// 한 번의 판정(또는 세션 단위 판정 묶음)에 쓰는 난수 스트림.
+// 감사 모드에서는 (master_seed, user_id, domain, nonce)로 시드가 결정되어
+// 로그에 남은 nonce만으로 오프라인에서 같은 결과를 재현할 수 있다.
+class RngStream {
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return Xoshiro256ss::min(); }
+    static constexpr result_type max() { return Xoshiro256ss::max(); }
+    result_type operator()() { return gen_(); }
+
+    uint64_t nonce() const { return nonce_; }
+    bool deterministic() const { return deterministic_; }
+
+    // 오프라인 재현용: 서버와 같은 master_seed로 동일한 스트림 생성
+    static RngStream replay(uint64_t master_seed, const std::string& user_id, RngDomain domain, uint64_t nonce);
+
+private:
+    friend class RngService;
+    RngStream(uint64_t seed, uint64_t nonce, bool deterministic)
+        : gen_(seed), nonce_(nonce), deterministic_(deterministic) {}
+
+    Xoshiro256ss gen_;
+    uint64_t nonce_{0};
+    bool deterministic_{false};
+};
+
+// 중앙 RNG 서비스
+// - thread_rng(): 스레드별 생성기, 공유 상태 없음 (감사 불필요한 난수용)
+// - stream(): 사용자별 판정 스트림. 감사 모드면 결정적 시드 + nonce 로그
+class RngService {
+public:
+    // 서버 시작 시 1회 호출. audit_seed가 0이면 감사 모드 비활성화
+    static void configure(uint64_t audit_seed);
+
+    static Xoshiro256ss& thread_rng();
+
+    static RngStream stream(const std::string& user_id, RngDomain domain);
+
+    // 감사 모드 시드 파생 (replay와 공유)
+    static uint64_t derive_seed(uint64_t master_seed, const std::string& user_id, RngDomain domain, uint64_t nonce);
+
+    // 0 ~ 9999 (basis point) 판정값
+    template <typename Rng>
+    static uint32_t roll_bp_10000(Rng& rng) {
+        return static_cast<uint32_t>(rng() % 10000u);
+    }
+};
+
+const char* to_string(RngDomain domain);
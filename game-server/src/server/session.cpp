@@ -1,14 +1,20 @@
 #include "session.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include "ad_service.h"
+#include "rng_service.h"
 #include "time_utils.h"
+#include "game_clock.h"
+#include "metrics.h"
+#include "traffic_capture.h"
+#include "frame_limits.h"
+#include "session_snapshot_store.h"
+#include "session_ownership.h"
 #include <spdlog/spdlog.h>
 #include <iostream>
 #include <cstring>
 #include <ctime>
 #include <cmath>
 #include <cstdlib>
-#include <random>
 #include <limits>
 #include <algorithm>
 
@@ -22,19 +28,15 @@ namespace
                (static_cast<uint32_t>(buf[3]) << 24);
     }
 
-    std::array<uint8_t, 4> encode_le(uint32_t v)
+    // 길이 prefix(4바이트 LE) + 직렬화된 Envelope를 한 버퍼로
+    std::shared_ptr<std::string> encode_frame(const infinitepickaxe::Envelope &env)
     {
-        return {static_cast<uint8_t>(v & 0xFF),
-                static_cast<uint8_t>((v >> 8) & 0xFF),
-                static_cast<uint8_t>((v >> 16) & 0xFF),
-                static_cast<uint8_t>((v >> 24) & 0xFF)};
-    }
-
-    uint32_t roll_bp_10000()
-    {
-        static thread_local std::mt19937 rng(std::random_device{}());
-        static thread_local std::uniform_int_distribution<uint32_t> dist(0, 9999);
-        return dist(rng);
+        auto frame = std::make_shared<std::string>(4, '\0');
+        env.AppendToString(frame.get());
+        const auto len = static_cast<uint32_t>(frame->size() - 4);
+        for (int i = 0; i < 4; ++i)
+            (*frame)[i] = static_cast<char>((len >> (8 * i)) & 0xFF);
+        return frame;
     }
 
     constexpr int kMiningCacheTtlSeconds = 60 * 60 * 24;
@@ -84,7 +86,11 @@ Session::Session(boost::asio::ip::tcp::socket socket,
                  GemService &gem_service,
                  RedisClient &redis_client,
                  std::shared_ptr<SessionRegistry> registry,
-                 const MetadataLoader &metadata)
+                 const MetadataStore &metadata,
+                 const MessageRatePolicy &message_rate,
+                 TrafficCapture *capture,
+                 SessionSnapshotStore *resume_store,
+                 SessionOwnership *ownership)
     : socket_(std::move(socket)),
       auth_service_(auth_service),
       game_repo_(game_repo),
@@ -98,7 +104,12 @@ Session::Session(boost::asio::ip::tcp::socket socket,
       redis_(redis_client),
       auth_timer_(socket_.get_executor()),
       registry_(std::move(registry)),
-      metadata_(metadata)
+      metadata_(metadata),
+      message_limiter_(message_rate),
+      capture_(capture),
+      resume_store_(resume_store),
+      ownership_(ownership),
+      owner_token_(ownership ? ownership->next_owner_token() : 0)
 {
     init_router();
 }
@@ -113,31 +124,54 @@ void Session::start()
     {
         client_ip_.clear();
     }
+    if (capture_)
+    {
+        capture_id_ = capture_->begin_session();
+        capture_->record(capture_id_, TrafficCapture::Kind::Open, client_ip_.data(), client_ip_.size());
+    }
     start_auth_timer();
     read_length();
 }
 
 void Session::notify_duplicate_and_close()
 {
+    send_error_and_close("1006", "DUPLICATE_SESSION");
+}
+
+void Session::kick_if_owner(uint64_t owner_token)
+{
+    if (closed_ || owner_token != owner_token_)
+        return;
+    notify_duplicate_and_close();
+}
+
+void Session::drain_and_close()
+{
+    if (closed_)
+        return;
+    cache_mining_state();
+    flush_play_time_progress(true);
+    send_error_and_close("1008", "SERVER_SHUTDOWN");
+}
+
+void Session::send_error_and_close(const std::string &code, const std::string &message)
+{
+    resumable_ = false;
     infinitepickaxe::ErrorNotification err;
-    err.set_error_code("1006");
-    err.set_message("DUPLICATE_SESSION");
+    err.set_error_code(code);
+    err.set_message(message);
 
     infinitepickaxe::Envelope env;
     env.set_type(infinitepickaxe::ERROR_NOTIFICATION);
     *env.mutable_error_notification() = err;
 
-    std::string body;
-    env.SerializeToString(&body);
-    auto len = static_cast<uint32_t>(body.size());
-    auto len_enc = encode_le(len);
+    auto frame = encode_frame(env);
+    if (capture_id_ != 0)
+        record_outbound(env, *frame);
 
     auto self = shared_from_this();
-    std::array<boost::asio::const_buffer, 2> bufs = {
-        boost::asio::buffer(len_enc),
-        boost::asio::buffer(body)};
-    boost::asio::async_write(socket_, bufs,
-                             [this, self](boost::system::error_code /*ec*/, std::size_t /*written*/)
+    boost::asio::async_write(socket_, boost::asio::buffer(*frame),
+                             [this, self, frame](boost::system::error_code /*ec*/, std::size_t /*written*/)
                              {
                                  close();
                              });
@@ -155,7 +189,7 @@ void Session::read_length()
                                     return;
                                 }
                                 uint32_t len = decode_le(len_buf_);
-                                if (len == 0 || len > 64 * 1024)
+                                if (len == 0 || len > kMaxRequestFrameSize)
                                 { // 간단한 길이 제한
                                     send_error("INVALID_LENGTH", "invalid length");
                                     close();
@@ -177,17 +211,56 @@ void Session::read_payload(std::size_t length)
                                     close();
                                     return;
                                 }
+                                metrics::add(metrics::Counter::BytesIn, payload_buf_.size() + len_buf_.size());
+                                // 요청 1건의 구간 계측 (핸들러 종료 시 라우터가 기록)
+                                request_trace::Scope trace;
                                 infinitepickaxe::Envelope env;
-                                if (!env.ParseFromArray(payload_buf_.data(), static_cast<int>(payload_buf_.size())))
+                                bool parsed = false;
+                                {
+                                    request_trace::PhaseScope parse(request_trace::Phase::Parse);
+                                    parsed = env.ParseFromArray(payload_buf_.data(), static_cast<int>(payload_buf_.size()));
+                                }
+                                if (!parsed)
                                 {
                                     send_error("INVALID_ENVELOPE", "parse failed");
                                     close();
                                     return;
                                 }
+                                if (capture_id_ != 0)
+                                    record_inbound(env);
                                 dispatch_envelope(env);
                             });
 }
 
+void Session::record_inbound(const infinitepickaxe::Envelope &env)
+{
+    // 토큰은 캡처 파일에 남기지 않는다
+    if (env.has_handshake() && (!env.handshake().jwt().empty() || !env.handshake().resume_token().empty()))
+    {
+        infinitepickaxe::Envelope redacted = env;
+        redacted.mutable_handshake()->clear_jwt();
+        redacted.mutable_handshake()->clear_resume_token();
+        const auto body = redacted.SerializeAsString();
+        capture_->record(capture_id_, TrafficCapture::Kind::Inbound, body.data(), body.size());
+        return;
+    }
+    capture_->record(capture_id_, TrafficCapture::Kind::Inbound, payload_buf_.data(), payload_buf_.size());
+}
+
+void Session::record_outbound(const infinitepickaxe::Envelope &env, const std::string &frame)
+{
+    // 재접속 토큰은 그 자체로 인증 수단이므로 캡처 파일에 남기지 않는다
+    if (env.has_handshake_result() && !env.handshake_result().resume_token().empty())
+    {
+        infinitepickaxe::Envelope redacted = env;
+        redacted.mutable_handshake_result()->clear_resume_token();
+        const auto body = redacted.SerializeAsString();
+        capture_->record(capture_id_, TrafficCapture::Kind::Outbound, body.data(), body.size());
+        return;
+    }
+    capture_->record(capture_id_, TrafficCapture::Kind::Outbound, frame.data() + 4, frame.size() - 4);
+}
+
 bool Session::is_expired() const
 {
     if (expires_at_.time_since_epoch().count() == 0)
@@ -206,7 +279,18 @@ void Session::dispatch_envelope(const infinitepickaxe::Envelope &env)
 
     if (env.type() == infinitepickaxe::HANDSHAKE)
     {
+        // 인증 후 재핸드셰이크는 인증 서버 호출 + 전체 상태 로드라 가장 비싸다 → 거부
+        if (authenticated_)
+        {
+            send_error("2006", "ALREADY_AUTHENTICATED");
+            read_length();
+            return;
+        }
         handle_handshake(env);
+        if (auto *trace = request_trace::Scope::current())
+        {
+            MessageRouter::record(infinitepickaxe::HANDSHAKE, user_id_, trace->snapshot());
+        }
         return;
     }
 
@@ -217,7 +301,27 @@ void Session::dispatch_envelope(const infinitepickaxe::Envelope &env)
         return;
     }
 
-    if (!router_.dispatch(env))
+    // 타입별 비용 기반 요청 빈도 제한 (초과 요청은 처리하지 않음)
+    if (!message_limiter_.try_consume(env.type()))
+    {
+        const auto recent_violations = message_limiter_.record_violation();
+        metrics::add(metrics::Counter::MessagesRateLimited);
+        send_error("2005", "RATE_LIMIT_EXCEEDED");
+        const auto max_violations = message_limiter_.policy().max_violations;
+        if (max_violations > 0 && recent_violations >= max_violations)
+        {
+            spdlog::warn("Closing session user_id={} after {} rate limit violations in {}s", user_id_,
+                         recent_violations, message_limiter_.policy().violation_window.count());
+            // 재접속 토큰으로 새 버킷을 받아 바로 이어가지 못하도록 스냅샷을 남기지 않는다
+            resumable_ = false;
+            close();
+            return;
+        }
+        read_length();
+        return;
+    }
+
+    if (!router_.dispatch(env, user_id_))
     {
         send_error("2001", "UNKNOWN_MESSAGE_TYPE");
     }
@@ -237,6 +341,10 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
         return;
     }
     const auto &req = env.handshake();
+    if (resume_store_ && !req.resume_token().empty() && try_resume(req))
+    {
+        return;
+    }
     VerifyResult vr = auth_service_.verify_and_cache(req.jwt(), client_ip_);
 
     infinitepickaxe::HandshakeResponse res;
@@ -282,6 +390,8 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
     google_id_ = vr.google_id;
     expires_at_ = vr.expires_at;
     authenticated_ = true;
+    // 크리티컬 판정은 세션 단위 스트림 하나로 처리 (감사 모드에서는 nonce 1회만 기록)
+    crit_rng_.emplace(RngService::stream(user_id_, RngDomain::Crit));
     boost::system::error_code timer_ec;
     auth_timer_.cancel(timer_ec);
     next_daily_reset_ms_ = kst_next_midnight_ms();
@@ -293,6 +403,17 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
             previous->notify_duplicate_and_close();
         }
     }
+    if (ownership_)
+    {
+        ownership_->claim(user_id_, owner_token_, expires_at_);
+    }
+    if (resume_store_)
+    {
+        // 이전 연결의 스냅샷은 이제 DB보다 오래된 상태일 수 있음
+        resume_store_->invalidate_user(user_id_);
+        resume_token_ = SessionSnapshotStore::issue_token();
+        res.set_resume_token(resume_token_);
+    }
 
     res.set_success(true);
     res.set_message("OK");
@@ -330,7 +451,8 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
         snapshot->mutable_mineral_hp()->set_value(mineral_hp);
         if (mineral_id > 0)
         {
-            const auto *mineral = metadata_.mineral(mineral_id);
+            auto meta = metadata_.current();
+            const auto *mineral = meta->mineral(mineral_id);
             snapshot->mutable_mineral_max_hp()->set_value(mineral ? mineral->hp : 100);
         }
         else
@@ -351,7 +473,7 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
     snapshot->mutable_server_time()->set_value(
         static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch())
+                game_clock::now().time_since_epoch())
                 .count()));
 
     auto offline_state = offline_service_.get_state(user_id_);
@@ -376,7 +498,8 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
     if (current_mineral_id.has_value() && current_mineral_id.value() > 0 && current_mineral_hp.has_value())
     {
         mining_state_.current_mineral_id = current_mineral_id.value();
-        const auto *current_mineral = metadata_.mineral(mining_state_.current_mineral_id);
+        auto meta = metadata_.current();
+        const auto *current_mineral = meta->mineral(mining_state_.current_mineral_id);
         mining_state_.max_hp = current_mineral ? current_mineral->hp : 0;
 
         uint64_t hp = current_mineral_hp.value();
@@ -388,7 +511,7 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
 
         const uint64_t now_ms = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch())
+                game_clock::now().time_since_epoch())
                 .count());
 
         if (cached_respawn_until_ms > now_ms)
@@ -403,7 +526,7 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
             mining_state_.is_mining = true;
             mining_state_.last_sent_hp = std::numeric_limits<uint64_t>::max();
             refresh_slots_from_service(false);
-            send_mining_update({});
+            send_mining_update();
             mining_state_.last_sent_hp = mining_state_.current_hp;
         }
         else
@@ -433,6 +556,114 @@ void Session::handle_handshake(const infinitepickaxe::Envelope &env)
     read_length();
 }
 
+bool Session::try_resume(const infinitepickaxe::HandshakeRequest &req)
+{
+    auto snapshot = resume_store_->take(req.resume_token());
+    if (!snapshot)
+    {
+        return false;
+    }
+
+    const auto now = std::chrono::system_clock::now();
+    const uint64_t now_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            game_clock::now().time_since_epoch())
+            .count());
+    // 토큰 만료, 일일 초기화, 메타데이터 교체가 끼어들었으면 전체 로드가 필요
+    const bool token_expired = snapshot->expires_at.time_since_epoch().count() != 0 && now >= snapshot->expires_at;
+    const bool device_changed = !req.device_id().empty() && !snapshot->device_id.empty() &&
+                                req.device_id() != snapshot->device_id;
+    if (token_expired || device_changed || now_ms >= snapshot->next_daily_reset_ms ||
+        snapshot->metadata_version != metadata_.version())
+    {
+        spdlog::info("Resume rejected for user {} (expired={} device={}), full handshake",
+                     snapshot->user_id, token_expired, device_changed);
+        return false;
+    }
+    // 끊긴 뒤 다른 곳에서 로그인했다면 스냅샷이 DB보다 오래됨 → 전체 로드 (소유권은 이미 넘겨받음)
+    if (ownership_ &&
+        ownership_->claim(snapshot->user_id, owner_token_, snapshot->expires_at) == SessionOwnership::Claim::TookOver)
+    {
+        spdlog::info("Resume rejected for user {} (logged in elsewhere), full handshake", snapshot->user_id);
+        return false;
+    }
+
+    user_id_ = std::move(snapshot->user_id);
+    device_id_ = std::move(snapshot->device_id);
+    google_id_ = std::move(snapshot->google_id);
+    expires_at_ = snapshot->expires_at;
+    authenticated_ = true;
+    crit_rng_.emplace(RngService::stream(user_id_, RngDomain::Crit));
+    boost::system::error_code timer_ec;
+    auth_timer_.cancel(timer_ec);
+    next_daily_reset_ms_ = snapshot->next_daily_reset_ms;
+
+    if (registry_)
+    {
+        if (auto previous = registry_->replace_session(user_id_, shared_from_this()))
+        {
+            previous->notify_duplicate_and_close();
+        }
+    }
+
+    mining_state_ = std::move(snapshot->mining);
+    play_time_accum_ms_ = snapshot->play_time_accum_ms;
+    mining_cache_accum_ms_ = snapshot->mining_cache_accum_ms;
+    // 끊겨 있던 동안 채굴은 멈추지만 리스폰 대기 시간은 흐른다 (0이 되면 다음 틱에 새 광물)
+    if (!mining_state_.is_mining && mining_state_.respawn_timer_ms > 0.0f)
+    {
+        const float elapsed_ms = static_cast<float>(now_ms - std::min(now_ms, snapshot->saved_at_ms));
+        mining_state_.respawn_timer_ms = std::max(1.0f, mining_state_.respawn_timer_ms - elapsed_ms);
+    }
+    mining_state_.last_sent_hp = std::numeric_limits<uint64_t>::max();
+    resume_token_ = SessionSnapshotStore::issue_token();
+
+    infinitepickaxe::HandshakeResponse res;
+    res.set_success(true);
+    res.set_message("RESUMED");
+    res.set_resumed(true);
+    res.set_resume_token(resume_token_);
+    auto *snap = res.mutable_snapshot();
+    snap->mutable_server_time()->set_value(now_ms);
+    snap->mutable_current_mineral_id()->set_value(mining_state_.current_mineral_id);
+    snap->mutable_mineral_hp()->set_value(mining_state_.current_hp);
+    snap->mutable_mineral_max_hp()->set_value(mining_state_.max_hp);
+
+    infinitepickaxe::Envelope response_env;
+    response_env.set_type(infinitepickaxe::HANDSHAKE_RESULT);
+    *response_env.mutable_handshake_result() = res;
+    send_envelope(response_env);
+
+    if (mining_state_.is_mining)
+    {
+        send_mining_update();
+        mining_state_.last_sent_hp = mining_state_.current_hp;
+    }
+    spdlog::info("Session resumed for user {}", user_id_);
+
+    read_length();
+    return true;
+}
+
+void Session::save_resume_snapshot()
+{
+    SessionSnapshot snapshot;
+    snapshot.user_id = user_id_;
+    snapshot.device_id = device_id_;
+    snapshot.google_id = google_id_;
+    snapshot.expires_at = expires_at_;
+    snapshot.mining = mining_state_;
+    snapshot.play_time_accum_ms = play_time_accum_ms_;
+    snapshot.mining_cache_accum_ms = mining_cache_accum_ms_;
+    snapshot.next_daily_reset_ms = next_daily_reset_ms_;
+    snapshot.saved_at_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            game_clock::now().time_since_epoch())
+            .count());
+    snapshot.metadata_version = metadata_.version();
+    resume_store_->save(resume_token_, std::move(snapshot));
+}
+
 void Session::handle_heartbeat(const infinitepickaxe::Envelope &env)
 {
     if (!env.has_heartbeat())
@@ -445,7 +676,7 @@ void Session::handle_heartbeat(const infinitepickaxe::Envelope &env)
     ack.set_server_time_ms(
         static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch())
+                game_clock::now().time_since_epoch())
                 .count()));
 
     infinitepickaxe::Envelope response_env;
@@ -518,7 +749,8 @@ void Session::handle_change_mineral(const infinitepickaxe::Envelope &env)
     }
     else
     {
-        const auto *mineral = metadata_.mineral(mineral_id);
+        auto meta = metadata_.current();
+        const auto *mineral = meta->mineral(mineral_id);
         if (!mineral)
         {
             res.set_error_code("INVALID_MINERAL");
@@ -754,17 +986,21 @@ void Session::init_router()
 
 void Session::send_envelope(const infinitepickaxe::Envelope &env)
 {
-    std::string body;
-    env.SerializeToString(&body);
-    auto len = static_cast<uint32_t>(body.size());
-    auto len_enc = encode_le(len);
+    std::shared_ptr<std::string> frame;
+    {
+        request_trace::PhaseScope serialize(request_trace::Phase::Serialize);
+        frame = encode_frame(env);
+    }
+    metrics::add(metrics::Counter::BytesOut, frame->size());
+    if (capture_id_ != 0)
+        record_outbound(env, *frame);
+    // 전송 구간은 async_write 개시 비용만 포함 (실제 소켓 쓰기는 비동기)
+    request_trace::PhaseScope send(request_trace::Phase::Send);
 
+    // 프레임은 쓰기 완료까지 핸들러가 소유 (지역 버퍼는 async_write 도중 해제될 수 있음)
     auto self = shared_from_this();
-    std::array<boost::asio::const_buffer, 2> bufs = {
-        boost::asio::buffer(len_enc),
-        boost::asio::buffer(body)};
-    boost::asio::async_write(socket_, bufs,
-                             [this, self](boost::system::error_code ec, std::size_t /*written*/)
+    boost::asio::async_write(socket_, boost::asio::buffer(*frame),
+                             [this, self, frame](boost::system::error_code ec, std::size_t /*written*/)
                              {
                                  if (ec)
                                  {
@@ -833,7 +1069,7 @@ void Session::cache_mining_state()
 
     const uint64_t now_ms = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+            game_clock::now().time_since_epoch()).count());
     uint64_t respawn_until_ms = 0;
     if (mining_state_.respawn_timer_ms > 0.0f)
     {
@@ -847,7 +1083,7 @@ void Session::cache_mining_state()
         {"respawn_until_ms", std::to_string(respawn_until_ms)},
         {"updated_at", std::to_string(static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count()))}
+                game_clock::now().time_since_epoch()).count()))}
     };
     const std::string key = "session:mining:" + user_id_;
     redis_.hset_fields(key, fields, std::chrono::seconds(kMiningCacheTtlSeconds));
@@ -928,12 +1164,21 @@ void Session::close()
         return;
     flush_play_time_progress(true);
     closed_ = true;
+    // 네트워크 끊김 등으로 닫히면 재접속 복원용으로 메모리 상태를 남긴다
+    if (resume_store_ && resumable_ && authenticated_ && !resume_token_.empty() && !is_expired())
+        save_resume_snapshot();
+    if (capture_id_ != 0)
+        capture_->record(capture_id_, TrafficCapture::Kind::Close, nullptr, 0);
     boost::system::error_code timer_ec;
     auth_timer_.cancel(timer_ec);
     if (registry_ && !user_id_.empty())
     {
         registry_->remove_if_match(user_id_, this);
     }
+    if (ownership_ && authenticated_)
+    {
+        ownership_->release(user_id_, owner_token_);
+    }
     boost::system::error_code ignored;
     socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
     socket_.close(ignored);
@@ -964,7 +1209,7 @@ void Session::update_mining_tick(float delta_ms)
 
     const uint64_t now_ms = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+            game_clock::now().time_since_epoch()).count());
     if (next_daily_reset_ms_ == 0)
     {
         next_daily_reset_ms_ = kst_next_midnight_ms();
@@ -1008,38 +1253,12 @@ void Session::update_mining_tick(float delta_ms)
         return;
     }
 
-    std::vector<infinitepickaxe::PickaxeAttack> attacks;
-    uint64_t total_damage = 0;
-
-    for (auto &slot : mining_state_.slots)
-    {
-        slot.next_attack_timer_ms -= delta_ms;
-
-        // 40ms 동안 여러 번 공격할 수 있음 (attack_speed가 매우 빠른 경우)
-        while (slot.next_attack_timer_ms <= 0)
-        {
-            const float attack_speed = std::max(slot.attack_speed, 0.01f);
-            const float attack_interval_ms = 1000.0f / attack_speed;
-
-            const bool is_crit = roll_bp_10000() < slot.critical_hit_percent;
-            uint64_t damage = slot.attack_power;
-            if (is_crit)
-            {
-                damage = static_cast<uint64_t>(
-                    (static_cast<long double>(slot.attack_power) * static_cast<long double>(slot.critical_damage)) / 10000.0L);
-            }
-
-            infinitepickaxe::PickaxeAttack attack;
-            attack.set_slot_index(slot.slot_index);
-            attack.set_damage(damage);
-            attack.set_is_critical(is_crit);
-            attacks.push_back(attack);
-
-            slot.next_attack_timer_ms += attack_interval_ms;
-
-            total_damage += damage;
-        }
-    }
+    infinitepickaxe::Envelope env;
+    env.set_type(infinitepickaxe::MINING_UPDATE);
+    auto *update = env.mutable_mining_update();
+    const uint64_t total_damage =
+        crit_rng_ ? advance_slot_attacks(mining_state_.slots, delta_ms, *crit_rng_, *update)
+                  : advance_slot_attacks(mining_state_.slots, delta_ms, RngService::thread_rng(), *update);
 
     if (total_damage > 0)
     {
@@ -1056,7 +1275,7 @@ void Session::update_mining_tick(float delta_ms)
     if (mining_state_.current_hp == 0)
     {
         // 마지막 타격 결과를 클라이언트에 반영 후 완료 통보
-        send_mining_update(attacks);
+        send_mining_update(env);
         mining_state_.last_sent_hp = mining_state_.current_hp;
         handle_mining_complete_immediate();
         return;
@@ -1064,7 +1283,7 @@ void Session::update_mining_tick(float delta_ms)
 
     if (mining_state_.current_hp != mining_state_.last_sent_hp)
     {
-        send_mining_update(attacks);
+        send_mining_update(env);
         mining_state_.last_sent_hp = mining_state_.current_hp;
     }
 }
@@ -1080,7 +1299,8 @@ void Session::start_new_mineral()
         return;
     }
 
-    const auto *mineral = metadata_.mineral(mining_state_.current_mineral_id);
+    auto meta = metadata_.current();
+    const auto *mineral = meta->mineral(mining_state_.current_mineral_id);
     if (!mineral)
     {
         spdlog::error("Invalid mineral_id: {}", mining_state_.current_mineral_id);
@@ -1097,7 +1317,7 @@ void Session::start_new_mineral()
     refresh_slots_from_service(false);
 
     // 초기 상태를 클라이언트에 전달 (HP 변화 알림)
-    send_mining_update({});
+    send_mining_update();
     mining_state_.last_sent_hp = mining_state_.current_hp;
 
     spdlog::info("Mining started: user={} mineral={} hp={} slots={}",
@@ -1144,7 +1364,7 @@ void Session::refresh_slots_from_service(bool preserve_timers)
         }
         else
         {
-            slot.next_attack_timer_ms = (float)(std::rand() % 1000) / 1000.0f * attack_interval_ms;
+            slot.next_attack_timer_ms = (float)(RngService::thread_rng()() % 1000) / 1000.0f * attack_interval_ms;
         }
         mining_state_.slots.push_back(slot);
     }
@@ -1175,7 +1395,7 @@ void Session::apply_slot_update(uint32_t slot_index, uint64_t attack_power, floa
         slot.critical_hit_percent = critical_hit_percent;
         slot.critical_damage = critical_damage;
         float attack_interval_ms = 1000.0f / slot.attack_speed;
-        slot.next_attack_timer_ms = (float)(std::rand() % 1000) / 1000.0f * attack_interval_ms;
+        slot.next_attack_timer_ms = (float)(RngService::thread_rng()() % 1000) / 1000.0f * attack_interval_ms;
         mining_state_.slots.push_back(slot);
         return;
     }
@@ -1189,25 +1409,21 @@ void Session::apply_slot_update(uint32_t slot_index, uint64_t attack_power, floa
     it->next_attack_timer_ms = std::clamp(it->next_attack_timer_ms, 1.0f, attack_interval_ms);
 }
 
-void Session::send_mining_update(const std::vector<infinitepickaxe::PickaxeAttack> &attacks)
+void Session::send_mining_update()
 {
-    infinitepickaxe::MiningUpdate update;
-    update.set_mineral_id(mining_state_.current_mineral_id);
-    update.set_current_hp(mining_state_.current_hp);
-    update.set_max_hp(mining_state_.max_hp);
-    update.set_server_timestamp(static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-            .count()));
-
-    for (const auto &attack : attacks)
-    {
-        *update.add_attacks() = attack;
-    }
-
     infinitepickaxe::Envelope env;
     env.set_type(infinitepickaxe::MINING_UPDATE);
-    *env.mutable_mining_update() = update;
+    env.mutable_mining_update();
+    send_mining_update(env);
+}
+
+void Session::send_mining_update(infinitepickaxe::Envelope &env)
+{
+    const uint64_t now_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            game_clock::now().time_since_epoch())
+            .count());
+    fill_mining_update(mining_state_, now_ms, *env.mutable_mining_update());
     send_envelope(env);
 }
 
@@ -1215,7 +1431,8 @@ void Session::handle_mining_complete_immediate()
 {
     mining_state_.is_mining = false;
 
-    const auto *mineral = metadata_.mineral(mining_state_.current_mineral_id);
+    auto meta = metadata_.current();
+    const auto *mineral = meta->mineral(mining_state_.current_mineral_id);
     if (!mineral)
     {
         spdlog::error("Invalid mineral_id: {}", mining_state_.current_mineral_id);
@@ -1225,34 +1442,57 @@ void Session::handle_mining_complete_immediate()
     uint64_t gold_reward = mineral->reward;
     uint32_t respawn_time_sec = mineral->respawn_time;
 
-    auto completion_result = mining_service_.handle_complete(user_id_, mining_state_.current_mineral_id);
+    const uint32_t mineral_id = mining_state_.current_mineral_id;
     mining_state_.respawn_timer_ms = respawn_time_sec * 1000.0f;
     mining_state_.last_sent_hp = mining_state_.current_hp;
-
-    infinitepickaxe::MiningComplete complete;
-    complete.set_mineral_id(mining_state_.current_mineral_id);
-    complete.set_gold_earned(completion_result.gold_earned());
-    complete.set_total_gold(completion_result.total_gold());
-    complete.set_mining_count(completion_result.mining_count());
-    complete.set_respawn_time(respawn_time_sec);
-    complete.set_server_timestamp(static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-            .count()));
-
-    infinitepickaxe::Envelope env;
-    env.set_type(infinitepickaxe::MINING_COMPLETE);
-    *env.mutable_mining_complete() = complete;
-    send_envelope(env);
-
-    auto updates = mission_service_.handle_mining_complete(user_id_, mining_state_.current_mineral_id);
-    auto gold_updates = mission_service_.handle_gold_earned(user_id_, completion_result.gold_earned());
-    updates.insert(updates.end(), gold_updates.begin(), gold_updates.end());
-    send_mission_progress_updates(updates);
     cache_mining_state();
 
+    // 골드 지급 DB 기록은 비동기로 처리해 40ms 틱 루프가 DB 왕복을 기다리지 않게 한다.
+    auto self = shared_from_this();
+    mining_service_.handle_complete_async(user_id_, mineral_id,
+        [this, self, mineral_id, respawn_time_sec](std::optional<infinitepickaxe::MiningComplete> completion_result)
+        {
+            boost::asio::post(socket_.get_executor(),
+                [this, self, mineral_id, respawn_time_sec, completion_result = std::move(completion_result)]()
+                {
+                    if (!completion_result)
+                    {
+                        // 골드가 지급되지 않았으므로 완료 알림/미션 진행 없음
+                        spdlog::error("Mining completion not recorded: user={} mineral={}", user_id_, mineral_id);
+                        if (!closed_)
+                            send_error("5001", "DB_ERROR");
+                        return;
+                    }
+                    // 골드는 이미 저장됐으므로 연결이 먼저 끊겼어도 미션 진행은 반영하고 전송만 생략
+                    auto updates = mission_service_.handle_mining_complete(user_id_, mineral_id);
+                    auto gold_updates = mission_service_.handle_gold_earned(user_id_, completion_result->gold_earned());
+                    updates.insert(updates.end(), gold_updates.begin(), gold_updates.end());
+                    if (closed_)
+                    {
+                        return;
+                    }
+
+                    infinitepickaxe::MiningComplete complete;
+                    complete.set_mineral_id(mineral_id);
+                    complete.set_gold_earned(completion_result->gold_earned());
+                    complete.set_total_gold(completion_result->total_gold());
+                    complete.set_mining_count(completion_result->mining_count());
+                    complete.set_respawn_time(respawn_time_sec);
+                    complete.set_server_timestamp(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                            game_clock::now().time_since_epoch())
+                            .count()));
+
+                    infinitepickaxe::Envelope env;
+                    env.set_type(infinitepickaxe::MINING_COMPLETE);
+                    *env.mutable_mining_complete() = complete;
+                    send_envelope(env);
+                    send_mission_progress_updates(updates);
+                });
+        });
+
     spdlog::info("Mining completed: user={} mineral={} gold_earned={} respawn_time={}s",
-                 user_id_, mining_state_.current_mineral_id, gold_reward, respawn_time_sec);
+                 user_id_, mineral_id, gold_reward, respawn_time_sec);
 }
 
 // ========== 보석 핸들러 ==========
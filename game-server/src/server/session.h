@@ -18,30 +18,15 @@
 #include "offline_service.h"
 #include "gem_service.h"
 #include "session_registry.h"
+#include "rng_service.h"
+#include "message_rate_limiter.h"
+#include "mining_tick.h"
+#include <optional>
 
 class AdService;
-
-// 각 슬롯의 채굴 상태
-struct SlotMiningState {
-    uint32_t slot_index;          // 0-3
-    uint64_t attack_power;        // 공격력
-    float attack_speed;           // APS (attacks per second)
-    uint32_t critical_hit_percent; // 크리티컬 확률 * 10000
-    uint32_t critical_damage;      // 크리티컬 데미지 * 100
-    float next_attack_timer_ms;   // 다음 공격까지 남은 시간 (밀리초)
-};
-
-// 세션의 채굴 상태
-struct MiningState {
-    bool is_mining = false;
-    uint32_t current_mineral_id = 1;
-    uint64_t current_hp = 0;
-    uint64_t max_hp = 0;
-    std::vector<SlotMiningState> slots;  // 활성화된 슬롯들
-    float respawn_timer_ms = 0.0f;       // 리스폰 대기 중일 때 (5000ms)
-    std::chrono::steady_clock::time_point last_update_time;
-    uint64_t last_sent_hp = std::numeric_limits<uint64_t>::max(); // 마지막으로 전송한 HP (푸시 최소화)
-};
+class TrafficCapture;
+class SessionSnapshotStore;
+class SessionOwnership;
 
 class Session : public std::enable_shared_from_this<Session> {
 public:
@@ -57,10 +42,18 @@ public:
             GemService& gem_service,
             RedisClient& redis_client,
             std::shared_ptr<SessionRegistry> registry,
-            const class MetadataLoader& metadata);
+            const class MetadataStore& metadata,
+            const MessageRatePolicy& message_rate,
+            TrafficCapture* capture = nullptr,
+            SessionSnapshotStore* resume_store = nullptr,
+            SessionOwnership* ownership = nullptr);
 
     void start();
     void notify_duplicate_and_close();
+    // 서버 종료 드레인: 채굴 캐시/플레이 시간을 저장하고 클라이언트에 알린 뒤 종료
+    void drain_and_close();
+    // 다른 노드 로그인으로 소유권을 잃음 (이 세션의 토큰일 때만 종료)
+    void kick_if_owner(uint64_t owner_token);
 
     // 채굴 시뮬레이션 (40ms마다 TCPServer에서 호출)
     void update_mining_tick(float delta_ms = 40.0f);
@@ -69,7 +62,12 @@ private:
     void read_length();
     void read_payload(std::size_t length);
     void dispatch_envelope(const infinitepickaxe::Envelope& env);
+    void record_inbound(const infinitepickaxe::Envelope& env);
+    void record_outbound(const infinitepickaxe::Envelope& env, const std::string& frame);
     void handle_handshake(const infinitepickaxe::Envelope& env);
+    // 재접속 토큰으로 메모리 스냅샷 복원 (실패하면 false → 전체 핸드셰이크로 진행)
+    bool try_resume(const infinitepickaxe::HandshakeRequest& req);
+    void save_resume_snapshot();
     void handle_heartbeat(const infinitepickaxe::Envelope& env);
     void handle_mining(const infinitepickaxe::Envelope& env);
     void handle_upgrade(const infinitepickaxe::Envelope& env);
@@ -95,13 +93,17 @@ private:
     void init_router();
     void send_envelope(const infinitepickaxe::Envelope& env);
     void send_error(const std::string& code, const std::string& message);
+    // 에러 알림 전송이 끝나면 세션 종료
+    void send_error_and_close(const std::string& code, const std::string& message);
     bool is_expired() const;
     void start_auth_timer();
     void close();
 
     // 채굴 시뮬레이션 헬퍼 메서드
     void start_new_mineral();
-    void send_mining_update(const std::vector<infinitepickaxe::PickaxeAttack>& attacks);
+    void send_mining_update();
+    // env.mining_update에 공격 목록이 채워진 상태로 받아 광물 상태를 채운 뒤 전송
+    void send_mining_update(infinitepickaxe::Envelope& env);
     void handle_mining_complete_immediate();
     void apply_slot_update(uint32_t slot_index, uint64_t attack_power, float attack_speed,
                            uint32_t critical_hit_percent, uint32_t critical_damage);
@@ -128,7 +130,7 @@ private:
     GemService& gem_service_;
     RedisClient& redis_;
     std::shared_ptr<SessionRegistry> registry_;
-    const class MetadataLoader& metadata_;
+    const class MetadataStore& metadata_;
 
     // 세션 컨텍스트
     std::string user_id_;
@@ -139,7 +141,18 @@ private:
     bool authenticated_{false};
     bool closed_{false};
     uint32_t expected_seq_{1};
-    uint32_t violation_count_{0};
+    MessageRateLimiter message_limiter_;
+    std::optional<RngStream> crit_rng_;
+    // 트래픽 캡처 (nullptr 또는 capture_id_ 0이면 기록 안 함)
+    TrafficCapture* capture_{nullptr};
+    uint32_t capture_id_{0};
+    // 재접속 복원 (nullptr이면 끔). 중복 로그인/서버 종료로 닫힐 때는 저장하지 않음
+    SessionSnapshotStore* resume_store_{nullptr};
+    std::string resume_token_;
+    bool resumable_{true};
+    // 노드 간 중복 로그인 감지 (nullptr이면 노드 안에서만 감지)
+    SessionOwnership* ownership_{nullptr};
+    uint64_t owner_token_{0};
 
     // 채굴 시뮬레이션 상태
     MiningState mining_state_;
@@ -151,4 +164,8 @@ private:
 
     std::array<uint8_t, 4> len_buf_{};
     std::vector<uint8_t> payload_buf_;
+
+    // 레지스트리 침투형 리스트 노드 (SessionRegistry만 접근)
+    SessionRegistryNode registry_node_;
+    friend class SessionRegistry;
 };
@@ -0,0 +1,183 @@
+#include "session_ownership.h"
+#include "metrics.h"
+#include "request_trace.h"
+#include <sw/redis++/redis++.h>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+constexpr char kOwnerKeyPrefix[] = "owner:";
+constexpr char kKickChannelPrefix[] = "session:kick:";
+constexpr auto kConsumeTimeout = std::chrono::milliseconds(1000);
+constexpr auto kResubscribeDelay = std::chrono::seconds(1);
+
+// KEYS[1] = 소유 키, ARGV = 새 값, TTL(ms), 이 노드 id, user_id
+// 이전 값을 돌려주고, 이전 소유자가 다른 노드면 같은 스크립트 안에서 킥 발행 (왕복 1회)
+constexpr char kTakeOverScript[] = R"lua(
+local old = redis.call('GET', KEYS[1])
+redis.call('SET', KEYS[1], ARGV[1], 'PX', ARGV[2])
+if old and old ~= ARGV[1] then
+  local sep = string.find(old, '|', 1, true)
+  if sep then
+    local node = string.sub(old, 1, sep - 1)
+    if node ~= ARGV[3] then
+      redis.call('PUBLISH', 'session:kick:' .. node, ARGV[4] .. '|' .. string.sub(old, sep + 1))
+    end
+  end
+end
+return old
+)lua";
+
+// 값이 자기 것일 때만 삭제 (이미 다른 세션이 넘겨받았으면 유지)
+constexpr char kReleaseScript[] = R"lua(
+if redis.call('GET', KEYS[1]) == ARGV[1] then
+  return redis.call('DEL', KEYS[1])
+end
+return 0
+)lua";
+} // namespace
+
+SessionOwnership::SessionOwnership(const Options& options)
+    : options_(options),
+      node_id_(options.node_id.empty() ? make_node_id() : options.node_id),
+      channel_(kKickChannelPrefix + node_id_) {
+    sw::redis::ConnectionOptions opts;
+    opts.host = options_.host;
+    opts.port = static_cast<int>(options_.port);
+    sw::redis::ConnectionPoolOptions pool;
+    pool.size = options_.pool_size;
+    redis_ = std::make_unique<sw::redis::Redis>(opts, pool);
+}
+
+SessionOwnership::~SessionOwnership() {
+    stop();
+}
+
+std::string SessionOwnership::make_node_id() {
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) != 0 || host[0] == '\0') {
+        std::snprintf(host, sizeof(host), "node");
+    }
+    return std::string(host) + "-" + std::to_string(::getpid());
+}
+
+void SessionOwnership::start(KickHandler on_kick) {
+    if (running_.exchange(true)) return;
+    on_kick_ = std::move(on_kick);
+    subscriber_ = std::thread([this]() { subscribe_loop(); });
+    spdlog::info("Session ownership enabled, node {} listening on {}", node_id_, channel_);
+}
+
+void SessionOwnership::stop() {
+    if (!running_.exchange(false)) return;
+    if (subscriber_.joinable()) subscriber_.join();
+}
+
+SessionOwnership::Claim SessionOwnership::claim(const std::string& user_id, uint64_t owner_token,
+                                                std::chrono::system_clock::time_point expires_at) {
+    const std::string key = kOwnerKeyPrefix + user_id;
+    const std::string value = owner_value(owner_token);
+    std::chrono::milliseconds ttl = options_.fallback_ttl;
+    if (expires_at.time_since_epoch().count() != 0) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            expires_at - std::chrono::system_clock::now());
+        if (remaining.count() > 0) ttl = remaining;
+    }
+
+    try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
+        claims_.fetch_add(1, std::memory_order_relaxed);
+        if (redis_->set(key, value, ttl, sw::redis::UpdateType::NOT_EXIST)) {
+            return Claim::Acquired;
+        }
+
+        const std::vector<std::string> keys{key};
+        const std::vector<std::string> args{value, std::to_string(ttl.count()), node_id_, user_id};
+        auto previous = redis_->eval<sw::redis::OptionalString>(kTakeOverScript, keys.begin(), keys.end(),
+                                                                args.begin(), args.end());
+        if (!previous) return Claim::Acquired; // NX 실패 직후 만료/삭제됨
+        if (*previous == value) return Claim::Reclaimed;
+
+        takeovers_.fetch_add(1, std::memory_order_relaxed);
+        const auto sep = previous->find('|');
+        const std::string previous_node = previous->substr(0, sep);
+        if (sep != std::string::npos && previous_node != node_id_) {
+            kicks_sent_.fetch_add(1, std::memory_order_relaxed);
+            spdlog::info("Session for user {} taken over from node {}", user_id, previous_node);
+        }
+        return Claim::TookOver;
+    } catch (const std::exception& ex) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        spdlog::warn("Session ownership claim failed for user {}: {}", user_id, ex.what());
+        return Claim::Failed;
+    }
+}
+
+void SessionOwnership::release(const std::string& user_id, uint64_t owner_token) {
+    try {
+        metrics::ScopedTimer timer(metrics::Histogram::RedisLatency);
+        request_trace::PhaseScope phase(request_trace::Phase::Redis);
+        const std::vector<std::string> keys{kOwnerKeyPrefix + user_id};
+        const std::vector<std::string> args{owner_value(owner_token)};
+        redis_->eval<long long>(kReleaseScript, keys.begin(), keys.end(), args.begin(), args.end());
+    } catch (const std::exception& ex) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        spdlog::warn("Session ownership release failed for user {}: {}", user_id, ex.what());
+    }
+}
+
+SessionOwnership::Stats SessionOwnership::stats() const {
+    Stats s;
+    s.claims = claims_.load(std::memory_order_relaxed);
+    s.takeovers = takeovers_.load(std::memory_order_relaxed);
+    s.kicks_sent = kicks_sent_.load(std::memory_order_relaxed);
+    s.kicks_received = kicks_received_.load(std::memory_order_relaxed);
+    s.errors = errors_.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::string SessionOwnership::owner_value(uint64_t owner_token) const {
+    return node_id_ + "|" + std::to_string(owner_token);
+}
+
+void SessionOwnership::subscribe_loop() {
+    while (running_) {
+        try {
+            // 구독 연결은 consume 타임아웃으로 running_을 주기적으로 확인하도록 따로 만든다
+            sw::redis::ConnectionOptions opts;
+            opts.host = options_.host;
+            opts.port = static_cast<int>(options_.port);
+            opts.socket_timeout = kConsumeTimeout;
+            sw::redis::Redis redis(opts);
+            auto sub = redis.subscriber();
+            sub.on_message([this](std::string /*channel*/, std::string msg) {
+                const auto sep = msg.rfind('|');
+                if (sep == std::string::npos) return;
+                char* end = nullptr;
+                const uint64_t token = std::strtoull(msg.c_str() + sep + 1, &end, 10);
+                if (!end || *end != '\0' || token == 0) return;
+                kicks_received_.fetch_add(1, std::memory_order_relaxed);
+                if (on_kick_) on_kick_(msg.substr(0, sep), token);
+            });
+            sub.subscribe(channel_);
+            while (running_) {
+                try {
+                    sub.consume();
+                } catch (const sw::redis::TimeoutError&) {
+                    // 메시지 없음
+                }
+            }
+        } catch (const std::exception& ex) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            spdlog::warn("Session kick subscription {} failed: {}, retrying", channel_, ex.what());
+            const auto resume_at = std::chrono::steady_clock::now() + kResubscribeDelay;
+            while (running_ && std::chrono::steady_clock::now() < resume_at) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace sw { namespace redis { class Redis; } }
+
+// 여러 게임 서버 노드 간 중복 로그인 감지 (Redis)
+// - 소유 키 owner:{user_id} = "<node_id>|<owner_token>", TTL은 JWT 만료까지
+//   로그인 시 SET NX로 잡고, 이미 있으면 Lua로 이전 값을 읽으며 덮어쓴다 (마지막 로그인이 이김)
+// - 이전 소유자가 다른 노드면 그 노드 채널 session:kick:<node_id>에 "user_id|owner_token" 발행
+//   → 받은 노드는 해당 세션만 notify_duplicate_and_close (같은 유저의 더 새 세션은 건드리지 않음)
+// - 같은 노드 안의 중복은 SessionRegistry가 처리하므로 발행하지 않는다
+// - 세션 종료 시 값이 자기 것일 때만 삭제. 노드가 죽어 남은 키는 다음 로그인이 덮어쓴다
+// Redis 장애 시에는 로그만 남기고 노드 내 감지로 동작한다.
+class SessionOwnership {
+public:
+    struct Options {
+        std::string host;
+        unsigned short port = 6379;
+        std::string node_id;                      // 비어 있으면 make_node_id()
+        std::chrono::seconds fallback_ttl{86400}; // JWT 만료 시각이 없을 때
+        std::size_t pool_size = 4;
+    };
+
+    enum class Claim {
+        Acquired,  // 소유자 없음
+        Reclaimed, // 이미 이 세션이 소유 (재시도)
+        TookOver,  // 다른 세션에서 넘겨받음 (다른 노드면 킥 발행)
+        Failed     // Redis 오류
+    };
+
+    struct Stats {
+        uint64_t claims{0};
+        uint64_t takeovers{0};
+        uint64_t kicks_sent{0};
+        uint64_t kicks_received{0};
+        uint64_t errors{0};
+    };
+
+    // 구독 스레드에서 호출된다 (io_context로 넘겨서 처리할 것)
+    using KickHandler = std::function<void(const std::string& user_id, uint64_t owner_token)>;
+
+    explicit SessionOwnership(const Options& options);
+    ~SessionOwnership();
+
+    SessionOwnership(const SessionOwnership&) = delete;
+    SessionOwnership& operator=(const SessionOwnership&) = delete;
+
+    static std::string make_node_id(); // hostname-pid
+
+    void start(KickHandler on_kick);
+    void stop();
+
+    // 세션마다 하나 (노드 안에서만 유일하면 됨)
+    uint64_t next_owner_token() { return next_token_.fetch_add(1, std::memory_order_relaxed); }
+
+    Claim claim(const std::string& user_id, uint64_t owner_token,
+                std::chrono::system_clock::time_point expires_at);
+    void release(const std::string& user_id, uint64_t owner_token);
+
+    const std::string& node_id() const { return node_id_; }
+    Stats stats() const;
+
+private:
+    std::string owner_value(uint64_t owner_token) const;
+    void subscribe_loop();
+
+    Options options_;
+    std::string node_id_;
+    std::string channel_;
+    std::unique_ptr<sw::redis::Redis> redis_;
+    std::atomic<uint64_t> next_token_{1};
+    KickHandler on_kick_;
+    std::atomic<bool> running_{false};
+    std::thread subscriber_;
+
+    std::atomic<uint64_t> claims_{0};
+    std::atomic<uint64_t> takeovers_{0};
+    std::atomic<uint64_t> kicks_sent_{0};
+    std::atomic<uint64_t> kicks_received_{0};
+    std::atomic<uint64_t> errors_{0};
+};
@@ -1,40 +1,183 @@
 #include "session_registry.h"
 #include "session.h"
-#include <vector>
+#include <functional>
+#include <thread>
+
+SessionRegistry::~SessionRegistry() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& [user_id, session] : shard.by_user) {
+            node_of(*session).shard.store(-1, std::memory_order_relaxed);
+        }
+        shard.by_user.clear();
+        shard.head.store(nullptr, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(retired_mutex_);
+    retired_.clear();
+}
+
+std::size_t SessionRegistry::shard_index(const std::string& user_id) const {
+    return std::hash<std::string>{}(user_id) % kShardCount;
+}
+
+SessionRegistryNode& SessionRegistry::node_of(Session& session) {
+    return session.registry_node_;
+}
+
+void SessionRegistry::link(Shard& shard, int shard_index, SessionRegistryNode& node) {
+    auto* head = shard.head.load(std::memory_order_relaxed);
+    node.prev = nullptr;
+    node.next.store(head, std::memory_order_relaxed);
+    if (head) head->prev = &node;
+    node.shard.store(shard_index, std::memory_order_relaxed);
+    // 노드 초기화가 끝난 뒤 게시 (순회자는 acquire로 읽음)
+    shard.head.store(&node, std::memory_order_release);
+}
+
+void SessionRegistry::unlink(Shard& shard, SessionRegistryNode& node) {
+    auto* next = node.next.load(std::memory_order_relaxed);
+    if (node.prev) {
+        node.prev->next.store(next, std::memory_order_release);
+    } else {
+        shard.head.store(next, std::memory_order_release);
+    }
+    if (next) next->prev = node.prev;
+    // node.next는 그대로 둔다: 이 노드 위에 있던 순회자가 계속 진행할 수 있어야 함
+    node.prev = nullptr;
+    node.shard.store(-1, std::memory_order_relaxed);
+}
+
+void SessionRegistry::detach_stale(Shard& shard, const Session* session, const std::string& keep_user_id) {
+    for (auto it = shard.by_user.begin(); it != shard.by_user.end(); ++it) {
+        if (it->second.get() == session && it->first != keep_user_id) {
+            shard.by_user.erase(it);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
 
 std::shared_ptr<Session> SessionRegistry::replace_session(const std::string& user_id,
                                                           const std::shared_ptr<Session>& session) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto& node = node_of(*session);
+    if (!node.session) node.session = session.get(); // 첫 등록 전에는 순회자가 볼 수 없음
+    const auto target = shard_index(user_id);
+
+    // 다른 샤드에 다른 user_id로 등록돼 있으면 먼저 해제 (같은 세션의 재인증)
+    const int linked = node.shard.load(std::memory_order_relaxed);
+    if (linked >= 0 && static_cast<std::size_t>(linked) != target) {
+        auto& old_shard = shards_[static_cast<std::size_t>(linked)];
+        std::lock_guard<std::mutex> lock(old_shard.mutex);
+        if (node.shard.load(std::memory_order_relaxed) == linked) {
+            detach_stale(old_shard, session.get(), user_id);
+            unlink(old_shard, node);
+        }
+    }
+
     std::shared_ptr<Session> previous;
-    auto it = sessions_.find(user_id);
-    if (it != sessions_.end()) {
-        previous = it->second.lock();
+    {
+        auto& shard = shards_[target];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.by_user.find(user_id);
+        if (it != shard.by_user.end()) {
+            if (it->second.get() == session.get()) {
+                // 같은 세션의 재등록: 리스트는 그대로 두고 기존처럼 자신을 반환
+                return it->second;
+            }
+            previous = it->second;
+            unlink(shard, node_of(*previous));
+            it->second = session;
+        } else {
+            shard.by_user.emplace(user_id, session);
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (node.shard.load(std::memory_order_relaxed) >= 0) {
+            detach_stale(shard, session.get(), user_id);
+            unlink(shard, node);
+        }
+        link(shard, static_cast<int>(target), node);
     }
-    sessions_[user_id] = session;
+
+    // 이전 세션은 호출자에게 반환하되, 레지스트리의 참조는 진행 중인 순회가 끝난 뒤 놓는다
+    if (previous) retire(previous);
     return previous;
 }
 
 void SessionRegistry::remove_if_match(const std::string& user_id, const Session* session) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = sessions_.find(user_id);
-    if (it != sessions_.end()) {
-        auto cur = it->second.lock();
-        if (!cur || cur.get() == session) {
-            sessions_.erase(it);
+    std::shared_ptr<Session> removed;
+    {
+        auto& shard = shards_[shard_index(user_id)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.by_user.find(user_id);
+        if (it == shard.by_user.end() || it->second.get() != session) {
+            return;
         }
+        removed = std::move(it->second);
+        shard.by_user.erase(it);
+        unlink(shard, node_of(*removed));
+        size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    retire(std::move(removed));
+}
+
+std::shared_ptr<Session> SessionRegistry::find(const std::string& user_id) {
+    auto& shard = shards_[shard_index(user_id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.by_user.find(user_id);
+    if (it == shard.by_user.end()) return nullptr;
+    return it->second;
+}
+
+void SessionRegistry::retire(std::shared_ptr<Session> session) {
+    // 리스트에서 뺀 뒤의 epoch. 이보다 이전에 시작한 순회만 이 세션을 볼 수 있다.
+    const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    {
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        retired_.push_back(Retired{epoch, std::move(session)});
     }
+    reclaim();
 }
 
-std::vector<std::shared_ptr<Session>> SessionRegistry::get_all_sessions() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<std::shared_ptr<Session>> result;
+void SessionRegistry::reclaim() {
+    std::vector<std::shared_ptr<Session>> released;
+    {
+        // 슬롯 스캔은 잠금 안에서: 스캔 이후에 들어온 항목을 이전 스캔 결과로 회수하지 않도록
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        if (retired_.empty()) return;
 
-    for (auto& pair : sessions_) {
-        auto session = pair.second.lock();
-        if (session) {
-            result.push_back(session);
+        uint64_t min_active = UINT64_MAX;
+        for (auto& slot : reader_epochs_) {
+            uint64_t e = slot.load(std::memory_order_seq_cst);
+            if (e != 0 && e < min_active) min_active = e;
         }
+
+        auto keep = retired_.begin();
+        for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+            if (it->epoch <= min_active) {
+                released.push_back(std::move(it->session));
+            } else {
+                *keep++ = std::move(*it);
+            }
+        }
+        retired_.erase(keep, retired_.end());
     }
+    // 세션 소멸자는 잠금 밖에서 실행
+}
+
+std::size_t SessionRegistry::enter_read() {
+    while (true) {
+        const uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        for (std::size_t i = 0; i < kReaderSlots; ++i) {
+            uint64_t expected = 0;
+            if (reader_epochs_[i].compare_exchange_strong(expected, epoch, std::memory_order_seq_cst)) {
+                return i;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
 
-    return result;
+void SessionRegistry::exit_read(std::size_t slot) {
+    reader_epochs_[slot].store(0, std::memory_order_seq_cst);
+    reclaim();
 }
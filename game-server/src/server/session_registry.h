@@ -1,4 +1,8 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -7,9 +11,29 @@
 
 class Session;
 
-// 간단한 세션 레지스트리: user_id 기준으로 마지막 세션을 관리
+// 세션에 내장되는 레지스트리 리스트 노드 (Session::registry_node_)
+// next는 잠금 없이 순회하는 쪽이 읽으므로 atomic, prev는 샤드 mutex로 보호
+// shard는 소속 샤드 mutex 아래에서만 바뀌지만 다른 샤드에서 확인하므로 atomic
+struct SessionRegistryNode {
+    std::atomic<SessionRegistryNode*> next{nullptr};
+    SessionRegistryNode* prev{nullptr};
+    Session* session{nullptr};
+    std::atomic<int> shard{-1}; // -1 = 미등록
+};
+
+// 세션 레지스트리: user_id 기준으로 마지막 세션을 관리
+// - user_id 해시로 샤드를 나눠 로그인/종료 시 잠금 경합을 분산
+// - 샤드별 침투형(intrusive) 리스트를 epoch 보호 하에 잠금 없이 순회 (할당/refcount 증가 없음)
+// - 등록 해제된 세션은 진행 중인 순회가 모두 끝난 뒤에 참조를 놓는다
 class SessionRegistry {
 public:
+    static constexpr std::size_t kShardCount = 32;
+
+    SessionRegistry() = default;
+    ~SessionRegistry();
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+
     // 새 세션을 등록하고, 이전 세션(존재 시)을 반환한다.
     std::shared_ptr<Session> replace_session(const std::string& user_id,
                                              const std::shared_ptr<Session>& session);
@@ -17,10 +41,70 @@ public:
     // 세션 종료 시 등록 해제 (매칭되는 경우에만)
     void remove_if_match(const std::string& user_id, const Session* session);
 
-    // 모든 활성 세션 가져오기 (채굴 틱 업데이트용)
-    std::vector<std::shared_ptr<Session>> get_all_sessions();
+    // user_id로 현재 세션 조회 (대상 지정 푸시용, O(1))
+    std::shared_ptr<Session> find(const std::string& user_id);
+
+    // 모든 등록 세션 순회 (채굴 틱 업데이트용). 콜백 안에서 세션을 닫거나 등록/해제해도 안전하다.
+    // 순회 중 새로 등록된 세션은 이번 순회에서 빠질 수 있다.
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        ReadGuard guard(*this);
+        for (auto& shard : shards_) {
+            for (auto* node = shard.head.load(std::memory_order_acquire); node;
+                 node = node->next.load(std::memory_order_acquire)) {
+                fn(*node->session);
+            }
+        }
+    }
+
+    std::size_t size() const { return size_.load(std::memory_order_relaxed); }
 
 private:
-    std::unordered_map<std::string, std::weak_ptr<Session>> sessions_;
-    std::mutex mutex_;
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<Session>> by_user; // 등록 중에는 강한 참조 유지
+        std::atomic<SessionRegistryNode*> head{nullptr};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        std::shared_ptr<Session> session;
+    };
+
+    static constexpr std::size_t kReaderSlots = 64;
+
+    class ReadGuard {
+    public:
+        explicit ReadGuard(SessionRegistry& registry) : registry_(registry), slot_(registry.enter_read()) {}
+        ~ReadGuard() { registry_.exit_read(slot_); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        SessionRegistry& registry_;
+        std::size_t slot_;
+    };
+
+    std::size_t shard_index(const std::string& user_id) const;
+    static SessionRegistryNode& node_of(Session& session);
+
+    // 샤드 mutex 보유 상태에서 호출
+    static void link(Shard& shard, int shard_index, SessionRegistryNode& node);
+    static void unlink(Shard& shard, SessionRegistryNode& node);
+    // 샤드 안에서 다른 user_id로 등록된 같은 세션을 제거 (재인증)
+    void detach_stale(Shard& shard, const Session* session, const std::string& keep_user_id);
+    void retire(std::shared_ptr<Session> session);
+
+    std::size_t enter_read();
+    void exit_read(std::size_t slot);
+    void reclaim();
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<std::size_t> size_{0};
+
+    // epoch 기반 회수: 순회자는 시작 epoch를 슬롯에 게시(0 = 비어 있음)
+    std::atomic<uint64_t> epoch_{1};
+    std::array<std::atomic<uint64_t>, kReaderSlots> reader_epochs_{};
+    std::mutex retired_mutex_;
+    std::vector<Retired> retired_;
 };
@@ -0,0 +1,94 @@
+#include "session_snapshot_store.h"
+#include <random>
+
+SessionSnapshotStore::SessionSnapshotStore(const Options& options) : options_(options) {}
+
+std::string SessionSnapshotStore::issue_token() {
+    static constexpr char kHex[] = "0123456789abcdef";
+    thread_local std::random_device rd;
+    std::string token(32, '0');
+    for (std::size_t i = 0; i < 4; ++i) {
+        const uint32_t bits = rd();
+        for (std::size_t j = 0; j < 8; ++j) {
+            token[i * 8 + j] = kHex[(bits >> (j * 4)) & 0xF];
+        }
+    }
+    return token;
+}
+
+void SessionSnapshotStore::save(const std::string& token, SessionSnapshot snapshot, Clock::time_point now) {
+    if (token.empty() || snapshot.user_id.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto user = by_user_.find(snapshot.user_id);
+    if (user != by_user_.end()) {
+        auto previous = entries_.find(user->second);
+        if (previous != entries_.end()) erase_locked(previous);
+    }
+    if (auto existing = entries_.find(token); existing != entries_.end()) erase_locked(existing);
+
+    const auto expires = now + options_.ttl;
+    by_user_[snapshot.user_id] = token;
+    entries_.emplace(token, Entry{std::move(snapshot), expires});
+    order_.emplace_back(expires, token);
+    ++stats_.saved;
+    prune_locked(now);
+}
+
+std::optional<SessionSnapshot> SessionSnapshotStore::take(const std::string& token, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(token);
+    if (it == entries_.end() || it->second.expires <= now) {
+        if (it != entries_.end()) erase_locked(it);
+        ++stats_.missed;
+        return std::nullopt;
+    }
+    // 노드째 떼어낸 뒤 by_user_를 정리하고 나서 스냅샷을 옮긴다 (옮긴 뒤엔 user_id가 비어 있음)
+    auto node = entries_.extract(it);
+    forget_user_locked(node.mapped().snapshot.user_id, node.key());
+    ++stats_.taken;
+    return std::move(node.mapped().snapshot);
+}
+
+void SessionSnapshotStore::invalidate_user(const std::string& user_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto user = by_user_.find(user_id);
+    if (user == by_user_.end()) return;
+    auto it = entries_.find(user->second);
+    if (it != entries_.end()) {
+        erase_locked(it);
+    } else {
+        by_user_.erase(user);
+    }
+}
+
+SessionSnapshotStore::Stats SessionSnapshotStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = stats_;
+    s.entries = entries_.size();
+    return s;
+}
+
+void SessionSnapshotStore::erase_locked(std::unordered_map<std::string, Entry>::iterator it) {
+    forget_user_locked(it->second.snapshot.user_id, it->first);
+    entries_.erase(it);
+}
+
+void SessionSnapshotStore::forget_user_locked(const std::string& user_id, const std::string& token) {
+    auto user = by_user_.find(user_id);
+    if (user != by_user_.end() && user->second == token) by_user_.erase(user);
+}
+
+void SessionSnapshotStore::prune_locked(Clock::time_point now) {
+    while (!order_.empty()) {
+        const auto& [expires, token] = order_.front();
+        const bool expired = expires <= now;
+        if (!expired && entries_.size() <= options_.max_entries) break;
+        // 같은 토큰으로 다시 저장된 항목은 만료 시각이 달라서 건드리지 않는다
+        auto it = entries_.find(token);
+        if (it != entries_.end() && it->second.expires == expires) {
+            if (!expired) ++stats_.evicted;
+            erase_locked(it);
+        }
+        order_.pop_front();
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "mining_tick.h"
+
+// 재접속 시 세션 복원용 스냅샷 (이 프로세스의 메모리에만 보관)
+struct SessionSnapshot {
+    std::string user_id;
+    std::string device_id;
+    std::string google_id;
+    std::chrono::system_clock::time_point expires_at; // JWT 만료 시각
+    MiningState mining;
+    float play_time_accum_ms{0.0f};
+    float mining_cache_accum_ms{0.0f};
+    uint64_t next_daily_reset_ms{0};
+    uint64_t saved_at_ms{0};        // 게임 시계 기준 저장 시각 (리스폰 대기 경과 계산)
+    uint64_t metadata_version{0};
+};
+
+// 재접속 토큰 → 세션 스냅샷 저장소
+// - 연결이 끊길 때 Session이 저장하고, TTL 안에 같은 토큰으로 핸드셰이크하면 꺼내서(1회용) DB 조회 없이 복원
+// - 사용자당 스냅샷 1개: 새로 저장하거나 전체 핸드셰이크를 하면 이전 것은 버린다
+// - TTL이 고정이라 저장 순서 = 만료 순서 → 저장할 때 앞에서부터 만료/초과분을 정리
+class SessionSnapshotStore {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::chrono::seconds ttl{300};
+        std::size_t max_entries = 100000;
+    };
+
+    struct Stats {
+        uint64_t saved{0};
+        uint64_t taken{0};
+        uint64_t missed{0};  // 없거나 만료된 토큰
+        uint64_t evicted{0}; // 상한 초과로 TTL 전에 버린 스냅샷
+        std::size_t entries{0};
+    };
+
+    explicit SessionSnapshotStore(const Options& options);
+
+    SessionSnapshotStore(const SessionSnapshotStore&) = delete;
+    SessionSnapshotStore& operator=(const SessionSnapshotStore&) = delete;
+
+    // 128비트 랜덤 토큰 (hex 32자)
+    static std::string issue_token();
+
+    void save(const std::string& token, SessionSnapshot snapshot, Clock::time_point now = Clock::now());
+    std::optional<SessionSnapshot> take(const std::string& token, Clock::time_point now = Clock::now());
+    void invalidate_user(const std::string& user_id);
+
+    Stats stats() const;
+
+private:
+    struct Entry {
+        SessionSnapshot snapshot;
+        Clock::time_point expires;
+    };
+
+    void erase_locked(std::unordered_map<std::string, Entry>::iterator it);
+    void forget_user_locked(const std::string& user_id, const std::string& token);
+    void prune_locked(Clock::time_point now);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;       // token → 스냅샷
+    std::unordered_map<std::string, std::string> by_user_; // user_id → token
+    std::deque<std::pair<Clock::time_point, std::string>> order_; // 저장 순서 (꺼내거나 버린 항목도 남아 있을 수 있음)
+    Stats stats_;
+};
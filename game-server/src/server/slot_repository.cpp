@@ -5,8 +5,8 @@
 std::vector<PickaxeSlot> SlotRepository::get_user_slots(const std::string& user_id) {
     std::vector<PickaxeSlot> slots;
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
         auto res = tx.exec_params(
             "SELECT slot_id, user_id, slot_index, level, tier, "
             "       attack_power, attack_speed_x100, critical_hit_percent, "
@@ -40,8 +40,8 @@ std::vector<PickaxeSlot> SlotRepository::get_user_slots(const std::string& user_
 
 std::optional<PickaxeSlot> SlotRepository::get_slot(const std::string& user_id, uint32_t slot_index) {
     try {
-        auto conn = pool_.acquire();
-        pqxx::work tx(*conn);
+        auto conn = pool_.acquire_read(user_id);
+        pqxx::read_transaction tx(*conn);
         auto res = tx.exec_params(
             "SELECT slot_id, user_id, slot_index, level, tier, "
             "       attack_power, attack_speed_x100, critical_hit_percent, "
@@ -81,7 +81,7 @@ bool SlotRepository::create_slot(const std::string& user_id, uint32_t slot_index
                                    uint32_t critical_hit_percent, uint32_t critical_damage,
                                    uint64_t dps) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         tx.exec_params(
             "INSERT INTO game_schema.pickaxe_slots "
@@ -108,7 +108,7 @@ bool SlotRepository::update_slot(const std::string& user_id, uint32_t slot_index
                                    uint32_t new_critical_hit_percent, uint32_t new_critical_damage,
                                    uint64_t new_dps, uint32_t new_pity_bonus) {
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
         tx.exec_params(
             "UPDATE game_schema.pickaxe_slots "
@@ -134,7 +134,7 @@ bool SlotRepository::update_slot(const std::string& user_id, uint32_t slot_index
 SlotUnlockDBResult SlotRepository::create_and_unlock_slot(const PickaxeSlot& slot, uint32_t crystal_cost) {
     SlotUnlockDBResult result{};
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(slot.user_id);
         pqxx::work tx(*conn);
 
         // user_game_data 잠금 후 해금 여부/크리스탈 확인
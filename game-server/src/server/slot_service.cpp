@@ -1,4 +1,5 @@
 #include "slot_service.h"
+#include "pickaxe_stats.h"
 #include <spdlog/spdlog.h>
 #include <array>
 #include <cmath>
@@ -19,23 +20,6 @@ std::optional<uint32_t> crystal_cost_for_slot(uint32_t slot_index)
     return kSlotCrystalCosts[slot_index];
 }
 
-uint64_t compute_expected_dps(uint64_t attack_power, uint32_t attack_speed_x100,
-                              uint32_t crit_percent, uint32_t crit_damage,
-                              uint64_t fallback_dps)
-{
-    double attack_speed = static_cast<double>(attack_speed_x100) / 100.0;
-    double crit_rate = static_cast<double>(crit_percent) / 10000.0;
-    double crit_mult = static_cast<double>(crit_damage) / 10000.0;
-    double expected = static_cast<double>(attack_power) * attack_speed *
-                      (1.0 + crit_rate * (crit_mult - 1.0));
-    uint64_t dps = static_cast<uint64_t>(std::llround(expected));
-    if (dps == 0)
-    {
-        dps = fallback_dps;
-    }
-    return dps;
-}
-
 PickaxeSlot build_base_slot(const std::string& user_id, uint32_t slot_index, const MetadataLoader& meta)
 {
     PickaxeSlot slot{};
@@ -91,7 +75,7 @@ void fill_slot_info(const PickaxeSlot& slot, infinitepickaxe::PickaxeSlotInfo* s
     slot_info->set_is_unlocked(true);
 
     // 보석 슬롯 정보 추가 (항상 6개 슬롯 정보 생성)
-    auto gem_slots_from_db = gem_repo.get_gem_slots_for_pickaxe(slot.slot_id);
+    auto gem_slots_from_db = gem_repo.get_gem_slots_for_pickaxe(slot.user_id, slot.slot_id);
 
     // DB에서 가져온 보석 슬롯을 map으로 변환 (gem_slot_index -> GemSlotData)
     std::unordered_map<uint32_t, GemSlotData> gem_slot_map;
@@ -124,21 +108,9 @@ void fill_slot_info(const PickaxeSlot& slot, infinitepickaxe::PickaxeSlotInfo* s
                     gem_info->set_icon(gem_def->icon);
                     gem_info->set_stat_multiplier(gem_def->stat_multiplier);
 
-                    // GemGrade enum 변환
-                    if (const auto* grade = meta.gem_grade(gem_def->grade_id)) {
-                        if (grade->grade == "COMMON") gem_info->set_grade(infinitepickaxe::COMMON);
-                        else if (grade->grade == "RARE") gem_info->set_grade(infinitepickaxe::RARE);
-                        else if (grade->grade == "EPIC") gem_info->set_grade(infinitepickaxe::EPIC);
-                        else if (grade->grade == "HERO") gem_info->set_grade(infinitepickaxe::HERO);
-                        else if (grade->grade == "LEGENDARY") gem_info->set_grade(infinitepickaxe::LEGENDARY);
-                    }
-
-                    // GemType enum 변환
-                    if (const auto* type = meta.gem_type(gem_def->type_id)) {
-                        if (type->type == "ATTACK_SPEED") gem_info->set_type(infinitepickaxe::ATTACK_SPEED);
-                        else if (type->type == "CRIT_RATE") gem_info->set_type(infinitepickaxe::CRIT_RATE);
-                        else if (type->type == "CRIT_DMG") gem_info->set_type(infinitepickaxe::CRIT_DMG);
-                    }
+                    // grade/type enum은 메타데이터 로드 시 변환됨
+                    if (gem_def->grade_enum != infinitepickaxe::GEM_GRADE_UNKNOWN) gem_info->set_grade(gem_def->grade_enum);
+                    if (gem_def->type_enum != infinitepickaxe::GEM_TYPE_UNKNOWN) gem_info->set_type(gem_def->type_enum);
                 }
             }
         } else {
@@ -152,10 +124,11 @@ void fill_slot_info(const PickaxeSlot& slot, infinitepickaxe::PickaxeSlotInfo* s
 infinitepickaxe::AllSlotsResponse SlotService::handle_all_slots(const std::string& user_id) const {
     infinitepickaxe::AllSlotsResponse response;
 
+    auto meta = meta_.current();
     auto slots = repo_.get_user_slots(user_id);
 
     for (const auto& slot : slots) {
-        fill_slot_info(slot, response.add_slots(), gem_repo_, meta_);
+        fill_slot_info(slot, response.add_slots(), gem_repo_, *meta);
     }
 
     uint64_t total_dps = calculate_total_dps(slots);
@@ -188,7 +161,8 @@ infinitepickaxe::SlotUnlockResult SlotService::handle_unlock(const std::string&
         return res;
     }
 
-    PickaxeSlot slot = build_base_slot(user_id, slot_index, meta_);
+    auto meta = meta_.current();
+    PickaxeSlot slot = build_base_slot(user_id, slot_index, *meta);
 
     auto db_res = repo_.create_and_unlock_slot(slot, *crystal_cost);
     if (db_res.already_unlocked) {
@@ -214,7 +188,7 @@ infinitepickaxe::SlotUnlockResult SlotService::handle_unlock(const std::string&
     res.set_crystal_spent(*crystal_cost);
     res.set_remaining_crystal(db_res.remaining_crystal);
     res.set_total_dps(db_res.total_dps);
-    fill_slot_info(slot, res.mutable_new_slot(), gem_repo_, meta_);
+    fill_slot_info(slot, res.mutable_new_slot(), gem_repo_, *meta);
     return res;
 }
 
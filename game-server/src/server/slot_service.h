@@ -3,14 +3,14 @@
 #include "slot_repository.h"
 #include "game_repository.h"
 #include "gem_repository.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include <optional>
 #include <string>
 #include <vector>
 
 class SlotService {
 public:
-    SlotService(SlotRepository& repo, GameRepository& game_repo, GemRepository& gem_repo, const MetadataLoader& meta)
+    SlotService(SlotRepository& repo, GameRepository& game_repo, GemRepository& gem_repo, const MetadataStore& meta)
         : repo_(repo), game_repo_(game_repo), gem_repo_(gem_repo), meta_(meta) {}
 
     infinitepickaxe::AllSlotsResponse handle_all_slots(const std::string& user_id) const;
@@ -27,5 +27,5 @@ private:
     SlotRepository& repo_;
     GameRepository& game_repo_;
     GemRepository& gem_repo_;
-    const MetadataLoader& meta_;
+    const MetadataStore& meta_;
 };
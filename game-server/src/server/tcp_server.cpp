@@ -1,7 +1,10 @@
 #include "tcp_server.h"
 #include "session.h"
+#include "session_snapshot_store.h"
+#include "game_clock.h"
 #include <boost/asio.hpp>
 #include <iostream>
+#include <spdlog/spdlog.h>
 
 TcpServer::TcpServer(boost::asio::io_context& io,
                      unsigned short port,
@@ -15,10 +18,21 @@ TcpServer::TcpServer(boost::asio::io_context& io,
                      AdService& ad_service,
                      GemService& gem_service,
                      RedisClient& redis_client,
-                     const MetadataLoader& metadata)
-    : acceptor_(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+                     const MetadataStore& metadata,
+                     const ConnectionRateLimiter::Options& rate_limit,
+                     const MessageRatePolicy& message_rate,
+                     TrafficCapture* capture,
+                     int inherited_listen_fd,
+                     SessionSnapshotStore* resume_store,
+                     SessionOwnership* ownership)
+    : acceptor_(io),
       mining_tick_timer_(io),
+      drain_timer_(io),
       registry_(std::make_shared<SessionRegistry>()),
+      message_rate_(message_rate),
+      capture_(capture),
+      resume_store_(resume_store),
+      ownership_(ownership),
       auth_service_(auth_service),
       game_repo_(game_repo),
       mining_service_(mining_service),
@@ -30,7 +44,16 @@ TcpServer::TcpServer(boost::asio::io_context& io,
       gem_service_(gem_service),
       redis_client_(redis_client),
       metadata_(metadata) {
-    rate_limiter_ = std::make_shared<ConnectionRateLimiter>(10, std::chrono::seconds(10));
+    rate_limiter_ = std::make_shared<ConnectionRateLimiter>(rate_limit);
+    if (inherited_listen_fd >= 0) {
+        acceptor_.assign(boost::asio::ip::tcp::v4(), inherited_listen_fd);
+    } else {
+        boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+    }
 }
 
 void TcpServer::start() {
@@ -41,20 +64,19 @@ void TcpServer::start() {
 void TcpServer::do_accept() {
     acceptor_.async_accept(
         [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+            if (ec == boost::asio::error::operation_aborted || draining_) return;
             if (!ec) {
-                std::string ip;
-                try {
-                    ip = socket.remote_endpoint().address().to_string();
-                } catch (...) {
-                    ip.clear();
-                }
+                boost::system::error_code ep_ec;
+                auto remote = socket.remote_endpoint(ep_ec);
 
-                if (!ip.empty() && rate_limiter_ && !rate_limiter_->allow(ip)) {
-                    std::cout << "Connection rate limit exceeded for " << ip << std::endl;
+                if (!ep_ec && rate_limiter_ && !rate_limiter_->allow(remote.address())) {
+                    metrics::add(metrics::Counter::ConnectionsRejected);
+                    std::cout << "Connection rate limit exceeded for " << remote.address().to_string() << std::endl;
                     boost::system::error_code ignored;
                     socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
                     socket.close(ignored);
                 } else {
+                    metrics::add(metrics::Counter::ConnectionsAccepted);
                     // TCP_NODELAY 설정 (Nagle 알고리즘 비활성화 - 40ms 틱 즉시 전송)
                     boost::asio::ip::tcp::no_delay option(true);
                     boost::system::error_code ec_nodelay;
@@ -76,7 +98,11 @@ void TcpServer::do_accept() {
                                                             gem_service_,
                                                             redis_client_,
                                                             registry_,
-                                                            metadata_);
+                                                            metadata_,
+                                                            message_rate_,
+                                                            capture_,
+                                                            resume_store_,
+                                                            ownership_);
                     session->start();
                 }
             }
@@ -90,14 +116,110 @@ void TcpServer::start_mining_tick() {
 
     mining_tick_timer_.async_wait([this](boost::system::error_code ec) {
         if (!ec) {
-            // 모든 활성 세션의 채굴 시뮬레이션 업데이트
-            auto sessions = registry_->get_all_sessions();
-            for (auto& session : sessions) {
-                session->update_mining_tick(40.0f);  // 40ms
+            const auto tick_start = std::chrono::steady_clock::now();
+            metrics::observe(metrics::Histogram::TickLag, tick_start - mining_tick_timer_.expiry());
+
+            // 시뮬레이션 모드(SIM_TIME_SCALE)에서는 틱 1회에 40ms * scale만큼 게임 시간을 진행
+            const uint32_t scale = game_clock::scale();
+            if (game_clock::is_virtual()) {
+                game_clock::advance(std::chrono::milliseconds(40 * scale));
             }
+            const float delta_ms = 40.0f * static_cast<float>(scale);
+
+            // 모든 활성 세션의 채굴 시뮬레이션 업데이트
+            registry_->for_each([delta_ms](Session& session) {
+                session.update_mining_tick(delta_ms);
+            });
+            metrics::observe(metrics::Histogram::TickDuration, std::chrono::steady_clock::now() - tick_start);
 
             // 다음 틱 스케줄링 (재귀)
             start_mining_tick();
         }
     });
 }
+
+void TcpServer::drain(const DrainOptions& options, std::function<void()> on_drained) {
+    if (draining_.exchange(true)) return;
+    drain_options_ = options;
+    drain_options_.batch_size = std::max<uint32_t>(drain_options_.batch_size, 1);
+    on_drained_ = std::move(on_drained);
+
+    // 대기 중인 accept만 취소 (리슨 소켓을 넘겨줬다면 새 프로세스가 같은 큐에서 계속 받는다)
+    boost::system::error_code ignored;
+    acceptor_.cancel(ignored);
+
+    registry_->for_each([this](Session& session) { drain_queue_.push_back(session.shared_from_this()); });
+    spdlog::info("Draining {} sessions in batches of {}", drain_queue_.size(), drain_options_.batch_size);
+    boost::asio::post(drain_timer_.get_executor(), [this]() { drain_next_batch(); });
+}
+
+void TcpServer::drain_next_batch() {
+    // Redis/DB 쓰기가 한꺼번에 몰리지 않도록 배치 사이에 간격을 둔다
+    const std::size_t end = std::min(drain_queue_.size(), drain_cursor_ + drain_options_.batch_size);
+    for (; drain_cursor_ < end; ++drain_cursor_) {
+        drain_queue_[drain_cursor_]->drain_and_close();
+    }
+    if (drain_cursor_ < drain_queue_.size()) {
+        drain_timer_.expires_after(drain_options_.batch_interval);
+        drain_timer_.async_wait([this](boost::system::error_code ec) {
+            if (!ec) drain_next_batch();
+        });
+        return;
+    }
+    drain_deadline_ = std::chrono::steady_clock::now() + drain_options_.close_grace;
+    wait_sessions_closed();
+}
+
+void TcpServer::wait_sessions_closed() {
+    if (registry_->size() > 0 && std::chrono::steady_clock::now() < drain_deadline_) {
+        drain_timer_.expires_after(drain_options_.batch_interval);
+        drain_timer_.async_wait([this](boost::system::error_code ec) {
+            if (!ec) wait_sessions_closed();
+        });
+        return;
+    }
+    if (registry_->size() > 0) {
+        spdlog::warn("Drain grace expired with {} sessions still open", registry_->size());
+    }
+    spdlog::info("Drain complete: {} sessions", drain_queue_.size());
+    drain_queue_.clear();
+    boost::system::error_code ignored;
+    mining_tick_timer_.cancel(ignored);
+    acceptor_.close(ignored);
+    if (on_drained_) on_drained_();
+}
+
+void TcpServer::kick_session(const std::string& user_id, uint64_t owner_token) {
+    if (auto session = registry_->find(user_id)) {
+        session->kick_if_owner(owner_token);
+    }
+}
+
+void TcpServer::collect_metrics(metrics::Writer& writer) const {
+    writer.header("game_sessions_active", "gauge", "Authenticated sessions in the registry");
+    writer.sample("game_sessions_active", "", static_cast<double>(registry_->size()));
+
+    if (resume_store_) {
+        const auto rs = resume_store_->stats();
+        writer.header("game_session_resume_total", "counter", "Reconnect resume token lookups");
+        writer.sample("game_session_resume_total", "result=\"taken\"", static_cast<double>(rs.taken));
+        writer.sample("game_session_resume_total", "result=\"missed\"", static_cast<double>(rs.missed));
+        writer.header("game_session_snapshots_saved_total", "counter", "Session snapshots saved on disconnect");
+        writer.sample("game_session_snapshots_saved_total", "", static_cast<double>(rs.saved));
+        writer.header("game_session_snapshots_evicted_total", "counter", "Session snapshots dropped before TTL because the store was full");
+        writer.sample("game_session_snapshots_evicted_total", "", static_cast<double>(rs.evicted));
+        writer.header("game_session_snapshots", "gauge", "Session snapshots waiting for a reconnect");
+        writer.sample("game_session_snapshots", "", static_cast<double>(rs.entries));
+    }
+
+    if (!rate_limiter_) return;
+    const auto rl = rate_limiter_->stats();
+    writer.header("game_conn_limiter_decisions_total", "counter", "Connection rate limiter decisions");
+    writer.sample("game_conn_limiter_decisions_total", "result=\"allowed\"", static_cast<double>(rl.allowed));
+    writer.sample("game_conn_limiter_decisions_total", "result=\"denied_host\"", static_cast<double>(rl.denied_host));
+    writer.sample("game_conn_limiter_decisions_total", "result=\"denied_subnet\"", static_cast<double>(rl.denied_subnet));
+    writer.header("game_conn_limiter_evictions_total", "counter", "Live limiter entries overwritten because the probe window was full");
+    writer.sample("game_conn_limiter_evictions_total", "", static_cast<double>(rl.evictions));
+    writer.header("game_conn_limiter_entries", "gauge", "Tracked hosts and subnets");
+    writer.sample("game_conn_limiter_entries", "", static_cast<double>(rl.entries));
+}
@@ -12,12 +12,20 @@
 #include "gem_service.h"
 #include "session_registry.h"
 #include "connection_rate_limiter.h"
+#include "message_rate_limiter.h"
+#include "metrics.h"
 #include "redis_client.h"
 #include <memory>
 #include <vector>
 #include <string>
 #include <functional>
 #include <chrono>
+#include <atomic>
+
+class TrafficCapture;
+class Session;
+class SessionSnapshotStore;
+class SessionOwnership;
 
 class TcpServer {
 public:
@@ -33,17 +41,53 @@ public:
               AdService& ad_service,
               GemService& gem_service,
               RedisClient& redis_client,
-              const class MetadataLoader& metadata);
+              const class MetadataStore& metadata,
+              const ConnectionRateLimiter::Options& rate_limit,
+              const MessageRatePolicy& message_rate,
+              TrafficCapture* capture = nullptr,
+              int inherited_listen_fd = -1,  // 무중단 재시작: 이전 프로세스에서 넘겨받은 리슨 소켓
+              SessionSnapshotStore* resume_store = nullptr,
+              SessionOwnership* ownership = nullptr);
     void start();
 
+    // 종료 드레인: accept 중단 → 세션을 배치로 저장/알림/종료 → 모두 닫히면(또는 유예 초과) on_drained
+    struct DrainOptions {
+        uint32_t batch_size = 200;
+        std::chrono::milliseconds batch_interval{50};
+        std::chrono::milliseconds close_grace{3000}; // 마지막 배치 후 종료 알림 전송을 기다리는 한도
+    };
+    void drain(const DrainOptions& options, std::function<void()> on_drained);
+
+    // 리슨 소켓 (ListenerHandoff가 새 프로세스에 전달)
+    int listen_fd() { return acceptor_.native_handle(); }
+
+    // 다른 노드 로그인으로 소유권을 잃은 세션 종료 (io_context 스레드에서 호출)
+    void kick_session(const std::string& user_id, uint64_t owner_token);
+
+    // /metrics 수집기: 세션 수, 연결 레이트 리미터 상태
+    void collect_metrics(metrics::Writer& writer) const;
+
 private:
     void do_accept();
     void start_mining_tick();  // 40ms 채굴 틱 시작
+    void drain_next_batch();
+    void wait_sessions_closed();
 
     boost::asio::ip::tcp::acceptor acceptor_;
     boost::asio::steady_timer mining_tick_timer_;  // 40ms 타이머
+    boost::asio::steady_timer drain_timer_;
+    std::atomic<bool> draining_{false};
+    DrainOptions drain_options_;
+    std::vector<std::shared_ptr<Session>> drain_queue_;
+    std::size_t drain_cursor_{0};
+    std::chrono::steady_clock::time_point drain_deadline_;
+    std::function<void()> on_drained_;
     std::shared_ptr<SessionRegistry> registry_;
     std::shared_ptr<ConnectionRateLimiter> rate_limiter_;
+    MessageRatePolicy message_rate_;
+    TrafficCapture* capture_;
+    SessionSnapshotStore* resume_store_;
+    SessionOwnership* ownership_;
     AuthService& auth_service_;
     GameRepository& game_repo_;
     MiningService& mining_service_;
@@ -54,5 +98,5 @@ private:
     AdService& ad_service_;
     GemService& gem_service_;
     RedisClient& redis_client_;
-    const class MetadataLoader& metadata_;
+    const class MetadataStore& metadata_;
 };
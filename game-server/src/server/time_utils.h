@@ -2,6 +2,7 @@
 #include <chrono>
 #include <ctime>
 #include <cstdint>
+#include "game_clock.h"
 
 inline std::time_t timegm_compat(std::tm* tm) {
 #if defined(_WIN32)
@@ -11,12 +12,23 @@ inline std::time_t timegm_compat(std::tm* tm) {
 #endif
 }
 
+// std::gmtime은 정적 버퍼를 돌려주므로 워커 스레드에서 동시에 쓰면 안 됨
+inline std::tm gmtime_compat(std::time_t tt) {
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &tt);
+#else
+    gmtime_r(&tt, &tm);
+#endif
+    return tm;
+}
+
 inline uint64_t kst_next_midnight_ms() {
     using namespace std::chrono;
-    auto now = system_clock::now();
+    auto now = game_clock::now();
     auto now_kst = now + hours(9);
     auto tt = system_clock::to_time_t(now_kst);
-    std::tm tm = *std::gmtime(&tt);
+    std::tm tm = gmtime_compat(tt);
     tm.tm_hour = 0;
     tm.tm_min = 0;
     tm.tm_sec = 0;
@@ -0,0 +1,168 @@
+#include "traffic_capture.h"
+#include "frame_limits.h"
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace {
+
+void put_le(std::string& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+uint64_t get_le(const unsigned char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+uint64_t unix_now_us() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count());
+}
+
+} // namespace
+
+std::unique_ptr<TrafficCapture> TrafficCapture::open(const Options& options) {
+    std::error_code ec;
+    std::filesystem::create_directories(options.dir, ec);
+    const uint64_t now_us = unix_now_us();
+    const std::string path = options.dir + "/capture-" + std::to_string(now_us / 1000000) + "-" +
+                             std::to_string(::getpid()) + ".ipcap";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        spdlog::error("traffic capture: cannot open {}: {}", path, std::strerror(errno));
+        return nullptr;
+    }
+    std::string header(kMagic, sizeof(kMagic));
+    put_le(header, now_us, 8);
+    std::fwrite(header.data(), 1, header.size(), file);
+    spdlog::info("traffic capture: writing {} (sample {}%)", path, options.sample_percent);
+    return std::unique_ptr<TrafficCapture>(new TrafficCapture(file, path, options));
+}
+
+TrafficCapture::TrafficCapture(std::FILE* file, std::string path, const Options& options)
+    : file_(file), path_(std::move(path)), options_(options), start_(std::chrono::steady_clock::now()) {
+    written_ = kFileHeaderSize;
+    writer_ = std::thread([this] { flush_loop(); });
+}
+
+TrafficCapture::~TrafficCapture() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (writer_.joinable()) writer_.join();
+    std::fclose(file_);
+    auto s = stats();
+    spdlog::info("traffic capture: closed {} sessions={} records={} bytes={} dropped={}",
+                 path_, s.sessions, s.records, s.bytes, s.dropped);
+}
+
+uint32_t TrafficCapture::begin_session() {
+    if (full_.load(std::memory_order_relaxed)) return 0;
+    if (options_.sample_percent < 100) {
+        thread_local std::minstd_rand rng{std::random_device{}()};
+        if (rng() % 100 >= options_.sample_percent) return 0;
+    }
+    sessions_.fetch_add(1, std::memory_order_relaxed);
+    return next_session_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TrafficCapture::record(uint32_t session, Kind kind, const void* data, std::size_t len) {
+    if (session == 0 || full_.load(std::memory_order_relaxed)) return;
+    const auto t_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count());
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (len > kMaxResponseFrameSize || pending_.size() + kRecordHeaderSize + len > kMaxPending) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        put_le(pending_, t_us, 8);
+        put_le(pending_, session, 4);
+        pending_.push_back(static_cast<char>(kind));
+        put_le(pending_, len, 4);
+        if (len > 0) pending_.append(static_cast<const char*>(data), len);
+        wake = pending_.size() >= kFlushThreshold;
+    }
+    records_.fetch_add(1, std::memory_order_relaxed);
+    if (wake) cv_.notify_one();
+}
+
+TrafficCapture::Stats TrafficCapture::stats() const {
+    Stats s;
+    s.sessions = sessions_.load(std::memory_order_relaxed);
+    s.records = records_.load(std::memory_order_relaxed);
+    s.bytes = written_.load(std::memory_order_relaxed);
+    s.dropped = dropped_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void TrafficCapture::flush_loop() {
+    std::string batch;
+    for (;;) {
+        bool stop = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(200),
+                         [this] { return stopping_ || pending_.size() >= kFlushThreshold; });
+            batch.swap(pending_);
+            stop = stopping_;
+        }
+        if (!batch.empty()) {
+            const std::size_t n = std::fwrite(batch.data(), 1, batch.size(), file_);
+            std::fflush(file_);
+            written_.fetch_add(n, std::memory_order_relaxed);
+            if (n != batch.size()) {
+                spdlog::error("traffic capture: write failed on {}, capture stopped", path_);
+                full_ = true;
+            } else if (!full_ && written_.load(std::memory_order_relaxed) >= options_.max_bytes) {
+                spdlog::warn("traffic capture: {} reached {} bytes, capture stopped", path_, options_.max_bytes);
+                full_ = true;
+            }
+            batch.clear();
+        }
+        if (stop) break;
+    }
+}
+
+CaptureReader::~CaptureReader() {
+    if (file_) std::fclose(file_);
+}
+
+bool CaptureReader::open(const std::string& path, std::string& error) {
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) {
+        error = std::strerror(errno);
+        return false;
+    }
+    unsigned char header[TrafficCapture::kFileHeaderSize];
+    if (std::fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        std::memcmp(header, TrafficCapture::kMagic, sizeof(TrafficCapture::kMagic)) != 0) {
+        error = "not a capture file";
+        return false;
+    }
+    start_unix_us_ = get_le(header + 8, 8);
+    return true;
+}
+
+bool CaptureReader::next(Record& out) {
+    unsigned char header[TrafficCapture::kRecordHeaderSize];
+    if (!file_ || std::fread(header, 1, sizeof(header), file_) != sizeof(header)) return false;
+    out.t_us = get_le(header, 8);
+    out.session = static_cast<uint32_t>(get_le(header + 8, 4));
+    out.kind = static_cast<TrafficCapture::Kind>(header[12]);
+    const auto len = static_cast<std::size_t>(get_le(header + 13, 4));
+    // 손상된 길이로 거대한 버퍼를 잡지 않도록 서버가 주고받는 프레임 상한으로 제한
+    const std::size_t max_len =
+        out.kind == TrafficCapture::Kind::Inbound ? kMaxRequestFrameSize : kMaxResponseFrameSize;
+    if (len > max_len) return false;
+    out.payload.resize(len);
+    return len == 0 || std::fread(&out.payload[0], 1, len, file_) == len;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 트래픽 캡처 (선택 기능, CAPTURE_DIR 설정 시 활성화)
+// 세션별 수신/송신 Envelope를 타임스탬프와 함께 하나의 바이너리 로그에 기록한다.
+// - 기록은 메모리 버퍼에 덧붙이기만 하고, 파일 쓰기는 백그라운드 스레드가 모아서 한다
+// - 버퍼가 한도를 넘으면 기록을 버리고(dropped) 세션 처리에는 영향을 주지 않는다
+// - HANDSHAKE의 jwt/resume_token과 HANDSHAKE_RESULT의 resume_token은 기록 전에 지운다 (재생 시 도구가 토큰을 채움)
+//
+// 파일 형식 (리틀 엔디언):
+//   헤더 16바이트: magic "IPCAP\x01\0\0" + 캡처 시작 unix 시각(us, u64)
+//   레코드: t_us(u64, 시작 후 경과) + session(u32) + kind(u8) + len(u32) + payload(len)
+class TrafficCapture {
+public:
+    enum class Kind : uint8_t { Open = 0, Inbound = 1, Outbound = 2, Close = 3 };
+
+    static constexpr char kMagic[8] = {'I', 'P', 'C', 'A', 'P', 1, 0, 0};
+    static constexpr std::size_t kFileHeaderSize = 16;
+    static constexpr std::size_t kRecordHeaderSize = 17;
+
+    struct Options {
+        std::string dir;
+        uint32_t sample_percent = 100;              // 캡처할 세션 비율
+        uint64_t max_bytes = 1024ull * 1024 * 1024; // 파일 크기 한도, 넘으면 캡처 중단
+    };
+
+    struct Stats {
+        uint64_t sessions{0};
+        uint64_t records{0};
+        uint64_t bytes{0};
+        uint64_t dropped{0};
+    };
+
+    // 파일 생성 실패 시 nullptr (에러 로그)
+    static std::unique_ptr<TrafficCapture> open(const Options& options);
+    ~TrafficCapture();
+
+    TrafficCapture(const TrafficCapture&) = delete;
+    TrafficCapture& operator=(const TrafficCapture&) = delete;
+
+    // 세션 시작 시 호출. 샘플링에 포함되면 0이 아닌 캡처 id
+    uint32_t begin_session();
+    void record(uint32_t session, Kind kind, const void* data, std::size_t len);
+
+    const std::string& path() const { return path_; }
+    Stats stats() const;
+
+private:
+    TrafficCapture(std::FILE* file, std::string path, const Options& options);
+    void flush_loop();
+
+    static constexpr std::size_t kFlushThreshold = 1 << 20;   // 1MB 모이면 즉시 flush
+    static constexpr std::size_t kMaxPending = 64 << 20;      // 이 이상 쌓이면 버림
+
+    std::FILE* file_;
+    std::string path_;
+    Options options_;
+    std::chrono::steady_clock::time_point start_;
+
+    std::atomic<uint32_t> next_session_{1};
+    std::atomic<uint64_t> sessions_{0};
+    std::atomic<uint64_t> records_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<bool> full_{false};
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string pending_;
+    bool stopping_{false};
+    std::thread writer_;
+};
+
+// 캡처 파일 순차 읽기 (재생/분석 도구용)
+class CaptureReader {
+public:
+    struct Record {
+        uint64_t t_us{0};
+        uint32_t session{0};
+        TrafficCapture::Kind kind{TrafficCapture::Kind::Open};
+        std::string payload;
+    };
+
+    ~CaptureReader();
+    bool open(const std::string& path, std::string& error);
+    // 다음 레코드. 파일 끝이거나 잘린 레코드, 길이가 프레임 상한을 넘는 레코드면 false
+    bool next(Record& out);
+    uint64_t start_unix_us() const { return start_unix_us_; }
+
+private:
+    std::FILE* file_{nullptr};
+    uint64_t start_unix_us_{0};
+};
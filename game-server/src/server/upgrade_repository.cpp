@@ -1,4 +1,5 @@
 #include "upgrade_repository.h"
+#include "rng_service.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <algorithm>
@@ -25,7 +26,7 @@ UpgradeRepository::UpgradeAttemptResult UpgradeRepository::try_upgrade_with_prob
     const UpgradeRules& rules) {
     UpgradeAttemptResult res;
     try {
-        auto conn = pool_.acquire();
+        auto conn = pool_.acquire_write(user_id);
         pqxx::work tx(*conn);
 
         // 슬롯 잠금 + 현재 상태 조회
@@ -85,7 +86,7 @@ UpgradeRepository::UpgradeAttemptResult UpgradeRepository::try_upgrade_with_prob
         double current_bonus_rate = static_cast<double>(clamped_pity_bp) / 10000.0;
         double attempt_final_rate = clamp(base_rate + current_bonus_rate, 0.0, 1.0);
 
-        static thread_local std::mt19937 rng(std::random_device{}());
+        auto rng = RngService::stream(user_id, RngDomain::Upgrade);
         std::uniform_real_distribution<double> dist(0.0, 1.0);
         bool success = dist(rng) < attempt_final_rate;
 
@@ -7,7 +7,8 @@ infinitepickaxe::UpgradeResult UpgradeService::handle_upgrade(const std::string&
     res.set_slot_index(slot_index);
 
     // 메타데이터에서 비용/스탯 확보
-    const auto* pl = meta_.pickaxe_level(target_level);
+    auto meta = meta_.current();
+    const auto* pl = meta->pickaxe_level(target_level);
     if (!pl) {
         res.set_success(false);
         res.set_error_code("3003"); // INVALID_LEVEL
@@ -19,7 +20,7 @@ infinitepickaxe::UpgradeResult UpgradeService::handle_upgrade(const std::string&
     uint64_t dps = pl->dps;
     uint64_t cost = pl->cost;
 
-    const auto& rules = meta_.upgrade_rules();
+    const auto& rules = meta->upgrade_rules();
     auto repo_result = repo_.try_upgrade_with_probability(
         user_id, slot_index, target_level, pl->tier,
         attack_power, attack_speed_x100, dps, cost, rules);
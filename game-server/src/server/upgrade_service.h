@@ -1,14 +1,14 @@
 #pragma once
 #include "game.pb.h"
-#include "metadata/metadata_loader.h"
+#include "metadata/metadata_store.h"
 #include "upgrade_repository.h"
 
 class UpgradeService {
 public:
-    UpgradeService(UpgradeRepository& repo, const MetadataLoader& meta)
+    UpgradeService(UpgradeRepository& repo, const MetadataStore& meta)
         : repo_(repo), meta_(meta) {}
     infinitepickaxe::UpgradeResult handle_upgrade(const std::string& user_id, uint32_t slot_index, uint32_t target_level) const;
 private:
     UpgradeRepository& repo_;
-    const MetadataLoader& meta_;
+    const MetadataStore& meta_;
 };
@@ -0,0 +1,42 @@
+#pragma once
+// 도구(load-bot, traffic-replay) 공용 프로토콜 헬퍼
+#include "game.pb.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace bot_protocol {
+
+// 요청 타입 → 기대 응답 타입 (응답이 없는 타입은 UNKNOWN)
+inline infinitepickaxe::MessageType response_type_for(infinitepickaxe::MessageType request) {
+    namespace pb = infinitepickaxe;
+    switch (request) {
+    case pb::HANDSHAKE: return pb::HANDSHAKE_RESULT;
+    case pb::HEARTBEAT: return pb::HEARTBEAT_ACK;
+    case pb::CHANGE_MINERAL_REQUEST: return pb::CHANGE_MINERAL_RESPONSE;
+    case pb::UPGRADE_REQUEST: return pb::UPGRADE_RESULT;
+    case pb::GEM_GACHA_REQUEST: return pb::GEM_GACHA_RESULT;
+    case pb::DAILY_MISSIONS_REQUEST: return pb::DAILY_MISSIONS_RESPONSE;
+    case pb::MISSION_COMPLETE: return pb::MISSION_COMPLETE_RESULT;
+    case pb::ALL_SLOTS_REQUEST: return pb::ALL_SLOTS_RESPONSE;
+    case pb::GEM_LIST_REQUEST: return pb::GEM_LIST_RESPONSE;
+    case pb::OFFLINE_REWARD_REQUEST: return pb::OFFLINE_REWARD_RESULT;
+    default: return pb::UNKNOWN;
+    }
+}
+
+// 길이 접두(4바이트 LE) 프레임. async_write 완료까지 핸들러가 소유한다
+inline std::shared_ptr<std::string> encode_frame(const infinitepickaxe::Envelope& env) {
+    auto frame = std::make_shared<std::string>(4, '\0');
+    env.AppendToString(frame.get());
+    const auto len = static_cast<uint32_t>(frame->size() - 4);
+    for (int i = 0; i < 4; ++i) (*frame)[i] = static_cast<char>((len >> (8 * i)) & 0xFF);
+    return frame;
+}
+
+inline uint32_t decode_length(const uint8_t* buf) {
+    return static_cast<uint32_t>(buf[0]) | (static_cast<uint32_t>(buf[1]) << 8) |
+           (static_cast<uint32_t>(buf[2]) << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+} // namespace bot_protocol
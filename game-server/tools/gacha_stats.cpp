@@ -0,0 +1,146 @@
+// 가챠 분포 검증 도구
+// MetadataLoader가 구성한 alias 테이블로 대량 추첨한 뒤
+// gem_gacha.json의 grade_rates와 카이제곱 검정으로 비교한다.
+// 등급 내 gem_id 분포(균등)도 함께 검정한다.
+//
+// 사용법: gacha-stats <metadata_dir> [samples] [seed]
+// 종료 코드: 0 = 통과, 1 = 분포 불일치, 2 = 입력 오류
+#include "metadata/metadata_loader.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 유의수준 0.001 카이제곱 임계값 (Wilson-Hilferty 근사)
+double chi2_critical(std::size_t df) {
+    if (df == 0) return 0.0;
+    const double z = 3.0902; // 단측 0.999 분위수
+    const double k = static_cast<double>(df);
+    const double t = 1.0 - 2.0 / (9.0 * k) + z * std::sqrt(2.0 / (9.0 * k));
+    return k * t * t * t;
+}
+
+bool report(const char* label, const std::vector<std::pair<std::string, double>>& expected_share,
+            const std::vector<uint64_t>& observed, uint64_t samples) {
+    double chi2 = 0.0;
+    std::printf("%s\n", label);
+    std::printf("  %-12s %12s %12s %10s\n", "bucket", "expected", "observed", "diff(pp)");
+    for (std::size_t i = 0; i < observed.size(); ++i) {
+        double exp_count = expected_share[i].second * static_cast<double>(samples);
+        double diff = static_cast<double>(observed[i]) - exp_count;
+        if (exp_count > 0) chi2 += diff * diff / exp_count;
+        std::printf("  %-12s %11.4f%% %11.4f%% %+10.4f\n", expected_share[i].first.c_str(),
+                    expected_share[i].second * 100.0,
+                    static_cast<double>(observed[i]) * 100.0 / static_cast<double>(samples),
+                    (static_cast<double>(observed[i]) / static_cast<double>(samples) - expected_share[i].second) * 100.0);
+    }
+    std::size_t df = observed.size() > 0 ? observed.size() - 1 : 0;
+    double crit = chi2_critical(df);
+    bool ok = chi2 <= crit;
+    std::printf("  chi2=%.3f df=%zu critical(0.001)=%.3f -> %s\n\n", chi2, df, crit, ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <metadata_dir> [samples] [seed]\n", argv[0]);
+        return 2;
+    }
+    const std::string dir = argv[1];
+    const uint64_t samples = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000ULL;
+    const uint64_t seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : std::random_device{}();
+
+    MetadataLoader meta;
+    if (!meta.load(dir)) {
+        std::fprintf(stderr, "failed to load metadata bundle from %s\n", dir.c_str());
+        return 2;
+    }
+    const auto& sampler = meta.gem_gacha_sampler();
+    if (sampler.empty()) {
+        std::fprintf(stderr, "gacha sampler is empty\n");
+        return 2;
+    }
+
+    // 기대값은 번들이 아닌 원본 gem_gacha.json에서 직접 읽는다 (번들 빌드 누락까지 검출)
+    std::ifstream f(dir + "/gem_gacha.json");
+    if (!f.good()) {
+        std::fprintf(stderr, "missing %s/gem_gacha.json\n", dir.c_str());
+        return 2;
+    }
+    nlohmann::json gacha;
+    f >> gacha;
+    std::map<uint32_t, uint64_t> source_rates;
+    uint64_t source_total = 0;
+    for (const auto& e : gacha["grade_rates"]) {
+        uint32_t grade = e.value("grade_id", 0u);
+        uint64_t rate = e.value("rate_percent", 0u);
+        source_rates[grade] += rate;
+        source_total += rate;
+    }
+
+    bool ok = true;
+    std::vector<std::pair<std::string, double>> grade_expected;
+    for (std::size_t slot = 0; slot < sampler.grade_ids.size(); ++slot) {
+        uint32_t grade = sampler.grade_ids[slot];
+        auto it = source_rates.find(grade);
+        double share = (it == source_rates.end() || source_total == 0)
+                           ? 0.0
+                           : static_cast<double>(it->second) / static_cast<double>(source_total);
+        if (it == source_rates.end()) {
+            std::printf("grade %u is in the bundle but not in gem_gacha.json\n", grade);
+            ok = false;
+        }
+        grade_expected.emplace_back("grade " + std::to_string(grade), share);
+    }
+    for (const auto& [grade, rate] : source_rates) {
+        if (rate == 0) continue;
+        bool found = false;
+        for (uint32_t g : sampler.grade_ids) found = found || g == grade;
+        if (!found) {
+            std::printf("grade %u has rate %llu in gem_gacha.json but is not drawable\n", grade,
+                        static_cast<unsigned long long>(rate));
+            ok = false;
+        }
+    }
+
+    // 추첨
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> grade_counts(sampler.grade_ids.size(), 0);
+    std::vector<std::map<uint32_t, uint64_t>> gem_counts(sampler.grade_ids.size());
+    for (uint64_t i = 0; i < samples; ++i) {
+        uint32_t slot = sampler.sample_slot(rng);
+        ++grade_counts[slot];
+        const auto& ids = sampler.gem_ids[slot];
+        std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+        ++gem_counts[slot][ids[pick(rng)]];
+    }
+
+    std::printf("samples=%llu seed=%llu\n\n", static_cast<unsigned long long>(samples),
+                static_cast<unsigned long long>(seed));
+    ok = report("[grade distribution vs gem_gacha.json]", grade_expected, grade_counts, samples) && ok;
+
+    for (std::size_t slot = 0; slot < sampler.grade_ids.size(); ++slot) {
+        const auto& ids = sampler.gem_ids[slot];
+        if (ids.size() < 2 || grade_counts[slot] == 0) continue;
+        std::vector<std::pair<std::string, double>> expected;
+        std::vector<uint64_t> observed;
+        for (uint32_t id : ids) {
+            expected.emplace_back("gem " + std::to_string(id), 1.0 / static_cast<double>(ids.size()));
+            observed.push_back(gem_counts[slot][id]);
+        }
+        std::string label = "[gem distribution within grade " + std::to_string(sampler.grade_ids[slot]) + "]";
+        ok = report(label.c_str(), expected, observed, grade_counts[slot]) && ok;
+    }
+
+    std::printf("%s\n", ok ? "RESULT: PASS" : "RESULT: FAIL");
+    return ok ? 0 : 1;
+}
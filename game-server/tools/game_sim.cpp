@@ -0,0 +1,397 @@
+// 시간 압축 시뮬레이터 (소켓 없이 서비스/리포지토리를 직접 호출)
+// 가상 유저 N명을 가상 시계 위에서 며칠치 진행시켜 밸런스(성장 속도)와 처리량을 함께 본다.
+// 틱 로직은 Session::update_mining_tick과 같다: advance_slot_attacks → 처치 시 MiningService::handle_complete
+// + 미션 진행, 리스폰 대기, 60초마다 플레이 시간 미션, KST 자정마다 일일 미션 갱신.
+// 업그레이드 정책: 처치 --upgrade-every회마다 DPS가 가장 낮은 슬롯을 다음 레벨로 시도.
+// 광물 선택: 총 DPS가 recommended_min_dps 이상인 가장 높은 광물.
+//
+// 사용법:
+//   game-sim [--players=1000] [--days=3] [--threads=4] [--tick-ms=40] [--epoch-sec=60]
+//            [--start=<unix sec, 기본 현재>] [--upgrade-every=5] [--report-hours=6] [--user-offset=0]
+// DB/Redis/메타데이터 접속 정보는 game-server와 같은 환경 변수(DB_HOST, REDIS_HOST, METADATA_PATH 등)를 쓴다.
+// 결과의 sim-player-hours/CPU-sec는 이 프로세스의 CPU만 센다 (Postgres/Redis CPU는 별도).
+#include "config.h"
+#include "metadata/metadata_store.h"
+#include "server/ad_repository.h"
+#include "server/ad_service.h"
+#include "server/connection_pool.h"
+#include "server/game_clock.h"
+#include "server/game_repository.h"
+#include "server/mining_repository.h"
+#include "server/mining_service.h"
+#include "server/mining_tick.h"
+#include "server/mission_repository.h"
+#include "server/mission_service.h"
+#include "server/offline_repository.h"
+#include "server/redis_client.h"
+#include "server/rng_service.h"
+#include "server/slot_repository.h"
+#include "server/slot_service.h"
+#include "server/gem_repository.h"
+#include "server/time_utils.h"
+#include "server/upgrade_repository.h"
+#include "server/upgrade_service.h"
+#include <spdlog/spdlog.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    uint32_t players = 1000;
+    double days = 3.0;
+    uint32_t threads = 4;
+    uint32_t tick_ms = 40;
+    uint32_t epoch_sec = 60; // 가상 시계는 epoch 단위로 진행 (epoch 안의 틱은 같은 시각을 본다)
+    uint64_t start_unix = 0;
+    uint32_t upgrade_every = 5;
+    double report_hours = 6.0;
+    uint32_t user_offset = 0;
+};
+
+struct Services {
+    GameRepository& game;
+    MiningService& mining;
+    MissionService& mission;
+    SlotService& slot;
+    UpgradeService& upgrade;
+    const MetadataStore& meta;
+};
+
+struct Totals {
+    std::atomic<uint64_t> kills{0};
+    std::atomic<uint64_t> gold{0};
+    std::atomic<uint64_t> upgrade_tries{0};
+    std::atomic<uint64_t> upgrade_successes{0};
+    std::atomic<uint64_t> daily_resets{0};
+    std::atomic<uint64_t> service_calls{0};
+};
+
+std::string user_uuid(uint32_t index) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "00000000-0000-4000-9000-%012x", index);
+    return buf;
+}
+
+class SimPlayer {
+public:
+    SimPlayer(std::string user_id, uint32_t index, uint32_t upgrade_every)
+        : user_id_(std::move(user_id)), rng_(RngService::stream(user_id_, RngDomain::Crit)), seed_(index),
+          upgrade_every_(upgrade_every) {}
+
+    uint64_t total_dps() const { return total_dps_; }
+    uint32_t mineral() const { return state_.current_mineral_id; }
+
+    bool init(Services& s) {
+        if (!s.game.ensure_user_initialized(user_id_)) return false;
+        refresh_slots(s);
+        next_daily_reset_ms_ = kst_next_midnight_ms();
+        state_.current_mineral_id = best_mineral(s);
+        start_mineral(s);
+        return true;
+    }
+
+    // Session::update_mining_tick과 같은 순서로 delta_ms만큼 진행
+    void tick(Services& s, Totals& totals, float delta_ms) {
+        if (game_clock::now_ms() >= next_daily_reset_ms_) {
+            s.mission.get_missions(user_id_);
+            next_daily_reset_ms_ = kst_next_midnight_ms();
+            totals.daily_resets.fetch_add(1, std::memory_order_relaxed);
+            totals.service_calls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        play_time_accum_ms_ += delta_ms;
+        if (play_time_accum_ms_ >= 60'000.0f) {
+            s.mission.handle_play_time_seconds(user_id_, 60);
+            play_time_accum_ms_ -= 60'000.0f;
+            totals.service_calls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!state_.is_mining) {
+            state_.respawn_timer_ms -= delta_ms;
+            if (state_.respawn_timer_ms <= 0.0f) start_mineral(s);
+            return;
+        }
+
+        update_.Clear();
+        const uint64_t damage = advance_slot_attacks(state_.slots, delta_ms, rng_, update_);
+        state_.current_hp = state_.current_hp > damage ? state_.current_hp - damage : 0;
+        if (state_.current_hp == 0) complete_mineral(s, totals);
+    }
+
+private:
+    void refresh_slots(Services& s) {
+        auto slots = s.slot.handle_all_slots(user_id_);
+        state_.slots.clear();
+        total_dps_ = 0;
+        levels_.clear();
+        for (const auto& info : slots.slots()) {
+            if (!info.is_unlocked()) continue;
+            SlotMiningState slot{};
+            slot.slot_index = info.slot_index();
+            slot.attack_power = info.attack_power();
+            slot.attack_speed = std::max(static_cast<float>(info.attack_speed_x100()) / 100.0f, 0.01f);
+            slot.critical_hit_percent = info.critical_hit_percent();
+            slot.critical_damage = info.critical_damage();
+            slot.next_attack_timer_ms = static_cast<float>((seed_ + info.slot_index()) % 1000) / 1000.0f *
+                                        (1000.0f / slot.attack_speed);
+            state_.slots.push_back(slot);
+            levels_.push_back({info.slot_index(), info.level(), info.dps()});
+            total_dps_ += info.dps();
+        }
+    }
+
+    uint32_t best_mineral(Services& s) const {
+        auto meta = s.meta.current();
+        uint32_t best = 1;
+        for (uint32_t id = 1; meta->mineral(id) != nullptr; ++id) {
+            if (meta->mineral(id)->recommended_min_dps <= total_dps_) best = id;
+        }
+        return best;
+    }
+
+    void start_mineral(Services& s) {
+        auto meta = s.meta.current();
+        const auto* mineral = meta->mineral(state_.current_mineral_id);
+        if (!mineral) {
+            state_.is_mining = false;
+            state_.respawn_timer_ms = 60'000.0f;
+            return;
+        }
+        state_.current_hp = mineral->hp;
+        state_.max_hp = mineral->hp;
+        state_.is_mining = true;
+        state_.respawn_timer_ms = 0.0f;
+    }
+
+    void complete_mineral(Services& s, Totals& totals) {
+        state_.is_mining = false;
+        const uint32_t mineral_id = state_.current_mineral_id;
+        auto result = s.mining.handle_complete(user_id_, mineral_id);
+        s.mission.handle_mining_complete(user_id_, mineral_id);
+        s.mission.handle_gold_earned(user_id_, result.gold_earned());
+        totals.kills.fetch_add(1, std::memory_order_relaxed);
+        totals.gold.fetch_add(result.gold_earned(), std::memory_order_relaxed);
+        totals.service_calls.fetch_add(3, std::memory_order_relaxed);
+
+        auto meta = s.meta.current();
+        const auto* mineral = meta->mineral(mineral_id);
+        state_.respawn_timer_ms = mineral ? static_cast<float>(mineral->respawn_time) * 1000.0f : 0.0f;
+
+        if (++kills_ % upgrade_every_ == 0) try_upgrade(s, totals);
+    }
+
+    void try_upgrade(Services& s, Totals& totals) {
+        if (levels_.empty()) return;
+        const auto weakest = std::min_element(levels_.begin(), levels_.end(),
+                                              [](const SlotLevel& a, const SlotLevel& b) { return a.dps < b.dps; });
+        auto result = s.upgrade.handle_upgrade(user_id_, weakest->slot_index, weakest->level + 1);
+        s.mission.handle_upgrade_try(user_id_, result.success());
+        totals.upgrade_tries.fetch_add(1, std::memory_order_relaxed);
+        totals.service_calls.fetch_add(2, std::memory_order_relaxed);
+        if (!result.success()) return;
+        totals.upgrade_successes.fetch_add(1, std::memory_order_relaxed);
+        refresh_slots(s);
+        totals.service_calls.fetch_add(1, std::memory_order_relaxed);
+        // 리스폰 대기 중이므로 다음 start_mineral부터 새 광물
+        state_.current_mineral_id = best_mineral(s);
+    }
+
+    struct SlotLevel {
+        uint32_t slot_index;
+        uint32_t level;
+        uint64_t dps;
+    };
+
+    std::string user_id_;
+    RngStream rng_;
+    uint32_t seed_;
+    uint32_t upgrade_every_;
+    MiningState state_;
+    infinitepickaxe::MiningUpdate update_;
+    std::vector<SlotLevel> levels_;
+    uint64_t total_dps_{0};
+    uint64_t kills_{0};
+    uint64_t next_daily_reset_ms_{0};
+    float play_time_accum_ms_{0.0f};
+};
+
+double cpu_seconds() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+           static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "invalid argument: %s\n", arg.c_str());
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        auto as_u32 = [&value] { return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)); };
+        if (key == "players") opt.players = as_u32();
+        else if (key == "days") opt.days = std::strtod(value.c_str(), nullptr);
+        else if (key == "threads") opt.threads = std::max(1u, as_u32());
+        else if (key == "tick-ms") opt.tick_ms = std::max(1u, as_u32());
+        else if (key == "epoch-sec") opt.epoch_sec = std::max(1u, as_u32());
+        else if (key == "start") opt.start_unix = std::strtoull(value.c_str(), nullptr, 10);
+        else if (key == "upgrade-every") opt.upgrade_every = std::max(1u, as_u32());
+        else if (key == "report-hours") opt.report_hours = std::strtod(value.c_str(), nullptr);
+        else if (key == "user-offset") opt.user_offset = as_u32();
+        else {
+            std::fprintf(stderr, "unknown option: --%s\n", key.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_progress(double sim_hours, const std::vector<std::unique_ptr<SimPlayer>>& players, const Totals& totals,
+                    double cpu_sec, double wall_sec) {
+    uint64_t dps_sum = 0;
+    uint32_t max_mineral = 0;
+    for (const auto& p : players) {
+        dps_sum += p->total_dps();
+        max_mineral = std::max(max_mineral, p->mineral());
+    }
+    std::printf("[sim %6.1fh | wall %6.1fs | cpu %6.1fs] kills=%llu gold=%llu upgrades=%llu/%llu avg_dps=%llu "
+                "max_mineral=%u\n",
+                sim_hours, wall_sec, cpu_sec, static_cast<unsigned long long>(totals.kills.load()),
+                static_cast<unsigned long long>(totals.gold.load()),
+                static_cast<unsigned long long>(totals.upgrade_successes.load()),
+                static_cast<unsigned long long>(totals.upgrade_tries.load()),
+                static_cast<unsigned long long>(players.empty() ? 0 : dps_sum / players.size()), max_mineral);
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+    spdlog::set_level(spdlog::level::warn);
+
+    const auto start_time = opt.start_unix > 0
+                                ? std::chrono::system_clock::time_point(std::chrono::seconds(opt.start_unix))
+                                : std::chrono::system_clock::now();
+    game_clock::set_virtual(start_time);
+
+    try {
+        auto cfg = load_config();
+        std::ostringstream conn_str;
+        conn_str << "host=" << cfg.db_host << " port=" << cfg.db_port << " user=" << cfg.db_user
+                 << " password=" << cfg.db_password << " dbname=" << cfg.db_name;
+        ConnectionPool db_pool(conn_str.str(), opt.threads, opt.threads * 2);
+        MetadataStore metadata(env_or("METADATA_PATH", "./metadata"));
+        if (!metadata.reload()) {
+            std::fprintf(stderr, "failed to load metadata from %s\n", metadata.base_path().c_str());
+            return 1;
+        }
+        RedisClient redis_client(cfg.redis_host, cfg.redis_port);
+        GameRepository game_repo(db_pool, metadata);
+        MiningRepository mining_repo(db_pool);
+        UpgradeRepository upgrade_repo(db_pool);
+        AdRepository ad_repo(db_pool);
+        MissionRepository mission_repo(db_pool);
+        SlotRepository slot_repo(db_pool);
+        OfflineRepository offline_repo(db_pool);
+        GemRepository gem_repo(db_pool);
+        MiningService mining_service(mining_repo, slot_repo, game_repo, metadata);
+        UpgradeService upgrade_service(upgrade_repo, metadata);
+        AdService ad_service(ad_repo, game_repo, metadata);
+        MissionService mission_service(mission_repo, game_repo, offline_repo, ad_service, metadata, redis_client);
+        SlotService slot_service(slot_repo, game_repo, gem_repo, metadata);
+        Services services{game_repo, mining_service, mission_service, slot_service, upgrade_service, metadata};
+
+        std::vector<std::unique_ptr<SimPlayer>> players;
+        players.reserve(opt.players);
+        for (uint32_t i = 0; i < opt.players; ++i) {
+            players.push_back(
+                std::make_unique<SimPlayer>(user_uuid(opt.user_offset + i), opt.user_offset + i, opt.upgrade_every));
+        }
+
+        Totals totals;
+        const double cpu_start = cpu_seconds();
+        const auto wall_start = Clock::now();
+        auto run_parallel = [&](const auto& fn) {
+            std::vector<std::thread> workers;
+            for (uint32_t t = 0; t < opt.threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (std::size_t i = t; i < players.size(); i += opt.threads) fn(*players[i]);
+                });
+            }
+            for (auto& w : workers) w.join();
+        };
+
+        std::atomic<uint32_t> init_failed{0};
+        run_parallel([&](SimPlayer& p) {
+            if (!p.init(services)) init_failed.fetch_add(1, std::memory_order_relaxed);
+        });
+        if (init_failed.load() > 0) {
+            std::fprintf(stderr, "%u players failed to initialize (check DB connectivity)\n", init_failed.load());
+            return 1;
+        }
+        std::printf("game-sim: %u players, %.2f days, tick %ums, epoch %us, %u threads\n", opt.players, opt.days,
+                    opt.tick_ms, opt.epoch_sec, opt.threads);
+
+        const uint64_t total_ms = static_cast<uint64_t>(opt.days * 24.0 * 3600.0 * 1000.0);
+        const uint64_t epoch_ms = static_cast<uint64_t>(opt.epoch_sec) * 1000;
+        const uint32_t ticks_per_epoch = std::max<uint32_t>(1, static_cast<uint32_t>(epoch_ms / opt.tick_ms));
+        const float delta_ms = static_cast<float>(opt.tick_ms);
+        const uint64_t report_ms = static_cast<uint64_t>(std::max(opt.report_hours, 0.01) * 3600.0 * 1000.0);
+        uint64_t next_report = report_ms;
+
+        uint64_t elapsed_ms = 0;
+        while (elapsed_ms < total_ms) {
+            run_parallel([&](SimPlayer& p) {
+                for (uint32_t k = 0; k < ticks_per_epoch; ++k) p.tick(services, totals, delta_ms);
+            });
+            const uint64_t step = static_cast<uint64_t>(ticks_per_epoch) * opt.tick_ms;
+            game_clock::advance(std::chrono::milliseconds(step));
+            elapsed_ms += step;
+            if (elapsed_ms >= next_report) {
+                print_progress(elapsed_ms / 3.6e6, players, totals, cpu_seconds() - cpu_start,
+                               std::chrono::duration<double>(Clock::now() - wall_start).count());
+                next_report += report_ms;
+            }
+        }
+
+        const double cpu = cpu_seconds() - cpu_start;
+        const double wall = std::chrono::duration<double>(Clock::now() - wall_start).count();
+        const double player_hours = static_cast<double>(opt.players) * (elapsed_ms / 3.6e6);
+        std::printf("\n== game-sim summary ==\n");
+        print_progress(elapsed_ms / 3.6e6, players, totals, cpu, wall);
+        std::printf("sim_player_hours=%.1f cpu_sec=%.2f wall_sec=%.2f\n", player_hours, cpu, wall);
+        std::printf("throughput: %.1f sim-player-hours/CPU-sec, %.1f sim-player-hours/wall-sec, "
+                    "service_calls=%llu daily_resets=%llu\n",
+                    player_hours / std::max(cpu, 1e-9), player_hours / std::max(wall, 1e-9),
+                    static_cast<unsigned long long>(totals.service_calls.load()),
+                    static_cast<unsigned long long>(totals.daily_resets.load()));
+        auto s = db_pool.stats();
+        std::printf("pool: acquires=%llu timeouts=%llu wait_sum_ms=%.1f\n",
+                    static_cast<unsigned long long>(s.acquires), static_cast<unsigned long long>(s.acquire_timeouts),
+                    s.wait_sum_us / 1000.0);
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "game-sim failed: %s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,529 @@
+// 부하 생성 봇 (헤드리스 클라이언트 군집)
+// 길이 접두(4바이트 LE) + protobuf Envelope 프로토콜로 game-server에 다수 세션을 붙이고,
+// 세션마다 한 번에 하나의 요청만 보내는 closed-loop 시나리오를 가중치 믹스대로 돌린다.
+// 결과: 초당 처리량, MessageType별 p50/p99/p999 지연, MINING_UPDATE 도착 간격 지터.
+//
+// 사용법:
+//   load-bot [--host=127.0.0.1] [--port=10001] [--sessions=1000] [--connect-rate=500]
+//            [--duration=60] [--threads=4] [--think-ms=500] [--timeout-ms=5000]
+//            [--mix=heartbeat=30,change_mineral=10,upgrade=15,gacha=10,missions=15,all_slots=10,gem_list=10]
+//            [--tokens=<file>] [--token-prefix=loadbot-] [--report-sec=5] [--minerals=5]
+// 토큰: --tokens 파일이 있으면 한 줄에 하나씩 순환 사용, 없으면 token-prefix + 번호
+#include "bot_protocol.h"
+#include "server/hdr_histogram.h"
+#include "game.pb.h"
+#include <boost/asio.hpp>
+#include <sys/resource.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+namespace pb = infinitepickaxe;
+
+constexpr auto kMiningTickInterval = std::chrono::milliseconds(40);
+
+struct Options {
+    std::string host = "127.0.0.1";
+    unsigned short port = 10001;
+    uint32_t sessions = 1000;
+    uint32_t connect_rate = 500; // 초당 새 연결 수
+    uint32_t duration_sec = 60;
+    uint32_t threads = 4;
+    uint32_t think_ms = 500;     // 요청 간 평균 대기 (지수 분포)
+    uint32_t timeout_ms = 5000;
+    uint32_t report_sec = 5;
+    uint32_t minerals = 5;
+    std::string mix = "heartbeat=30,change_mineral=10,upgrade=15,gacha=10,missions=15,all_slots=10,gem_list=10";
+    std::string token_file;
+    std::string token_prefix = "loadbot-";
+};
+
+enum class Action { Heartbeat, ChangeMineral, Upgrade, Gacha, Missions, MissionComplete, AllSlots, GemList, OfflineReward };
+
+struct ActionInfo {
+    const char* name;
+    Action action;
+};
+
+constexpr std::array<ActionInfo, 9> kActions{{
+    {"heartbeat", Action::Heartbeat},
+    {"change_mineral", Action::ChangeMineral},
+    {"upgrade", Action::Upgrade},
+    {"gacha", Action::Gacha},
+    {"missions", Action::Missions},
+    {"mission_complete", Action::MissionComplete},
+    {"all_slots", Action::AllSlots},
+    {"gem_list", Action::GemList},
+    {"offline_reward", Action::OfflineReward},
+}};
+
+using bot_protocol::response_type_for;
+
+struct Stats {
+    std::vector<std::unique_ptr<HdrHistogram>> latency; // MessageType별 (요청 타입 기준)
+    HdrHistogram mining_jitter;                          // |도착 간격 - 40ms| (us)
+    std::atomic<uint64_t> connected{0};
+    std::atomic<uint64_t> active{0};
+    std::atomic<uint64_t> connect_failures{0};
+    std::atomic<uint64_t> handshake_failures{0};
+    std::atomic<uint64_t> disconnects{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> responses{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> timeouts{0};
+    std::atomic<uint64_t> mining_updates{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+
+    Stats() {
+        latency.reserve(128);
+        for (int i = 0; i < 128; ++i) latency.push_back(std::make_unique<HdrHistogram>());
+    }
+};
+
+struct Mix {
+    std::vector<Action> actions;
+    std::vector<uint32_t> weights;
+};
+
+Mix parse_mix(const std::string& spec) {
+    Mix mix;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const auto eq = item.find('=');
+        if (eq == std::string::npos) continue;
+        const std::string name = item.substr(0, eq);
+        const uint32_t weight = static_cast<uint32_t>(std::strtoul(item.c_str() + eq + 1, nullptr, 10));
+        bool found = false;
+        for (const auto& info : kActions) {
+            if (name == info.name) {
+                if (weight > 0) {
+                    mix.actions.push_back(info.action);
+                    mix.weights.push_back(weight);
+                }
+                found = true;
+                break;
+            }
+        }
+        if (!found) std::fprintf(stderr, "unknown action in mix: %s\n", name.c_str());
+    }
+    return mix;
+}
+
+class Bot : public std::enable_shared_from_this<Bot> {
+public:
+    Bot(asio::io_context& io, const Options& opt, const Mix& mix, Stats& stats,
+        tcp::endpoint endpoint, std::string token, uint32_t index)
+        : socket_(io), think_timer_(io), timeout_timer_(io), opt_(opt), mix_(mix), stats_(stats),
+          endpoint_(std::move(endpoint)), token_(std::move(token)), index_(index),
+          rng_(0x9E3779B9u ^ index), pick_(mix.weights.begin(), mix.weights.end()),
+          think_(opt.think_ms > 0 ? 1.0 / opt.think_ms : 1.0) {}
+
+    void start() {
+        auto self = shared_from_this();
+        socket_.async_connect(endpoint_, [this, self](boost::system::error_code ec) {
+            if (ec) {
+                stats_.connect_failures.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            connected_ = true;
+            stats_.connected.fetch_add(1, std::memory_order_relaxed);
+            stats_.active.fetch_add(1, std::memory_order_relaxed);
+            socket_.set_option(tcp::no_delay(true));
+            read_length();
+
+            pb::Envelope env;
+            env.set_type(pb::HANDSHAKE);
+            auto* hs = env.mutable_handshake();
+            hs->set_jwt(token_);
+            hs->set_client_version("load-bot");
+            hs->set_device_id("loadbot-device-" + std::to_string(index_));
+            send_request(env);
+        });
+    }
+
+    void stop() {
+        auto self = shared_from_this();
+        asio::post(socket_.get_executor(), [this, self] { close(); });
+    }
+
+private:
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+        boost::system::error_code ignored;
+        think_timer_.cancel(ignored);
+        timeout_timer_.cancel(ignored);
+        socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+        if (connected_) stats_.active.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void read_length() {
+        auto self = shared_from_this();
+        asio::async_read(socket_, asio::buffer(len_buf_), [this, self](boost::system::error_code ec, std::size_t) {
+            if (ec) {
+                if (!closed_) stats_.disconnects.fetch_add(1, std::memory_order_relaxed);
+                close();
+                return;
+            }
+            const uint32_t len = bot_protocol::decode_length(len_buf_.data());
+            if (len == 0 || len > 1024 * 1024) {
+                close();
+                return;
+            }
+            payload_.resize(len);
+            asio::async_read(socket_, asio::buffer(payload_), [this, self](boost::system::error_code ec2, std::size_t n) {
+                if (ec2) {
+                    if (!closed_) stats_.disconnects.fetch_add(1, std::memory_order_relaxed);
+                    close();
+                    return;
+                }
+                stats_.bytes_in.fetch_add(n + 4, std::memory_order_relaxed);
+                pb::Envelope env;
+                if (env.ParseFromArray(payload_.data(), static_cast<int>(payload_.size()))) {
+                    on_envelope(env);
+                }
+                if (!closed_) read_length();
+            });
+        });
+    }
+
+    void on_envelope(const pb::Envelope& env) {
+        const auto now = Clock::now();
+        if (env.type() == pb::MINING_UPDATE) {
+            stats_.mining_updates.fetch_add(1, std::memory_order_relaxed);
+            if (last_mining_update_.time_since_epoch().count() != 0) {
+                const auto gap = std::chrono::duration_cast<std::chrono::microseconds>(now - last_mining_update_);
+                const auto deviation = gap - std::chrono::duration_cast<std::chrono::microseconds>(kMiningTickInterval);
+                stats_.mining_jitter.record(static_cast<uint64_t>(std::abs(deviation.count())));
+            }
+            last_mining_update_ = now;
+            return;
+        }
+
+        if (awaiting_ == pb::UNKNOWN) return;
+        const bool is_error = env.type() == pb::ERROR_NOTIFICATION;
+        if (env.type() != response_type_for(awaiting_) && !is_error) return;
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - sent_at_);
+        stats_.latency[static_cast<std::size_t>(awaiting_)]->record(static_cast<uint64_t>(elapsed.count()));
+        stats_.responses.fetch_add(1, std::memory_order_relaxed);
+        if (is_error) stats_.errors.fetch_add(1, std::memory_order_relaxed);
+
+        const auto completed = awaiting_;
+        awaiting_ = pb::UNKNOWN;
+        boost::system::error_code ignored;
+        timeout_timer_.cancel(ignored);
+
+        if (completed == pb::HANDSHAKE && (is_error || !env.handshake_result().success())) {
+            stats_.handshake_failures.fetch_add(1, std::memory_order_relaxed);
+            close();
+            return;
+        }
+        schedule_next();
+    }
+
+    void schedule_next() {
+        if (closed_) return;
+        const auto wait = std::chrono::microseconds(static_cast<int64_t>(think_(rng_) * 1000.0));
+        think_timer_.expires_after(wait);
+        auto self = shared_from_this();
+        think_timer_.async_wait([this, self](boost::system::error_code ec) {
+            if (ec || closed_) return;
+            send_request(build_request(mix_.actions[pick_(rng_)]));
+        });
+    }
+
+    pb::Envelope build_request(Action action) {
+        pb::Envelope env;
+        switch (action) {
+        case Action::Heartbeat:
+            env.set_type(pb::HEARTBEAT);
+            env.mutable_heartbeat()->set_client_time_ms(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count()));
+            break;
+        case Action::ChangeMineral:
+            env.set_type(pb::CHANGE_MINERAL_REQUEST);
+            env.mutable_change_mineral_request()->set_mineral_id(1 + rng_() % std::max(1u, opt_.minerals));
+            break;
+        case Action::Upgrade:
+            env.set_type(pb::UPGRADE_REQUEST);
+            env.mutable_upgrade_request()->set_slot_index(0);
+            break;
+        case Action::Gacha:
+            env.set_type(pb::GEM_GACHA_REQUEST);
+            env.mutable_gem_gacha_request()->set_pull_count(rng_() % 10 == 0 ? 11 : 1);
+            break;
+        case Action::Missions:
+            env.set_type(pb::DAILY_MISSIONS_REQUEST);
+            env.mutable_daily_missions_request();
+            break;
+        case Action::MissionComplete:
+            env.set_type(pb::MISSION_COMPLETE);
+            env.mutable_mission_complete()->set_slot_no(1 + rng_() % 3);
+            break;
+        case Action::AllSlots:
+            env.set_type(pb::ALL_SLOTS_REQUEST);
+            env.mutable_all_slots_request();
+            break;
+        case Action::GemList:
+            env.set_type(pb::GEM_LIST_REQUEST);
+            env.mutable_gem_list_request();
+            break;
+        case Action::OfflineReward:
+            env.set_type(pb::OFFLINE_REWARD_REQUEST);
+            env.mutable_offline_reward_request();
+            break;
+        }
+        return env;
+    }
+
+    void send_request(const pb::Envelope& env) {
+        auto frame = bot_protocol::encode_frame(env);
+
+        awaiting_ = env.type();
+        sent_at_ = Clock::now();
+        stats_.requests.fetch_add(1, std::memory_order_relaxed);
+
+        auto self = shared_from_this();
+        asio::async_write(socket_, asio::buffer(*frame), [this, self, frame](boost::system::error_code ec, std::size_t n) {
+            if (ec) {
+                close();
+                return;
+            }
+            stats_.bytes_out.fetch_add(n, std::memory_order_relaxed);
+        });
+
+        timeout_timer_.expires_after(std::chrono::milliseconds(opt_.timeout_ms));
+        timeout_timer_.async_wait([this, self](boost::system::error_code ec) {
+            if (ec || closed_ || awaiting_ == pb::UNKNOWN) return;
+            stats_.timeouts.fetch_add(1, std::memory_order_relaxed);
+            const bool was_handshake = awaiting_ == pb::HANDSHAKE;
+            awaiting_ = pb::UNKNOWN;
+            if (was_handshake) {
+                stats_.handshake_failures.fetch_add(1, std::memory_order_relaxed);
+                close();
+                return;
+            }
+            schedule_next();
+        });
+    }
+
+    tcp::socket socket_;
+    asio::steady_timer think_timer_;
+    asio::steady_timer timeout_timer_;
+    const Options& opt_;
+    const Mix& mix_;
+    Stats& stats_;
+    tcp::endpoint endpoint_;
+    std::string token_;
+    uint32_t index_;
+    std::mt19937 rng_;
+    std::discrete_distribution<std::size_t> pick_;
+    std::exponential_distribution<double> think_;
+
+    std::array<uint8_t, 4> len_buf_{};
+    std::vector<uint8_t> payload_;
+    pb::MessageType awaiting_{pb::UNKNOWN};
+    Clock::time_point sent_at_{};
+    Clock::time_point last_mining_update_{};
+    bool connected_{false};
+    bool closed_{false};
+};
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "invalid argument: %s\n", arg.c_str());
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        auto as_u32 = [&value] { return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)); };
+        if (key == "host") opt.host = value;
+        else if (key == "port") opt.port = static_cast<unsigned short>(as_u32());
+        else if (key == "sessions") opt.sessions = as_u32();
+        else if (key == "connect-rate") opt.connect_rate = std::max(1u, as_u32());
+        else if (key == "duration") opt.duration_sec = as_u32();
+        else if (key == "threads") opt.threads = std::max(1u, as_u32());
+        else if (key == "think-ms") opt.think_ms = as_u32();
+        else if (key == "timeout-ms") opt.timeout_ms = as_u32();
+        else if (key == "report-sec") opt.report_sec = std::max(1u, as_u32());
+        else if (key == "minerals") opt.minerals = as_u32();
+        else if (key == "mix") opt.mix = value;
+        else if (key == "tokens") opt.token_file = value;
+        else if (key == "token-prefix") opt.token_prefix = value;
+        else {
+            std::fprintf(stderr, "unknown option: --%s\n", key.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// 수만 세션을 열 수 있도록 파일 디스크립터 한도를 hard limit까지 올린다
+void raise_fd_limit(uint32_t sessions) {
+    rlimit rl{};
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0) return;
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    if (rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur < sessions + 64) {
+        std::fprintf(stderr, "warning: RLIMIT_NOFILE=%llu is below the session count\n",
+                     static_cast<unsigned long long>(rl.rlim_cur));
+    }
+}
+
+void print_report(const Stats& stats, double elapsed_sec) {
+    std::printf("\n== summary (%.1fs) ==\n", elapsed_sec);
+    std::printf("connected=%llu connect_failures=%llu handshake_failures=%llu disconnects=%llu\n",
+                static_cast<unsigned long long>(stats.connected.load()),
+                static_cast<unsigned long long>(stats.connect_failures.load()),
+                static_cast<unsigned long long>(stats.handshake_failures.load()),
+                static_cast<unsigned long long>(stats.disconnects.load()));
+    std::printf("requests=%llu responses=%llu errors=%llu timeouts=%llu throughput=%.1f req/s\n",
+                static_cast<unsigned long long>(stats.requests.load()),
+                static_cast<unsigned long long>(stats.responses.load()),
+                static_cast<unsigned long long>(stats.errors.load()),
+                static_cast<unsigned long long>(stats.timeouts.load()),
+                elapsed_sec > 0 ? static_cast<double>(stats.responses.load()) / elapsed_sec : 0.0);
+    std::printf("bytes_in=%llu bytes_out=%llu\n",
+                static_cast<unsigned long long>(stats.bytes_in.load()),
+                static_cast<unsigned long long>(stats.bytes_out.load()));
+
+    std::printf("\n%-26s %10s %10s %10s %10s %10s %10s\n", "type", "count", "req/s", "p50_ms", "p99_ms", "p999_ms", "max_ms");
+    for (std::size_t i = 0; i < stats.latency.size(); ++i) {
+        const auto& h = *stats.latency[i];
+        if (h.count() == 0) continue;
+        const auto type = static_cast<pb::MessageType>(i);
+        std::printf("%-26s %10llu %10.1f %10.2f %10.2f %10.2f %10.2f\n",
+                    pb::MessageType_Name(type).c_str(), static_cast<unsigned long long>(h.count()),
+                    static_cast<double>(h.count()) / std::max(elapsed_sec, 1e-9),
+                    h.percentile(0.5) / 1000.0, h.percentile(0.99) / 1000.0, h.percentile(0.999) / 1000.0,
+                    h.max() / 1000.0);
+    }
+
+    const auto& j = stats.mining_jitter;
+    std::printf("\nMINING_UPDATE updates=%llu jitter(|gap-40ms|) p50=%.2fms p99=%.2fms p999=%.2fms max=%.2fms\n",
+                static_cast<unsigned long long>(stats.mining_updates.load()),
+                j.percentile(0.5) / 1000.0, j.percentile(0.99) / 1000.0, j.percentile(0.999) / 1000.0,
+                j.max() / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+    const Mix mix = parse_mix(opt.mix);
+    if (mix.actions.empty()) {
+        std::fprintf(stderr, "empty action mix\n");
+        return 2;
+    }
+
+    std::vector<std::string> tokens;
+    if (!opt.token_file.empty()) {
+        std::ifstream in(opt.token_file);
+        for (std::string line; std::getline(in, line);) {
+            if (!line.empty()) tokens.push_back(line);
+        }
+        if (tokens.empty()) {
+            std::fprintf(stderr, "no tokens in %s\n", opt.token_file.c_str());
+            return 2;
+        }
+    }
+
+    raise_fd_limit(opt.sessions);
+
+    tcp::endpoint endpoint;
+    try {
+        asio::io_context resolver_io;
+        tcp::resolver resolver(resolver_io);
+        endpoint = *resolver.resolve(opt.host, std::to_string(opt.port)).begin();
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "resolve %s:%u failed: %s\n", opt.host.c_str(), opt.port, ex.what());
+        return 2;
+    }
+
+    Stats stats;
+    std::vector<std::unique_ptr<asio::io_context>> ios;
+    std::vector<asio::executor_work_guard<asio::io_context::executor_type>> guards;
+    for (uint32_t i = 0; i < opt.threads; ++i) {
+        ios.push_back(std::make_unique<asio::io_context>(1));
+        guards.push_back(asio::make_work_guard(*ios.back()));
+    }
+    std::vector<std::thread> workers;
+    for (auto& io : ios) workers.emplace_back([&io] { io->run(); });
+
+    std::printf("load-bot: %u sessions -> %s:%u, %u threads, connect %u/s, duration %us\n",
+                opt.sessions, opt.host.c_str(), opt.port, opt.threads, opt.connect_rate, opt.duration_sec);
+
+    std::vector<std::shared_ptr<Bot>> bots;
+    bots.reserve(opt.sessions);
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(opt.duration_sec);
+    auto next_report = start + std::chrono::seconds(opt.report_sec);
+    uint64_t last_responses = 0;
+    auto last_report = start;
+
+    // 연결은 connect_rate에 맞춰 점진적으로 연다
+    uint32_t launched = 0;
+    while (Clock::now() < end) {
+        const auto now = Clock::now();
+        const double since = std::chrono::duration<double>(now - start).count();
+        const uint32_t due = std::min<uint32_t>(opt.sessions, static_cast<uint32_t>(since * opt.connect_rate) + 1);
+        while (launched < due) {
+            auto& io = *ios[launched % ios.size()];
+            std::string token = tokens.empty() ? opt.token_prefix + std::to_string(launched)
+                                               : tokens[launched % tokens.size()];
+            auto bot = std::make_shared<Bot>(io, opt, mix, stats, endpoint, std::move(token), launched);
+            asio::post(io, [bot] { bot->start(); });
+            bots.push_back(std::move(bot));
+            ++launched;
+        }
+
+        if (now >= next_report) {
+            const uint64_t responses = stats.responses.load();
+            const double interval = std::chrono::duration<double>(now - last_report).count();
+            std::printf("[%5.0fs] active=%llu responses/s=%.1f errors=%llu timeouts=%llu mining_updates=%llu\n",
+                        since, static_cast<unsigned long long>(stats.active.load()),
+                        static_cast<double>(responses - last_responses) / interval,
+                        static_cast<unsigned long long>(stats.errors.load()),
+                        static_cast<unsigned long long>(stats.timeouts.load()),
+                        static_cast<unsigned long long>(stats.mining_updates.load()));
+            std::fflush(stdout);
+            last_responses = responses;
+            last_report = now;
+            next_report += std::chrono::seconds(opt.report_sec);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& bot : bots) bot->stop();
+    guards.clear();
+    for (auto& t : workers) t.join();
+
+    print_report(stats, elapsed);
+    return 0;
+}
@@ -0,0 +1,50 @@
+// 메타데이터 바이너리 번들 컴파일러
+// meta_bundle.json을 파싱/검증한 뒤 서버가 mmap으로 읽는 meta_bundle.bin을 생성한다.
+// build_meta_bundle.js 실행 후(= meta_bundle.json 갱신 후) 다시 실행해야 한다.
+// 원본 JSON 해시가 헤더에 기록되므로 재컴파일을 잊으면 서버는 JSON으로 폴백한다.
+//
+// 사용법: meta-bundle-compile <metadata_dir> [output_path]
+// 종료 코드: 0 = 성공, 1 = 검증 실패, 2 = 입력/출력 오류
+#include "metadata/metadata_loader.h"
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <metadata_dir> [output_path]\n", argv[0]);
+        return 2;
+    }
+    const std::string dir = argv[1];
+    const std::string json_path = dir + "/meta_bundle.json";
+    const std::string out_path = argc > 2 ? argv[2] : dir + "/meta_bundle.bin";
+
+    // 기존 .bin이 남아 있어도 항상 JSON에서 다시 만든다
+    std::remove(out_path.c_str());
+    MetadataLoader meta;
+    if (!meta.load(dir, out_path)) {
+        std::fprintf(stderr, "failed to parse %s\n", json_path.c_str());
+        return 2;
+    }
+    auto errors = meta.validate();
+    for (const auto& e : errors) {
+        std::fprintf(stderr, "validation: %s\n", e.c_str());
+    }
+    if (!errors.empty()) {
+        return 1;
+    }
+
+    std::string error;
+    if (!meta.save_binary(out_path, json_path, error)) {
+        std::fprintf(stderr, "failed to write %s: %s\n", out_path.c_str(), error.c_str());
+        return 2;
+    }
+
+    // 방금 쓴 파일을 서버와 같은 경로로 다시 읽어 확인
+    MetadataLoader check;
+    if (!check.load(dir, out_path) || !check.validate().empty()) {
+        std::fprintf(stderr, "round-trip check failed for %s\n", out_path.c_str());
+        return 1;
+    }
+    std::printf("wrote %s\n", out_path.c_str());
+    return 0;
+}
@@ -0,0 +1,564 @@
+// 부하 테스트용 인증 서버 대역 (auth-server /auth/verify 호환)
+// Node auth-server + Postgres 없이 핸드셰이크 폭주를 재현하기 위한 경량 HTTP 서버.
+// HS256 JWT를 발급/검증하고, 지연(고정 + 지터)과 실패(무효 토큰, 밴, HTTP 500, 응답 지연)를
+// 비율로 주입한다. game-server는 AUTH_HOST/AUTH_PORT만 이 서버로 돌리면 된다.
+//
+// 사용법:
+//   mock-auth [--host=0.0.0.0] [--port=10000] [--threads=16] [--secret=dev-secret-change-me]
+//             [--ttl-sec=604800] [--latency-ms=0] [--jitter-ms=0]
+//             [--fail-rate=0] [--ban-rate=0] [--error-rate=0] [--hang-rate=0] [--hang-ms=5000]
+//             [--accept-opaque=1] [--report-sec=10]
+//   mock-auth --issue=<count> [--token-prefix=loadbot-] [--secret=...] [--ttl-sec=...] > tokens.txt
+// 토큰:
+//   - JWT: secret으로 서명 검증 후 payload의 user_id, exp 사용 (auth-server가 발급한 토큰도 통과)
+//   - 불투명 문자열 (accept-opaque=1): 문자열 해시로 고정 UUID를 만들어 같은 봇은 같은 user_id를 얻는다
+// 엔드포인트: POST /auth/verify, POST /auth/issue {"name"|"user_id", "ttl_sec"}, GET /stats
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string host = "0.0.0.0";
+    unsigned short port = 10000;
+    uint32_t threads = 16;
+    std::string secret = "dev-secret-change-me"; // auth-server 기본값과 동일
+    uint32_t ttl_sec = 7 * 24 * 3600;
+    uint32_t latency_ms = 0;
+    uint32_t jitter_ms = 0;   // [0, jitter_ms] 균등 추가 지연
+    double fail_rate = 0.0;   // valid:false (INVALID_JWT)
+    double ban_rate = 0.0;    // valid:false (USER_BANNED)
+    double error_rate = 0.0;  // HTTP 500
+    double hang_rate = 0.0;   // hang_ms만큼 붙잡아 클라이언트 타임아웃 유도
+    uint32_t hang_ms = 5000;
+    bool accept_opaque = true;
+    uint32_t report_sec = 10;
+    uint32_t issue = 0;       // > 0 이면 토큰만 출력하고 종료
+    std::string token_prefix = "loadbot-";
+};
+
+// ---- SHA-256 / HMAC-SHA256 (FIPS 180-4) ----
+
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256() { reset(); }
+
+    void reset() {
+        state_ = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        length_ = 0;
+        buffered_ = 0;
+    }
+
+    void update(const void* data, std::size_t len) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        length_ += len;
+        while (len > 0) {
+            const std::size_t n = std::min(len, block_.size() - buffered_);
+            std::memcpy(block_.data() + buffered_, p, n);
+            buffered_ += n;
+            p += n;
+            len -= n;
+            if (buffered_ == block_.size()) {
+                compress(block_.data());
+                buffered_ = 0;
+            }
+        }
+    }
+
+    void update(const std::string& s) { update(s.data(), s.size()); }
+
+    Digest finish() {
+        const uint64_t bits = length_ * 8;
+        const uint8_t pad = 0x80;
+        update(&pad, 1);
+        const uint8_t zero = 0;
+        while (buffered_ != 56) update(&zero, 1);
+        std::array<uint8_t, 8> len_be{};
+        for (int i = 0; i < 8; ++i) len_be[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        update(len_be.data(), len_be.size());
+        Digest out{};
+        for (int i = 0; i < 8; ++i) {
+            out[4 * i] = static_cast<uint8_t>(state_[i] >> 24);
+            out[4 * i + 1] = static_cast<uint8_t>(state_[i] >> 16);
+            out[4 * i + 2] = static_cast<uint8_t>(state_[i] >> 8);
+            out[4 * i + 3] = static_cast<uint8_t>(state_[i]);
+        }
+        return out;
+    }
+
+private:
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress(const uint8_t* chunk) {
+        static constexpr std::array<uint32_t, 64> k{
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+        std::array<uint32_t, 64> w{};
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(chunk[4 * i]) << 24) | (uint32_t(chunk[4 * i + 1]) << 16) |
+                   (uint32_t(chunk[4 * i + 2]) << 8) | uint32_t(chunk[4 * i + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const uint32_t ch = (e & f) ^ (~e & g);
+            const uint32_t t1 = h + s1 + ch + k[i] + w[i];
+            const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t t2 = s0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+        state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+    }
+
+    std::array<uint32_t, 8> state_{};
+    std::array<uint8_t, 64> block_{};
+    uint64_t length_{0};
+    std::size_t buffered_{0};
+};
+
+Sha256::Digest hmac_sha256(const std::string& key, const std::string& message) {
+    std::array<uint8_t, 64> block{};
+    if (key.size() > block.size()) {
+        Sha256 h;
+        h.update(key);
+        const auto d = h.finish();
+        std::memcpy(block.data(), d.data(), d.size());
+    } else {
+        std::memcpy(block.data(), key.data(), key.size());
+    }
+    std::array<uint8_t, 64> ipad{}, opad{};
+    for (std::size_t i = 0; i < block.size(); ++i) {
+        ipad[i] = block[i] ^ 0x36;
+        opad[i] = block[i] ^ 0x5c;
+    }
+    Sha256 inner;
+    inner.update(ipad.data(), ipad.size());
+    inner.update(message);
+    const auto inner_digest = inner.finish();
+    Sha256 outer;
+    outer.update(opad.data(), opad.size());
+    outer.update(inner_digest.data(), inner_digest.size());
+    return outer.finish();
+}
+
+// ---- base64url (패딩 없음) ----
+
+std::string base64url_encode(const uint8_t* data, std::size_t len) {
+    static const char* kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string out;
+    out.reserve((len + 2) / 3 * 4);
+    std::size_t i = 0;
+    for (; i + 2 < len; i += 3) {
+        const uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out += kAlphabet[(v >> 18) & 63];
+        out += kAlphabet[(v >> 12) & 63];
+        out += kAlphabet[(v >> 6) & 63];
+        out += kAlphabet[v & 63];
+    }
+    if (i < len) {
+        uint32_t v = uint32_t(data[i]) << 16;
+        if (i + 1 < len) v |= uint32_t(data[i + 1]) << 8;
+        out += kAlphabet[(v >> 18) & 63];
+        out += kAlphabet[(v >> 12) & 63];
+        if (i + 1 < len) out += kAlphabet[(v >> 6) & 63];
+    }
+    return out;
+}
+
+std::string base64url_encode(const std::string& s) {
+    return base64url_encode(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+bool base64url_decode(const std::string& in, std::string& out) {
+    auto value = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '-' || c == '+') return 62;
+        if (c == '_' || c == '/') return 63;
+        return -1;
+    };
+    out.clear();
+    uint32_t acc = 0;
+    int bits = 0;
+    for (char c : in) {
+        if (c == '=') break;
+        const int v = value(c);
+        if (v < 0) return false;
+        acc = (acc << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out += static_cast<char>((acc >> bits) & 0xff);
+        }
+    }
+    return true;
+}
+
+// ---- JWT (HS256) ----
+
+int64_t unix_now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// 이름 → 고정 UUID (SHA-256 앞 16바이트, 버전 5 형식 비트)
+std::string uuid_from_name(const std::string& name) {
+    Sha256 h;
+    h.update("mock-auth:");
+    h.update(name);
+    auto d = h.finish();
+    d[6] = static_cast<uint8_t>((d[6] & 0x0f) | 0x50);
+    d[8] = static_cast<uint8_t>((d[8] & 0x3f) | 0x80);
+    static const char* kHex = "0123456789abcdef";
+    std::string out;
+    out.reserve(36);
+    for (int i = 0; i < 16; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) out += '-';
+        out += kHex[d[i] >> 4];
+        out += kHex[d[i] & 0x0f];
+    }
+    return out;
+}
+
+std::string sign_jwt(const std::string& secret, const nlohmann::json& payload) {
+    const std::string signing_input =
+        base64url_encode(R"({"alg":"HS256","typ":"JWT"})") + "." + base64url_encode(payload.dump());
+    const auto sig = hmac_sha256(secret, signing_input);
+    return signing_input + "." + base64url_encode(sig.data(), sig.size());
+}
+
+std::string issue_token(const Options& opt, const std::string& name, const std::string& user_id, uint32_t ttl_sec) {
+    const int64_t now = unix_now();
+    nlohmann::json payload{
+        {"user_id", user_id.empty() ? uuid_from_name(name) : user_id},
+        {"external_id", "mock-" + (name.empty() ? user_id : name)},
+        {"provider", "mock"},
+        {"iat", now},
+        {"exp", now + ttl_sec},
+    };
+    return sign_jwt(opt.secret, payload);
+}
+
+enum class VerifyStatus { Ok, Invalid, Expired };
+
+// 서명 비교는 길이와 무관한 시간에 끝나도록 전 바이트를 누적 비교
+bool constant_time_equal(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    unsigned char diff = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+VerifyStatus verify_jwt(const std::string& secret, const std::string& token, nlohmann::json& payload) {
+    const auto first = token.find('.');
+    const auto second = first == std::string::npos ? std::string::npos : token.find('.', first + 1);
+    if (second == std::string::npos || token.find('.', second + 1) != std::string::npos) return VerifyStatus::Invalid;
+
+    std::string header_json;
+    if (!base64url_decode(token.substr(0, first), header_json)) return VerifyStatus::Invalid;
+    const auto header = nlohmann::json::parse(header_json, nullptr, false);
+    if (!header.is_object() || header.value("alg", "") != "HS256") return VerifyStatus::Invalid;
+
+    const auto sig = hmac_sha256(secret, token.substr(0, second));
+    if (!constant_time_equal(base64url_encode(sig.data(), sig.size()), token.substr(second + 1))) {
+        return VerifyStatus::Invalid;
+    }
+
+    std::string payload_json;
+    if (!base64url_decode(token.substr(first + 1, second - first - 1), payload_json)) return VerifyStatus::Invalid;
+    payload = nlohmann::json::parse(payload_json, nullptr, false);
+    if (!payload.is_object()) return VerifyStatus::Invalid;
+    if (payload.contains("exp") && payload["exp"].is_number() && payload["exp"].get<int64_t>() <= unix_now()) {
+        return VerifyStatus::Expired;
+    }
+    return VerifyStatus::Ok;
+}
+
+// ---- 서버 ----
+
+struct Stats {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> valid{0};
+    std::atomic<uint64_t> invalid{0};
+    std::atomic<uint64_t> expired{0};
+    std::atomic<uint64_t> injected_fail{0};
+    std::atomic<uint64_t> injected_ban{0};
+    std::atomic<uint64_t> injected_error{0};
+    std::atomic<uint64_t> injected_hang{0};
+    std::atomic<uint64_t> issued{0};
+};
+
+double uniform01() {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+void inject_latency(const Options& opt) {
+    uint32_t ms = opt.latency_ms;
+    if (opt.jitter_ms > 0) ms += static_cast<uint32_t>(uniform01() * (opt.jitter_ms + 1));
+    if (ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// auth-server의 /auth/verify 응답 형태를 따른다
+void handle_verify(const Options& opt, Stats& stats, const httplib::Request& req, httplib::Response& res) {
+    stats.requests.fetch_add(1, std::memory_order_relaxed);
+    inject_latency(opt);
+
+    if (opt.hang_rate > 0 && uniform01() < opt.hang_rate) {
+        stats.injected_hang.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.hang_ms));
+    }
+    if (opt.error_rate > 0 && uniform01() < opt.error_rate) {
+        stats.injected_error.fetch_add(1, std::memory_order_relaxed);
+        res.status = 500;
+        res.set_content(R"({"valid":false,"error":"INJECTED_ERROR"})", "application/json");
+        return;
+    }
+
+    const auto body = nlohmann::json::parse(req.body, nullptr, false);
+    const std::string token = body.is_object() ? body.value("jwt", "") : "";
+    if (token.empty()) {
+        stats.invalid.fetch_add(1, std::memory_order_relaxed);
+        res.status = 400;
+        res.set_content(R"({"valid":false,"error":"MISSING_TOKEN"})", "application/json");
+        return;
+    }
+
+    nlohmann::json out;
+    std::string user_id;
+    int64_t expires_at = 0;
+    if (token.find('.') != std::string::npos) {
+        nlohmann::json payload;
+        const auto status = verify_jwt(opt.secret, token, payload);
+        if (status == VerifyStatus::Ok) {
+            user_id = payload.value("user_id", "");
+            if (payload.contains("exp") && payload["exp"].is_number()) expires_at = payload["exp"].get<int64_t>();
+        }
+        if (status == VerifyStatus::Expired) {
+            stats.expired.fetch_add(1, std::memory_order_relaxed);
+            res.set_content(R"({"valid":false,"error":"TOKEN_EXPIRED"})", "application/json");
+            return;
+        }
+    } else if (opt.accept_opaque) {
+        user_id = uuid_from_name(token);
+        expires_at = unix_now() + opt.ttl_sec;
+    }
+    if (user_id.empty()) {
+        stats.invalid.fetch_add(1, std::memory_order_relaxed);
+        res.set_content(R"({"valid":false,"error":"INVALID_JWT"})", "application/json");
+        return;
+    }
+
+    if (opt.fail_rate > 0 && uniform01() < opt.fail_rate) {
+        stats.injected_fail.fetch_add(1, std::memory_order_relaxed);
+        res.set_content(R"({"valid":false,"error":"INVALID_JWT"})", "application/json");
+        return;
+    }
+    if (opt.ban_rate > 0 && uniform01() < opt.ban_rate) {
+        stats.injected_ban.fetch_add(1, std::memory_order_relaxed);
+        res.set_content(R"({"valid":false,"error":"USER_BANNED"})", "application/json");
+        return;
+    }
+
+    stats.valid.fetch_add(1, std::memory_order_relaxed);
+    out = {
+        {"valid", true},
+        {"user_id", user_id},
+        {"external_id", "mock-" + user_id},
+        {"provider", "mock"},
+        {"is_banned", false},
+        {"expires_at", expires_at},
+    };
+    if (body.contains("device_id") && body["device_id"].is_string()) out["device_id"] = body["device_id"];
+    res.set_content(out.dump(), "application/json");
+}
+
+void handle_issue(const Options& opt, Stats& stats, const httplib::Request& req, httplib::Response& res) {
+    const auto body = nlohmann::json::parse(req.body.empty() ? "{}" : req.body, nullptr, false);
+    if (!body.is_object()) {
+        res.status = 400;
+        res.set_content(R"({"success":false,"error":"INVALID_BODY"})", "application/json");
+        return;
+    }
+    std::string name = body.value("name", "");
+    const std::string user_id = body.value("user_id", "");
+    if (name.empty() && user_id.empty()) name = "anon-" + std::to_string(stats.issued.load() + 1);
+    const uint32_t ttl = body.value("ttl_sec", opt.ttl_sec);
+    const std::string jwt = issue_token(opt, name, user_id, ttl);
+    stats.issued.fetch_add(1, std::memory_order_relaxed);
+    nlohmann::json out{
+        {"success", true},
+        {"jwt", jwt},
+        {"user_id", user_id.empty() ? uuid_from_name(name) : user_id},
+        {"expires_at", unix_now() + ttl},
+    };
+    res.set_content(out.dump(), "application/json");
+}
+
+nlohmann::json stats_json(const Stats& stats) {
+    return {
+        {"requests", stats.requests.load()},
+        {"valid", stats.valid.load()},
+        {"invalid", stats.invalid.load()},
+        {"expired", stats.expired.load()},
+        {"injected_fail", stats.injected_fail.load()},
+        {"injected_ban", stats.injected_ban.load()},
+        {"injected_error", stats.injected_error.load()},
+        {"injected_hang", stats.injected_hang.load()},
+        {"issued", stats.issued.load()},
+    };
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "invalid argument: %s\n", arg.c_str());
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        auto as_u32 = [&value] { return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)); };
+        auto as_rate = [&value] { return std::clamp(std::strtod(value.c_str(), nullptr), 0.0, 1.0); };
+        if (key == "host") opt.host = value;
+        else if (key == "port") opt.port = static_cast<unsigned short>(as_u32());
+        else if (key == "threads") opt.threads = std::max(1u, as_u32());
+        else if (key == "secret") opt.secret = value;
+        else if (key == "ttl-sec") opt.ttl_sec = as_u32();
+        else if (key == "latency-ms") opt.latency_ms = as_u32();
+        else if (key == "jitter-ms") opt.jitter_ms = as_u32();
+        else if (key == "fail-rate") opt.fail_rate = as_rate();
+        else if (key == "ban-rate") opt.ban_rate = as_rate();
+        else if (key == "error-rate") opt.error_rate = as_rate();
+        else if (key == "hang-rate") opt.hang_rate = as_rate();
+        else if (key == "hang-ms") opt.hang_ms = as_u32();
+        else if (key == "accept-opaque") opt.accept_opaque = value != "0" && value != "false";
+        else if (key == "report-sec") opt.report_sec = as_u32();
+        else if (key == "issue") opt.issue = as_u32();
+        else if (key == "token-prefix") opt.token_prefix = value;
+        else {
+            std::fprintf(stderr, "unknown option: --%s\n", key.c_str());
+            return false;
+        }
+    }
+    if (opt.secret.size() < 8) {
+        std::fprintf(stderr, "secret must be at least 8 characters\n");
+        return false;
+    }
+    return true;
+}
+
+httplib::Server* g_server = nullptr;
+
+void on_signal(int) {
+    if (g_server) g_server->stop();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+
+    // 토큰 파일 생성 모드: load-bot --tokens=<file> 입력용
+    if (opt.issue > 0) {
+        for (uint32_t i = 0; i < opt.issue; ++i) {
+            std::printf("%s\n", issue_token(opt, opt.token_prefix + std::to_string(i), "", opt.ttl_sec).c_str());
+        }
+        return 0;
+    }
+
+    Stats stats;
+    httplib::Server server;
+    const uint32_t pool_size = opt.threads;
+    server.new_task_queue = [pool_size] { return new httplib::ThreadPool(pool_size); };
+    server.Post("/auth/verify", [&](const httplib::Request& req, httplib::Response& res) {
+        handle_verify(opt, stats, req, res);
+    });
+    server.Post("/auth/issue", [&](const httplib::Request& req, httplib::Response& res) {
+        handle_issue(opt, stats, req, res);
+    });
+    server.Get("/stats", [&](const httplib::Request&, httplib::Response& res) {
+        res.set_content(stats_json(stats).dump(), "application/json");
+    });
+
+    g_server = &server;
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::atomic<bool> running{true};
+    std::thread reporter;
+    if (opt.report_sec > 0) {
+        reporter = std::thread([&] {
+            uint64_t last = 0;
+            auto next = Clock::now();
+            while (running.load()) {
+                next += std::chrono::seconds(opt.report_sec);
+                while (running.load() && Clock::now() < next) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (!running.load()) break;
+                const uint64_t total = stats.requests.load();
+                std::printf("verify/s=%.1f total=%llu valid=%llu invalid=%llu expired=%llu injected(fail=%llu ban=%llu error=%llu hang=%llu)\n",
+                            static_cast<double>(total - last) / opt.report_sec,
+                            static_cast<unsigned long long>(total),
+                            static_cast<unsigned long long>(stats.valid.load()),
+                            static_cast<unsigned long long>(stats.invalid.load()),
+                            static_cast<unsigned long long>(stats.expired.load()),
+                            static_cast<unsigned long long>(stats.injected_fail.load()),
+                            static_cast<unsigned long long>(stats.injected_ban.load()),
+                            static_cast<unsigned long long>(stats.injected_error.load()),
+                            static_cast<unsigned long long>(stats.injected_hang.load()));
+                std::fflush(stdout);
+                last = total;
+            }
+        });
+    }
+
+    std::printf("mock-auth: listening on %s:%u (%u threads, latency %u+%ums, fail %.3f ban %.3f error %.3f hang %.3f)\n",
+                opt.host.c_str(), opt.port, opt.threads, opt.latency_ms, opt.jitter_ms,
+                opt.fail_rate, opt.ban_rate, opt.error_rate, opt.hang_rate);
+    std::fflush(stdout);
+    const bool ok = server.listen(opt.host, opt.port);
+
+    running.store(false);
+    if (reporter.joinable()) reporter.join();
+    std::printf("final: %s\n", stats_json(stats).dump().c_str());
+    if (!ok) {
+        std::fprintf(stderr, "listen %s:%u failed\n", opt.host.c_str(), opt.port);
+        return 1;
+    }
+    return 0;
+}
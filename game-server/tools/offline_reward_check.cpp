@@ -0,0 +1,180 @@
+// 오프라인 보상 닫힌 식 검증 도구
+// estimate_offline_reward 결과를 Session::update_mining_tick과 같은 40ms 틱 시뮬레이션
+// (advance_slot_attacks, 틱 단위 리스폰, 광물마다 랜덤 공격 위상)과 비교한다.
+// 곡괭이 레벨 x 광물 x 슬롯 구성(단일/동일 4개/혼합 4개/고속 보석)을 모두 돌린다.
+//
+// 사용법: offline-reward-check <metadata_dir> [hours] [tolerance_percent] [seed]
+// 종료 코드: 0 = 통과, 1 = 허용 오차 초과, 2 = 입력 오류
+#include "metadata/metadata_loader.h"
+#include "server/mining_tick.h"
+#include "server/offline_reward.h"
+#include "server/rng_service.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float kTickMs = 40.0f;
+// 광물 1개당 기대 타수가 이보다 크면 (권장 DPS와 동떨어진 조합) 시뮬레이션 생략
+constexpr double kMaxHitsPerMineral = 3000.0;
+
+struct Case {
+    std::string label;
+    std::vector<SlotMiningState> slots;
+};
+
+SlotMiningState make_slot(uint32_t index, const PickaxeLevel& level, float speed_scale,
+                          uint32_t crit_percent, uint32_t crit_damage) {
+    SlotMiningState slot{};
+    slot.slot_index = index;
+    slot.attack_power = level.attack_power;
+    // DB 제약과 같은 범위 (attack_speed_x100 100..2500)
+    const auto speed_x100 = std::clamp<uint32_t>(
+        static_cast<uint32_t>(std::lround(level.attack_speed * speed_scale * 100.0)), 100u, 2500u);
+    slot.attack_speed = static_cast<float>(speed_x100) / 100.0f;
+    slot.critical_hit_percent = crit_percent;
+    slot.critical_damage = crit_damage;
+    return slot;
+}
+
+std::vector<Case> build_cases(const MetadataLoader& meta, uint32_t level_id) {
+    const auto* level = meta.pickaxe_level(level_id);
+    auto lower = [&](uint32_t drop) {
+        const auto* l = meta.pickaxe_level(level_id > drop ? level_id - drop : 0);
+        return l ? *l : *level;
+    };
+    std::vector<Case> cases;
+    cases.push_back({"single", {make_slot(0, *level, 1.0f, 500, 15000)}});
+
+    Case uniform{"uniform4", {}};
+    for (uint32_t i = 0; i < 4; ++i) uniform.slots.push_back(make_slot(i, *level, 1.0f, 500, 15000));
+    cases.push_back(std::move(uniform));
+
+    cases.push_back({"mixed4",
+                     {make_slot(0, *level, 1.0f, 500, 15000), make_slot(1, lower(3), 1.37f, 1500, 18000),
+                      make_slot(2, lower(6), 2.5f, 3000, 25000), make_slot(3, lower(9), 4.1f, 0, 10000)}});
+    cases.push_back({"fast-gem", {make_slot(0, *level, 25.0f, 5000, 20000)}});
+    return cases;
+}
+
+// Session::update_mining_tick의 채굴/리스폰 분기와 같은 순서로 진행
+uint64_t simulate_kills(std::vector<SlotMiningState> slots, const MineralMeta& mineral, uint64_t ticks,
+                        std::mt19937_64& rng) {
+    infinitepickaxe::MiningUpdate update;
+    bool is_mining = false;
+    uint64_t hp = 0;
+    float respawn_timer_ms = 0.0f;
+    uint64_t kills = 0;
+
+    auto start_new_mineral = [&] {
+        hp = mineral.hp;
+        is_mining = true;
+        respawn_timer_ms = 0.0f;
+        for (auto& slot : slots) {
+            const float interval = 1000.0f / slot.attack_speed;
+            slot.next_attack_timer_ms = static_cast<float>(rng() % 1000) / 1000.0f * interval;
+        }
+    };
+
+    start_new_mineral();
+    for (uint64_t t = 0; t < ticks; ++t) {
+        if (!is_mining) {
+            if (respawn_timer_ms > 0) {
+                respawn_timer_ms -= kTickMs;
+                if (respawn_timer_ms <= 0) start_new_mineral();
+            }
+            continue;
+        }
+        update.clear_attacks();
+        const uint64_t damage = advance_slot_attacks(slots, kTickMs, rng, update);
+        hp = hp > damage ? hp - damage : 0;
+        if (hp == 0) {
+            ++kills;
+            is_mining = false;
+            respawn_timer_ms = static_cast<float>(mineral.respawn_time) * 1000.0f;
+        }
+    }
+    return kills;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <metadata_dir> [hours] [tolerance_percent] [seed]\n", argv[0]);
+        return 2;
+    }
+    const std::string dir = argv[1];
+    const double hours = argc > 2 ? std::strtod(argv[2], nullptr) : 1.0;
+    const double tolerance = argc > 3 ? std::strtod(argv[3], nullptr) / 100.0 : 0.02;
+    const uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : std::random_device{}();
+    if (hours <= 0.0 || tolerance <= 0.0) {
+        std::fprintf(stderr, "hours and tolerance must be positive\n");
+        return 2;
+    }
+
+    MetadataLoader meta;
+    if (!meta.load(dir)) {
+        std::fprintf(stderr, "failed to load metadata bundle from %s\n", dir.c_str());
+        return 2;
+    }
+    std::vector<const MineralMeta*> minerals;
+    for (uint32_t id = 1; id < 1024; ++id) {
+        if (const auto* m = meta.mineral(id)) minerals.push_back(m);
+    }
+    if (minerals.empty() || !meta.pickaxe_level(0)) {
+        std::fprintf(stderr, "metadata has no minerals or pickaxe levels\n");
+        return 2;
+    }
+
+    const auto seconds = static_cast<uint64_t>(hours * 3600.0);
+    const uint64_t ticks = static_cast<uint64_t>(static_cast<double>(seconds) * 1000.0 / kTickMs);
+    std::mt19937_64 rng(seed);
+
+    uint64_t cases = 0;
+    uint64_t failures = 0;
+    double worst = 0.0;
+    double signed_sum = 0.0;
+    double estimate_ns = 0.0;
+    std::printf("hours=%.2f tolerance=%.2f%% seed=%llu\n", hours, tolerance * 100.0,
+                static_cast<unsigned long long>(seed));
+    for (uint32_t level_id = 0; meta.pickaxe_level(level_id); ++level_id) {
+        for (const auto& c : build_cases(meta, level_id)) {
+            for (const auto* mineral : minerals) {
+                const auto begin = std::chrono::steady_clock::now();
+                const auto estimate = estimate_offline_reward(c.slots, *mineral, seconds, kTickMs);
+                estimate_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+                if (estimate.expected_hits > kMaxHitsPerMineral) continue;
+
+                const uint64_t simulated = simulate_kills(c.slots, *mineral, ticks, rng);
+                const double diff = static_cast<double>(estimate.kills) - static_cast<double>(simulated);
+                const double allowed = std::max(2.0, tolerance * static_cast<double>(simulated));
+                const double relative = simulated > 0 ? diff / static_cast<double>(simulated) : 0.0;
+                ++cases;
+                signed_sum += relative;
+                worst = std::max(worst, std::fabs(relative));
+                if (std::fabs(diff) > allowed) {
+                    ++failures;
+                    std::printf("  FAIL level=%u %-8s mineral=%u hp=%llu hits=%.2f est=%llu sim=%llu (%+.2f%%)\n",
+                                level_id, c.label.c_str(), mineral->id,
+                                static_cast<unsigned long long>(mineral->hp), estimate.expected_hits,
+                                static_cast<unsigned long long>(estimate.kills),
+                                static_cast<unsigned long long>(simulated), relative * 100.0);
+                }
+            }
+        }
+    }
+
+    std::printf("cases=%llu failures=%llu worst=%.3f%% mean_signed=%+.3f%% estimate_avg=%.0fns\n",
+                static_cast<unsigned long long>(cases), static_cast<unsigned long long>(failures),
+                worst * 100.0, cases ? signed_sum / static_cast<double>(cases) * 100.0 : 0.0,
+                cases ? estimate_ns / static_cast<double>(cases) : 0.0);
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+// 확률 판정 재현 도구 (분쟁 대응용)
+// 서버 로그의 "rng_audit user=... domain=... nonce=..." 와 RNG_AUDIT_SEED로
+// 서버와 같은 난수 스트림을 만들어 판정 결과를 다시 계산한다.
+//
+// 사용법:
+//   rng-replay <audit_seed> <user_id> gacha <nonce> <metadata_dir> <pull_count>
+//   rng-replay <audit_seed> <user_id> synthesis <nonce>
+//   rng-replay <audit_seed> <user_id> upgrade <nonce>
+//   rng-replay <audit_seed> <user_id> crit <nonce> [roll_count]
+#include "server/rng_service.h"
+#include "metadata/metadata_loader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        std::fprintf(stderr, "usage: %s <audit_seed> <user_id> <gacha|synthesis|upgrade|crit> <nonce> [...]\n", argv[0]);
+        return 2;
+    }
+    const uint64_t seed = std::strtoull(argv[1], nullptr, 0);
+    const std::string user_id = argv[2];
+    const std::string domain = argv[3];
+    const uint64_t nonce = std::strtoull(argv[4], nullptr, 10);
+
+    if (domain == "gacha") {
+        if (argc < 7) {
+            std::fprintf(stderr, "gacha replay needs <metadata_dir> <pull_count>\n");
+            return 2;
+        }
+        MetadataLoader meta;
+        if (!meta.load(argv[5]) || meta.gem_gacha_sampler().empty()) {
+            std::fprintf(stderr, "failed to load gacha metadata from %s\n", argv[5]);
+            return 2;
+        }
+        auto rng = RngStream::replay(seed, user_id, RngDomain::Gacha, nonce);
+        uint32_t pulls = static_cast<uint32_t>(std::strtoul(argv[6], nullptr, 10));
+        for (uint32_t i = 0; i < pulls; ++i) {
+            uint32_t gem_id = meta.gem_gacha_sampler().sample_gem(rng);
+            const auto* def = meta.gem_definition(gem_id);
+            std::printf("pull %u: gem_id=%u grade_id=%u\n", i + 1, gem_id, def ? def->grade_id : 0);
+        }
+    } else if (domain == "synthesis") {
+        auto rng = RngStream::replay(seed, user_id, RngDomain::Synthesis, nonce);
+        std::printf("roll_bp=%u (success if < success_rate_percent)\n", RngService::roll_bp_10000(rng));
+    } else if (domain == "upgrade") {
+        auto rng = RngStream::replay(seed, user_id, RngDomain::Upgrade, nonce);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        std::printf("roll=%.9f (success if < final rate)\n", dist(rng));
+    } else if (domain == "crit") {
+        auto rng = RngStream::replay(seed, user_id, RngDomain::Crit, nonce);
+        uint32_t count = argc > 5 ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 20;
+        for (uint32_t i = 0; i < count; ++i) {
+            std::printf("attack %u: roll_bp=%u\n", i + 1, RngService::roll_bp_10000(rng));
+        }
+    } else {
+        std::fprintf(stderr, "unknown domain: %s\n", domain.c_str());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,542 @@
+// 캡처 재생기 (CAPTURE_DIR로 기록한 .ipcap 파일을 game-server에 다시 흘려보낸다)
+// 캡처된 세션마다 연결을 하나 열고, 수신(Inbound) 메시지를 기록된 시각 간격 / speed로 보낸다.
+// 응답을 기다리지 않는 open-loop 재생이며, 핸드셰이크 성공 전 메시지만 잠시 보류한다.
+// 결과: 요청 타입별 p50/p99/p999 지연, 서버 CPU 사용량(--server-pid), 요약 JSON(--out)
+//
+// 사용법:
+//   traffic-replay --capture=capture-....ipcap [--host=127.0.0.1] [--port=10001] [--speed=1]
+//                  [--threads=4] [--tokens=<file>] [--token-prefix=replay-] [--max-sessions=0]
+//                  [--server-pid=<pid>] [--out=result.json] [--label=build-a]
+//   traffic-replay --capture=... --dump   (캡처 내용 요약만 출력)
+// speed: 1이면 원래 속도, 10이면 10배 빠르게, 0이면 대기 없이 최대한 빠르게
+// 토큰: 캡처에는 jwt가 없으므로 --tokens 파일(한 줄에 하나, 세션 순서대로 순환) 또는 token-prefix + 세션 번호
+// 빌드 비교: 같은 캡처를 빌드 A/B에 각각 재생하고 --out JSON의 지연/CPU를 비교
+#include "bot_protocol.h"
+#include "server/hdr_histogram.h"
+#include "server/traffic_capture.h"
+#include "game.pb.h"
+#include <boost/asio.hpp>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+namespace pb = infinitepickaxe;
+
+struct Options {
+    std::string capture;
+    std::string host = "127.0.0.1";
+    unsigned short port = 10001;
+    double speed = 1.0;
+    uint32_t threads = 4;
+    uint32_t max_sessions = 0; // 0이면 전체
+    uint32_t timeout_ms = 10000;
+    std::string token_file;
+    std::string token_prefix = "replay-";
+    int server_pid = 0;
+    std::string out;
+    std::string label;
+    bool dump = false;
+};
+
+struct CapturedMessage {
+    uint64_t offset_us; // 세션 시작 기준
+    std::string payload;
+};
+
+struct CapturedSession {
+    uint32_t id{0};
+    uint64_t open_us{0}; // 캡처 시작 기준
+    uint64_t duration_us{0};
+    uint64_t outbound{0};
+    std::vector<CapturedMessage> inbound;
+};
+
+bool load_capture(const std::string& path, std::vector<CapturedSession>& sessions, uint64_t& start_unix_us) {
+    CaptureReader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::fprintf(stderr, "cannot read %s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+    start_unix_us = reader.start_unix_us();
+    std::map<uint32_t, std::size_t> index;
+    auto session_for = [&](uint32_t id, uint64_t t_us) -> CapturedSession& {
+        auto it = index.find(id);
+        if (it == index.end()) {
+            it = index.emplace(id, sessions.size()).first;
+            sessions.push_back(CapturedSession{});
+            sessions.back().id = id;
+            sessions.back().open_us = t_us;
+        }
+        return sessions[it->second];
+    };
+
+    CaptureReader::Record record;
+    while (reader.next(record)) {
+        auto& session = session_for(record.session, record.t_us);
+        const uint64_t offset = record.t_us >= session.open_us ? record.t_us - session.open_us : 0;
+        switch (record.kind) {
+        case TrafficCapture::Kind::Open: break;
+        case TrafficCapture::Kind::Inbound:
+            session.inbound.push_back(CapturedMessage{offset, std::move(record.payload)});
+            break;
+        case TrafficCapture::Kind::Outbound: ++session.outbound; break;
+        case TrafficCapture::Kind::Close: session.duration_us = offset; break;
+        }
+        session.duration_us = std::max(session.duration_us, offset);
+    }
+    return true;
+}
+
+void dump_capture(const std::vector<CapturedSession>& sessions, uint64_t start_unix_us) {
+    std::map<int, uint64_t> by_type;
+    uint64_t inbound = 0, outbound = 0, span_us = 0;
+    for (const auto& s : sessions) {
+        inbound += s.inbound.size();
+        outbound += s.outbound;
+        span_us = std::max(span_us, s.open_us + s.duration_us);
+        for (const auto& m : s.inbound) {
+            pb::Envelope env;
+            by_type[env.ParseFromString(m.payload) ? static_cast<int>(env.type()) : -1]++;
+        }
+    }
+    std::printf("capture started at unix %.3f, span %.1fs\n", start_unix_us / 1e6, span_us / 1e6);
+    std::printf("sessions=%zu inbound=%llu outbound=%llu\n", sessions.size(),
+                static_cast<unsigned long long>(inbound), static_cast<unsigned long long>(outbound));
+    std::printf("\n%-26s %10s\n", "inbound type", "count");
+    for (const auto& [type, count] : by_type) {
+        const std::string name = type < 0 ? "(unparsable)" : pb::MessageType_Name(static_cast<pb::MessageType>(type));
+        std::printf("%-26s %10llu\n", name.c_str(), static_cast<unsigned long long>(count));
+    }
+}
+
+struct Stats {
+    std::vector<std::unique_ptr<HdrHistogram>> latency; // 요청 타입별
+    std::atomic<uint64_t> connected{0};
+    std::atomic<uint64_t> connect_failures{0};
+    std::atomic<uint64_t> handshake_failures{0};
+    std::atomic<uint64_t> disconnects{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> responses{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> unmatched{0};   // 대기 중인 요청이 없는 응답
+    std::atomic<uint64_t> lag_us_max{0};  // 예정 시각 대비 최대 송신 지연 (재생기 자체 병목 확인용)
+    std::atomic<uint64_t> finished{0};
+
+    Stats() {
+        latency.reserve(128);
+        for (int i = 0; i < 128; ++i) latency.push_back(std::make_unique<HdrHistogram>());
+    }
+};
+
+class Replayer : public std::enable_shared_from_this<Replayer> {
+public:
+    Replayer(asio::io_context& io, const Options& opt, Stats& stats, tcp::endpoint endpoint,
+             const CapturedSession& session, std::string token)
+        : socket_(io), send_timer_(io), opt_(opt), stats_(stats), endpoint_(std::move(endpoint)),
+          session_(session), token_(std::move(token)) {}
+
+    // start_at: 이 세션의 재생 시작 시각 (캡처상 연결 시각 / speed)
+    void start(Clock::time_point start_at) {
+        start_at_ = start_at;
+        auto self = shared_from_this();
+        send_timer_.expires_at(start_at);
+        send_timer_.async_wait([this, self](boost::system::error_code ec) {
+            if (ec) return finish();
+            socket_.async_connect(endpoint_, [this, self](boost::system::error_code ec2) {
+                if (ec2) {
+                    stats_.connect_failures.fetch_add(1, std::memory_order_relaxed);
+                    return finish();
+                }
+                stats_.connected.fetch_add(1, std::memory_order_relaxed);
+                socket_.set_option(tcp::no_delay(true));
+                read_length();
+                schedule_next();
+            });
+        });
+    }
+
+    void stop() {
+        auto self = shared_from_this();
+        asio::post(socket_.get_executor(), [this, self] { close(); });
+    }
+
+private:
+    Clock::time_point due_at(const CapturedMessage& m) const {
+        if (opt_.speed <= 0.0) return start_at_;
+        return start_at_ + std::chrono::microseconds(static_cast<int64_t>(m.offset_us / opt_.speed));
+    }
+
+    void schedule_next() {
+        if (closed_) return;
+        if (next_ >= session_.inbound.size()) {
+            // 마지막 요청의 응답을 기다린 뒤 종료 (timeout_ms 상한)
+            if (pending_.empty()) return close();
+            send_timer_.expires_after(std::chrono::milliseconds(opt_.timeout_ms));
+            auto self = shared_from_this();
+            send_timer_.async_wait([this, self](boost::system::error_code ec) {
+                if (!ec) close();
+            });
+            return;
+        }
+        // 핸드셰이크 결과 전에는 다음 메시지를 보내지 않는다 (결과 수신 시 재개)
+        auto self = shared_from_this();
+        if (handshake_pending_) {
+            send_timer_.expires_after(std::chrono::milliseconds(opt_.timeout_ms));
+            send_timer_.async_wait([this, self](boost::system::error_code ec) {
+                if (ec || closed_) return;
+                stats_.handshake_failures.fetch_add(1, std::memory_order_relaxed);
+                close();
+            });
+            return;
+        }
+        send_timer_.expires_at(due_at(session_.inbound[next_]));
+        send_timer_.async_wait([this, self](boost::system::error_code ec) {
+            if (ec || closed_) return;
+            send_captured(session_.inbound[next_++]);
+            schedule_next();
+        });
+    }
+
+    void send_captured(const CapturedMessage& m) {
+        pb::Envelope env;
+        if (!env.ParseFromString(m.payload)) return;
+        if (env.type() == pb::HANDSHAKE) {
+            env.mutable_handshake()->set_jwt(token_);
+            handshake_pending_ = true;
+        }
+        const auto now = Clock::now();
+        const auto lag = std::chrono::duration_cast<std::chrono::microseconds>(now - due_at(m)).count();
+        if (lag > 0) {
+            auto prev = stats_.lag_us_max.load(std::memory_order_relaxed);
+            while (static_cast<uint64_t>(lag) > prev &&
+                   !stats_.lag_us_max.compare_exchange_weak(prev, static_cast<uint64_t>(lag))) {}
+        }
+        const auto expected = bot_protocol::response_type_for(env.type());
+        if (expected != pb::UNKNOWN) pending_.push_back(Pending{env.type(), expected, now});
+        stats_.requests.fetch_add(1, std::memory_order_relaxed);
+
+        auto frame = bot_protocol::encode_frame(env);
+        auto self = shared_from_this();
+        asio::async_write(socket_, asio::buffer(*frame), [this, self, frame](boost::system::error_code ec, std::size_t) {
+            if (ec) close();
+        });
+    }
+
+    void read_length() {
+        auto self = shared_from_this();
+        asio::async_read(socket_, asio::buffer(len_buf_), [this, self](boost::system::error_code ec, std::size_t) {
+            if (ec) {
+                if (!closed_) stats_.disconnects.fetch_add(1, std::memory_order_relaxed);
+                return close();
+            }
+            const uint32_t len = bot_protocol::decode_length(len_buf_.data());
+            if (len == 0 || len > 1024 * 1024) return close();
+            payload_.resize(len);
+            asio::async_read(socket_, asio::buffer(payload_), [this, self](boost::system::error_code ec2, std::size_t) {
+                if (ec2) {
+                    if (!closed_) stats_.disconnects.fetch_add(1, std::memory_order_relaxed);
+                    return close();
+                }
+                pb::Envelope env;
+                if (env.ParseFromArray(payload_.data(), static_cast<int>(payload_.size()))) on_envelope(env);
+                if (!closed_) read_length();
+            });
+        });
+    }
+
+    void on_envelope(const pb::Envelope& env) {
+        if (env.type() == pb::MINING_UPDATE) return;
+        const bool is_error = env.type() == pb::ERROR_NOTIFICATION;
+        // 응답 순서가 요청 순서와 다를 수 있어 같은 응답 타입의 가장 오래된 요청과 짝짓는다 (에러는 가장 오래된 요청)
+        auto it = std::find_if(pending_.begin(), pending_.end(), [&](const Pending& p) {
+            return is_error || p.response == env.type();
+        });
+        if (it == pending_.end()) {
+            // 서버 푸시(미션 진행 등)는 요청과 무관
+            if (is_error) stats_.unmatched.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - it->sent_at);
+        stats_.latency[static_cast<std::size_t>(it->request)]->record(static_cast<uint64_t>(elapsed.count()));
+        stats_.responses.fetch_add(1, std::memory_order_relaxed);
+        if (is_error) stats_.errors.fetch_add(1, std::memory_order_relaxed);
+        const auto request = it->request;
+        pending_.erase(it);
+
+        if (request == pb::HANDSHAKE) {
+            handshake_pending_ = false;
+            if (is_error || !env.handshake_result().success()) {
+                stats_.handshake_failures.fetch_add(1, std::memory_order_relaxed);
+                return close();
+            }
+            schedule_next();
+        } else if (next_ >= session_.inbound.size() && pending_.empty()) {
+            close();
+        }
+    }
+
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+        boost::system::error_code ignored;
+        send_timer_.cancel(ignored);
+        socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+        finish();
+    }
+
+    void finish() {
+        if (finished_) return;
+        finished_ = true;
+        stats_.finished.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct Pending {
+        pb::MessageType request;
+        pb::MessageType response;
+        Clock::time_point sent_at;
+    };
+
+    tcp::socket socket_;
+    asio::steady_timer send_timer_;
+    const Options& opt_;
+    Stats& stats_;
+    tcp::endpoint endpoint_;
+    const CapturedSession& session_;
+    std::string token_;
+    Clock::time_point start_at_{};
+    std::size_t next_{0};
+    std::deque<Pending> pending_;
+    std::array<uint8_t, 4> len_buf_{};
+    std::vector<uint8_t> payload_;
+    bool handshake_pending_{false};
+    bool closed_{false};
+    bool finished_{false};
+};
+
+// /proc/<pid>/stat의 utime + stime (초)
+double process_cpu_seconds(int pid) {
+    std::ifstream in("/proc/" + std::to_string(pid) + "/stat");
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const auto paren = content.rfind(')');
+    if (paren == std::string::npos) return -1.0;
+    std::istringstream fields(content.substr(paren + 2));
+    std::string field;
+    unsigned long long utime = 0, stime = 0;
+    // ')' 다음이 3번째 필드(state), utime/stime은 14/15번째
+    for (int i = 3; i <= 15 && fields >> field; ++i) {
+        if (i == 14) utime = std::strtoull(field.c_str(), nullptr, 10);
+        if (i == 15) stime = std::strtoull(field.c_str(), nullptr, 10);
+    }
+    return static_cast<double>(utime + stime) / static_cast<double>(::sysconf(_SC_CLK_TCK));
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--dump") {
+            opt.dump = true;
+            continue;
+        }
+        const auto eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "invalid argument: %s\n", arg.c_str());
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        auto as_u32 = [&value] { return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)); };
+        if (key == "capture") opt.capture = value;
+        else if (key == "host") opt.host = value;
+        else if (key == "port") opt.port = static_cast<unsigned short>(as_u32());
+        else if (key == "speed") opt.speed = std::strtod(value.c_str(), nullptr);
+        else if (key == "threads") opt.threads = std::max(1u, as_u32());
+        else if (key == "max-sessions") opt.max_sessions = as_u32();
+        else if (key == "timeout-ms") opt.timeout_ms = as_u32();
+        else if (key == "tokens") opt.token_file = value;
+        else if (key == "token-prefix") opt.token_prefix = value;
+        else if (key == "server-pid") opt.server_pid = static_cast<int>(as_u32());
+        else if (key == "out") opt.out = value;
+        else if (key == "label") opt.label = value;
+        else {
+            std::fprintf(stderr, "unknown option: --%s\n", key.c_str());
+            return false;
+        }
+    }
+    if (opt.capture.empty()) {
+        std::fprintf(stderr, "--capture is required\n");
+        return false;
+    }
+    return true;
+}
+
+void print_report(const Stats& stats, double elapsed_sec, double server_cpu_sec) {
+    std::printf("\n== replay summary (%.1fs) ==\n", elapsed_sec);
+    std::printf("connected=%llu connect_failures=%llu handshake_failures=%llu disconnects=%llu\n",
+                static_cast<unsigned long long>(stats.connected.load()),
+                static_cast<unsigned long long>(stats.connect_failures.load()),
+                static_cast<unsigned long long>(stats.handshake_failures.load()),
+                static_cast<unsigned long long>(stats.disconnects.load()));
+    std::printf("requests=%llu responses=%llu errors=%llu unmatched_errors=%llu max_send_lag=%.2fms\n",
+                static_cast<unsigned long long>(stats.requests.load()),
+                static_cast<unsigned long long>(stats.responses.load()),
+                static_cast<unsigned long long>(stats.errors.load()),
+                static_cast<unsigned long long>(stats.unmatched.load()),
+                stats.lag_us_max.load() / 1000.0);
+    if (server_cpu_sec >= 0.0) {
+        const auto requests = std::max<uint64_t>(1, stats.requests.load());
+        std::printf("server_cpu=%.2fs (%.1f%% of one core) cpu_per_request=%.1fus\n", server_cpu_sec,
+                    100.0 * server_cpu_sec / std::max(elapsed_sec, 1e-9), 1e6 * server_cpu_sec / requests);
+    }
+
+    std::printf("\n%-26s %10s %10s %10s %10s %10s\n", "type", "count", "p50_ms", "p99_ms", "p999_ms", "max_ms");
+    for (std::size_t i = 0; i < stats.latency.size(); ++i) {
+        const auto& h = *stats.latency[i];
+        if (h.count() == 0) continue;
+        std::printf("%-26s %10llu %10.2f %10.2f %10.2f %10.2f\n",
+                    pb::MessageType_Name(static_cast<pb::MessageType>(i)).c_str(),
+                    static_cast<unsigned long long>(h.count()), h.percentile(0.5) / 1000.0,
+                    h.percentile(0.99) / 1000.0, h.percentile(0.999) / 1000.0, h.max() / 1000.0);
+    }
+}
+
+// 빌드 간 비교용 요약 (지연 단위 us)
+void write_json(const Options& opt, const Stats& stats, double elapsed_sec, double server_cpu_sec) {
+    std::FILE* f = std::fopen(opt.out.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", opt.out.c_str());
+        return;
+    }
+    std::fprintf(f, "{\"label\":\"%s\",\"capture\":\"%s\",\"speed\":%g,\"elapsed_sec\":%.3f,", opt.label.c_str(),
+                 opt.capture.c_str(), opt.speed, elapsed_sec);
+    std::fprintf(f, "\"server_cpu_sec\":%.3f,\"requests\":%llu,\"responses\":%llu,\"errors\":%llu,", server_cpu_sec,
+                 static_cast<unsigned long long>(stats.requests.load()),
+                 static_cast<unsigned long long>(stats.responses.load()),
+                 static_cast<unsigned long long>(stats.errors.load()));
+    std::fprintf(f, "\"latency_us\":{");
+    bool first = true;
+    for (std::size_t i = 0; i < stats.latency.size(); ++i) {
+        const auto& h = *stats.latency[i];
+        if (h.count() == 0) continue;
+        std::fprintf(f, "%s\"%s\":{\"count\":%llu,\"p50\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+                     first ? "" : ",", pb::MessageType_Name(static_cast<pb::MessageType>(i)).c_str(),
+                     static_cast<unsigned long long>(h.count()),
+                     static_cast<unsigned long long>(h.percentile(0.5)),
+                     static_cast<unsigned long long>(h.percentile(0.99)),
+                     static_cast<unsigned long long>(h.percentile(0.999)),
+                     static_cast<unsigned long long>(h.max()));
+        first = false;
+    }
+    std::fprintf(f, "}}\n");
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+
+    std::vector<CapturedSession> sessions;
+    uint64_t start_unix_us = 0;
+    if (!load_capture(opt.capture, sessions, start_unix_us)) return 2;
+    if (opt.dump) {
+        dump_capture(sessions, start_unix_us);
+        return 0;
+    }
+    // 수신 메시지가 없는 세션(연결만 하고 끊은 경우)은 재생하지 않는다
+    sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                                  [](const CapturedSession& s) { return s.inbound.empty(); }),
+                   sessions.end());
+    if (opt.max_sessions > 0 && sessions.size() > opt.max_sessions) sessions.resize(opt.max_sessions);
+    if (sessions.empty()) {
+        std::fprintf(stderr, "no sessions with inbound traffic in %s\n", opt.capture.c_str());
+        return 2;
+    }
+
+    std::vector<std::string> tokens;
+    if (!opt.token_file.empty()) {
+        std::ifstream in(opt.token_file);
+        for (std::string line; std::getline(in, line);) {
+            if (!line.empty()) tokens.push_back(line);
+        }
+        if (tokens.empty()) {
+            std::fprintf(stderr, "no tokens in %s\n", opt.token_file.c_str());
+            return 2;
+        }
+    }
+
+    tcp::endpoint endpoint;
+    try {
+        asio::io_context resolver_io;
+        tcp::resolver resolver(resolver_io);
+        endpoint = *resolver.resolve(opt.host, std::to_string(opt.port)).begin();
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "resolve %s:%u failed: %s\n", opt.host.c_str(), opt.port, ex.what());
+        return 2;
+    }
+
+    Stats stats;
+    std::vector<std::unique_ptr<asio::io_context>> ios;
+    std::vector<asio::executor_work_guard<asio::io_context::executor_type>> guards;
+    for (uint32_t i = 0; i < opt.threads; ++i) {
+        ios.push_back(std::make_unique<asio::io_context>(1));
+        guards.push_back(asio::make_work_guard(*ios.back()));
+    }
+
+    const uint64_t first_open = std::min_element(sessions.begin(), sessions.end(), [](const auto& a, const auto& b) {
+                                    return a.open_us < b.open_us;
+                                })->open_us;
+    std::printf("traffic-replay: %zu sessions from %s -> %s:%u, speed %g, %u threads\n", sessions.size(),
+                opt.capture.c_str(), opt.host.c_str(), opt.port, opt.speed, opt.threads);
+
+    const double cpu_before = opt.server_pid > 0 ? process_cpu_seconds(opt.server_pid) : -1.0;
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+    std::vector<std::shared_ptr<Replayer>> replayers;
+    replayers.reserve(sessions.size());
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        const auto& session = sessions[i];
+        auto& io = *ios[i % ios.size()];
+        std::string token = tokens.empty() ? opt.token_prefix + std::to_string(session.id) : tokens[i % tokens.size()];
+        const auto offset = opt.speed > 0.0
+                                ? std::chrono::microseconds(static_cast<int64_t>((session.open_us - first_open) / opt.speed))
+                                : std::chrono::microseconds(0);
+        auto replayer = std::make_shared<Replayer>(io, opt, stats, endpoint, session, std::move(token));
+        asio::post(io, [replayer, at = start + offset] { replayer->start(at); });
+        replayers.push_back(std::move(replayer));
+    }
+
+    std::vector<std::thread> workers;
+    for (auto& io : ios) workers.emplace_back([&io] { io->run(); });
+    while (stats.finished.load() < replayers.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    const double cpu_after = opt.server_pid > 0 ? process_cpu_seconds(opt.server_pid) : -1.0;
+    for (auto& replayer : replayers) replayer->stop();
+    guards.clear();
+    for (auto& t : workers) t.join();
+
+    const double server_cpu = cpu_before >= 0.0 && cpu_after >= 0.0 ? cpu_after - cpu_before : -1.0;
+    print_report(stats, elapsed, server_cpu);
+    if (!opt.out.empty()) write_json(opt, stats, elapsed, server_cpu);
+    return 0;
+}